@@ -143,7 +143,7 @@ void MAT_asPrincipalComponents_preallocated (MATVU result, constMATVU const& m,
 	Melder_assert (numberOfComponents  > 0 && numberOfComponents <= m.ncol);
 	Melder_assert (result.nrow == m.nrow && result.ncol == numberOfComponents);
 	autoSVD svd = SVD_createFromGeneralMatrix (m);
-	mul_MAT_out (result, m, svd -> v.verticalBand (1, result.ncol));
+	mul_allowAllocation_MAT_out (result, m, svd -> v.verticalBand (1, result.ncol));
 }
 
 autoMAT MAT_asPrincipalComponents (constMATVU m, integer numberOfComponents) {
@@ -280,15 +280,15 @@ void NMF_improveFactorization_mu (NMF me, constMATVU const& data, integer maximu
 			// 1. Update W matrix
 			features0.all()  <<=  my features.all();
 			weights0.all()  <<=  my weights.all();
-			mul_MAT_out (productFtD.get(), features0.transpose(), data);
-			mul_MAT_out (productFtF.get(), features0.transpose(), features0.get());
-			mul_MAT_out (productFtFW.get(), productFtF.get(), weights0.get());
+			mul_allowAllocation_MAT_out (productFtD.get(), features0.transpose(), data);
+			mul_allowAllocation_MAT_out (productFtF.get(), features0.transpose(), features0.get());
+			mul_allowAllocation_MAT_out (productFtFW.get(), productFtF.get(), weights0.get());
 			update (my weights.get(), weights0.get(), productFtD.get(), productFtFW.get(), eps, maximum);
 
 			// 2. Update F matrix
-			mul_MAT_out (productDWt.get(), data, my weights.transpose()); // productDWt = data*weights'
-			mul_MAT_out (productWWt.get(), my weights.get(), my weights.transpose()); // work1 = weights*weights'
-			mul_MAT_out (productFWWt.get(), features0.get(), productWWt.get()); // productFWWt = features0 * work1
+			mul_allowAllocation_MAT_out (productDWt.get(), data, my weights.transpose()); // productDWt = data*weights'
+			mul_allowAllocation_MAT_out (productWWt.get(), my weights.get(), my weights.transpose()); // work1 = weights*weights'
+			mul_allowAllocation_MAT_out (productFWWt.get(), features0.get(), productWWt.get()); // productFWWt = features0 * work1
 			update (my features.get(), features0.get(), productDWt.get(), productFWWt.get(), eps, maximum);
 			
 			/* 3. Convergence test:
@@ -362,8 +362,8 @@ void NMF_improveFactorization_als (NMF me, constMATVU const& data, integer maxim
 				1. Solve equations for new W:  F´*F*W = F'*D
 			*/
 			weights0.all()  <<=  my weights.all();   // save previous weights for convergence test
-			mul_MAT_out (productFtD.get(), my features.transpose(), data);
-			mul_MAT_out (productFtF.get(), my features.transpose(), my features.get());
+			mul_allowAllocation_MAT_out (productFtD.get(), my features.transpose(), data);
+			mul_allowAllocation_MAT_out (productFtF.get(), my features.transpose(), my features.get());
 
 			svd_FtF -> u.all()  <<=  productFtF.all();
 			SVD_compute (svd_FtF.get());
@@ -374,8 +374,8 @@ void NMF_improveFactorization_als (NMF me, constMATVU const& data, integer maxim
 				2. Solve equations for new F:  W*W'*F' = W*D'
 			*/
 			features0.all()  <<=  my features.all();   // save previous features for convergence test
-			mul_MAT_out  (productWDt.get(), my weights.get(), data.transpose());
-			mul_MAT_out (productWWt.get(), my weights.get(), my weights.transpose());
+			mul_allowAllocation_MAT_out (productWDt.get(), my weights.get(), data.transpose());
+			mul_allowAllocation_MAT_out (productWWt.get(), my weights.get(), my weights.transpose());
 
 			svd_WWt -> u.all()  <<=  productWWt.all();
 			SVD_compute (svd_WWt.get());
@@ -422,7 +422,7 @@ void NMF_improveFactorization_is (NMF me, constMATVU const& data, integer maximu
 		autoMAT fcol_x_wrow = raw_MAT (data.nrow, data.ncol);
 		autoVEC fcolumn_inv = raw_VEC (data.nrow); // feature column
 		autoVEC wrow_inv = raw_VEC (data.ncol); // weight row
-		mul_MAT_out (fw.get(), my features.get(), my weights.get());
+		mul_allowAllocation_MAT_out (fw.get(), my features.get(), my weights.get());
 		double divergence = MATgetDivergence_ItakuraSaito (data, fw.get());
 		const double divergence0 = divergence;
 		if (info)
@@ -488,7 +488,7 @@ void NMF_improveFactorization_is (NMF me, constMATVU const& data, integer maximu
 
 autoMAT NMF_synthesize (NMF me) {
 	try {
-		autoMAT result = mul_MAT (my features.get(), my weights.get());
+		autoMAT result = mul_allowAllocation_MAT (my features.get(), my weights.get());
 		return result;
 	} catch (MelderError) {
 		Melder_throw (me, U": No matrix created.");
@@ -887,6 +887,15 @@ struct structNUMfft_Table
   integer n;
   autoVEC trigcache;
   autoINTVEC splitcache;
+  /*
+	Parselmouth: if n has a large prime factor, the transform is computed as a cyclic convolution
+	of power-of-two size m (Bluestein's algorithm); otherwise m is 0.
+  */
+  integer m;
+  autoVEC chirp;   // exp (i pi j^2 / n) for j = 0..n-1, as pairs of real and imaginary parts
+  autoVEC chirpSpectrum;   // the transform of the chirp, as pairs for k = 0..m/2, divided by m
+  autoVEC convolutionTrigcache;
+  autoINTVEC convolutionSplitcache;
 };
 
 typedef struct structNUMfft_Table *NUMfft_Table;
@@ -899,6 +908,7 @@ void NUMfft_Table_init (NUMfft_Table table, integer n);
 struct autoNUMfft_Table : public structNUMfft_Table {
 	autoNUMfft_Table () throw () {
 		n = 0;
+		m = 0;
 	}
 	~autoNUMfft_Table () { }
 };
@@ -977,6 +987,22 @@ void NUMfft_backward (NUMfft_Table table, VEC data);
 	sequence by n.
 */
 
+void NUMfft_forward (VEC data);
+void NUMfft_backward (VEC data);
+/*
+	Parselmouth: as above, but with a table for data.size that is taken from a per-thread cache
+	of recently used tables (of at most a few megabytes per thread), instead of a table initialised by the caller.
+*/
+
+void NUMfft_forward (NUMfft_Table table, MATVU const& frames);
+void NUMfft_backward (NUMfft_Table table, MATVU const& frames);
+/*
+	Parselmouth: as NUMfft_forward and NUMfft_backward with a table, but for every row of a block of frames
+	(frames.ncol must equal table -> n). Several rows are transformed at once, interleaved across SIMD lanes;
+	every row gets exactly the same result as when it is transformed on its own.
+	Unlike the transforms above, these do not use the table as scratch memory, so threads can share the table.
+*/
+
 /**** Compatibility with NR fft's */
 
 void NUMforwardRealFastFourierTransform (VEC data);
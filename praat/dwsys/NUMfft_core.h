@@ -12,6 +12,9 @@
   djmw 20030630 Adapted for praat (replaced 'int' declarations with 'long').
   djmw 20040511 Made all local variables type double to increase numerical precision.
   djmw 20171003 Replaced `long` declarations with `integer`).
+  Parselmouth: the routines that transform the data are templates over the type T of the data elements
+  (the twiddle factors remain FFT_DATA_TYPE), so that the same arithmetic can be applied to
+  a group of frames at once (see NUMfft_Lanes in NUMfft_d.cpp).
 
  ********************************************************************/
 
@@ -121,7 +124,8 @@ static void NUMrffti (integer n, FFT_DATA_TYPE * wsave, integer *ifac)
 
    NUMrffti(n, wsave+n,ifac); } */
 
-static void dradf2 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa1)
+template <typename T>
+static void dradf2 (integer ido, integer l1, T * cc, T * ch, FFT_DATA_TYPE * wa1)
 {
 	integer t1 = 0;
 	integer t2, t0 = (t2 = l1 * ido);
@@ -153,8 +157,8 @@ static void dradf2 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 			t4 -= 2;
 			t5 += 2;
 			t6 += 2;
-			const double tr2 = wa1 [i - 2] * cc [t3 - 1] + wa1 [i - 1] * cc [t3];
-			const double ti2 = wa1 [i - 2] * cc [t3] - wa1 [i - 1] * cc [t3 - 1];
+			const T tr2 = wa1 [i - 2] * cc [t3 - 1] + wa1 [i - 1] * cc [t3];
+			const T ti2 = wa1 [i - 2] * cc [t3] - wa1 [i - 1] * cc [t3 - 1];
 			ch [t6] = cc [t5] + ti2;
 			ch [t4] = ti2 - cc [t5];
 			ch [t6 - 1] = cc [t5 - 1] + tr2;
@@ -180,7 +184,8 @@ static void dradf2 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 	}
 }
 
-static void dradf4 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa1,
+template <typename T>
+static void dradf4 (integer ido, integer l1, T * cc, T * ch, FFT_DATA_TYPE * wa1,
 	FFT_DATA_TYPE * wa2, FFT_DATA_TYPE * wa3)
 {
 	static constexpr double hsqt2 = .70710678118654752440084436210485;
@@ -195,8 +200,8 @@ static void dradf4 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 
 	for (integer k = 0; k < l1; k++)
 	{
-		const double tr1 = cc [t1] + cc [t2];
-		const double tr2 = cc [t3] + cc [t4];
+		const T tr1 = cc [t1] + cc [t2];
+		const T tr2 = cc [t3] + cc [t4];
 		ch [t5 = t3 << 2] = tr1 + tr2;
 		ch [(ido << 2) + t5 - 1] = tr2 - tr1;
 		ch [(t5 += (ido << 1)) - 1] = cc [t3] - cc [t4];
@@ -226,23 +231,23 @@ static void dradf4 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 			t5 -= 2;
 
 			t3 += t0;
-			const double cr2 = wa1 [i - 2] * cc [t3 - 1] + wa1 [i - 1] * cc [t3];
-			const double ci2 = wa1 [i - 2] * cc [t3] - wa1 [i - 1] * cc [t3 - 1];
+			const T cr2 = wa1 [i - 2] * cc [t3 - 1] + wa1 [i - 1] * cc [t3];
+			const T ci2 = wa1 [i - 2] * cc [t3] - wa1 [i - 1] * cc [t3 - 1];
 			t3 += t0;
-			const double cr3 = wa2 [i - 2] * cc [t3 - 1] + wa2 [i - 1] * cc [t3];
-			const double ci3 = wa2 [i - 2] * cc [t3] - wa2 [i - 1] * cc [t3 - 1];
+			const T cr3 = wa2 [i - 2] * cc [t3 - 1] + wa2 [i - 1] * cc [t3];
+			const T ci3 = wa2 [i - 2] * cc [t3] - wa2 [i - 1] * cc [t3 - 1];
 			t3 += t0;
-			const double cr4 = wa3 [i - 2] * cc [t3 - 1] + wa3 [i - 1] * cc [t3];
-			const double ci4 = wa3 [i - 2] * cc [t3] - wa3 [i - 1] * cc [t3 - 1];
-
-			const double tr1 = cr2 + cr4;
-			const double tr4 = cr4 - cr2;
-			const double ti1 = ci2 + ci4;
-			const double ti4 = ci2 - ci4;
-			const double ti2 = cc [t2] + ci3;
-			const double ti3 = cc [t2] - ci3;
-			const double tr2 = cc [t2 - 1] + cr3;
-			const double tr3 = cc [t2 - 1] - cr3;
+			const T cr4 = wa3 [i - 2] * cc [t3 - 1] + wa3 [i - 1] * cc [t3];
+			const T ci4 = wa3 [i - 2] * cc [t3] - wa3 [i - 1] * cc [t3 - 1];
+
+			const T tr1 = cr2 + cr4;
+			const T tr4 = cr4 - cr2;
+			const T ti1 = ci2 + ci4;
+			const T ti4 = ci2 - ci4;
+			const T ti2 = cc [t2] + ci3;
+			const T ti3 = cc [t2] - ci3;
+			const T tr2 = cc [t2 - 1] + cr3;
+			const T tr3 = cc [t2 - 1] - cr3;
 
 			ch [t4 - 1] = tr1 + tr2;
 			ch [t4] = ti1 + ti2;
@@ -271,8 +276,8 @@ static void dradf4 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 
 	for (integer k = 0; k < l1; k++)
 	{
-		const double ti1 = -hsqt2 * (cc [t1] + cc [t2]);
-		const double tr1 = hsqt2 * (cc [t1] - cc [t2]);
+		const T ti1 = -hsqt2 * (cc [t1] + cc [t2]);
+		const T tr1 = hsqt2 * (cc [t1] - cc [t2]);
 		ch [t4 - 1] = tr1 + cc [t6 - 1];
 		ch [t4 + t5 - 1] = cc [t6 - 1] - tr1;
 		ch [t4] = ti1 - cc [t1 + t0];
@@ -284,8 +289,9 @@ static void dradf4 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 	}
 }
 
-static void dradfg (integer ido, integer ip, integer l1, integer idl1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * c1,
-	FFT_DATA_TYPE * c2, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * ch2, FFT_DATA_TYPE * wa)
+template <typename T>
+static void dradfg (integer ido, integer ip, integer l1, integer idl1, T * cc, T * c1,
+	T * c2, T * ch, T * ch2, FFT_DATA_TYPE * wa)
 {
 
 	static constexpr double tpi = 6.28318530717958647692528676655900577;
@@ -629,7 +635,8 @@ static void dradfg (integer ido, integer ip, integer l1, integer idl1, FFT_DATA_
 	}
 }
 
-static void drftf1 (integer n, FFT_DATA_TYPE * c, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa, integer *ifac)
+template <typename T>
+static void drftf1 (integer n, T * c, T * ch, FFT_DATA_TYPE * wa, integer *ifac)
 {
 	const integer nf = ifac [1];
 	integer na = 1;
@@ -696,7 +703,8 @@ static void drftf1 (integer n, FFT_DATA_TYPE * c, FFT_DATA_TYPE * ch, FFT_DATA_T
 		c [i] = ch [i];
 }
 
-static void dradb2 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa1)
+template <typename T>
+static void dradb2 (integer ido, integer l1, T * cc, T * ch, FFT_DATA_TYPE * wa1)
 {
 	const integer t0 = l1 * ido;
 
@@ -729,9 +737,9 @@ static void dradb2 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 			t5 -= 2;
 			t6 += 2;
 			ch [t3 - 1] = cc [t4 - 1] + cc [t5 - 1];
-			const double tr2 = cc [t4 - 1] - cc [t5 - 1];
+			const T tr2 = cc [t4 - 1] - cc [t5 - 1];
 			ch [t3] = cc [t4] - cc [t5];
-			const double ti2 = cc [t4] + cc [t5];
+			const T ti2 = cc [t4] + cc [t5];
 			ch [t6 - 1] = wa1 [i - 2] * tr2 - wa1 [i - 1] * ti2;
 			ch [t6] = wa1 [i - 2] * ti2 + wa1 [i - 1] * tr2;
 		}
@@ -753,7 +761,8 @@ static void dradb2 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 	}
 }
 
-static void dradb3 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa1,
+template <typename T>
+static void dradb3 (integer ido, integer l1, T * cc, T * ch, FFT_DATA_TYPE * wa1,
 	FFT_DATA_TYPE * wa2)
 {
 	static constexpr double taur = -.5;
@@ -768,10 +777,10 @@ static void dradb3 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 	integer t5 = 0;
 	for (integer k = 0; k < l1; k++)
 	{
-		const double tr2 = cc [t3 - 1] + cc [t3 - 1];
-		const double cr2 = cc [t5] + (taur * tr2);
+		const T tr2 = cc [t3 - 1] + cc [t3 - 1];
+		const T cr2 = cc [t5] + (taur * tr2);
 		ch [t1] = cc [t5] + tr2;
-		const double ci3 = taui * (cc [t3] + cc [t3]);
+		const T ci3 = taui * (cc [t3] + cc [t3]);
 		ch [t1 + t0] = cr2 - ci3;
 		ch [t1 + t2] = cr2 + ci3;
 		t1 += ido;
@@ -799,18 +808,18 @@ static void dradb3 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 			t8 += 2;
 			t9 += 2;
 			t10 += 2;
-			const double tr2 = cc [t5 - 1] + cc [t6 - 1];
-			const double cr2 = cc [t7 - 1] + (taur * tr2);
+			const T tr2 = cc [t5 - 1] + cc [t6 - 1];
+			const T cr2 = cc [t7 - 1] + (taur * tr2);
 			ch [t8 - 1] = cc [t7 - 1] + tr2;
-			const double ti2 = cc [t5] - cc [t6];
-			const double ci2 = cc [t7] + (taur * ti2);
+			const T ti2 = cc [t5] - cc [t6];
+			const T ci2 = cc [t7] + (taur * ti2);
 			ch [t8] = cc [t7] + ti2;
-			const double cr3 = taui * (cc [t5 - 1] - cc [t6 - 1]);
-			const double ci3 = taui * (cc [t5] + cc [t6]);
-			const double dr2 = cr2 - ci3;
-			const double dr3 = cr2 + ci3;
-			const double di2 = ci2 + cr3;
-			const double di3 = ci2 - cr3;
+			const T cr3 = taui * (cc [t5 - 1] - cc [t6 - 1]);
+			const T ci3 = taui * (cc [t5] + cc [t6]);
+			const T dr2 = cr2 - ci3;
+			const T dr3 = cr2 + ci3;
+			const T di2 = ci2 + cr3;
+			const T di3 = ci2 - cr3;
 			ch [t9 - 1] = wa1 [i - 2] * dr2 - wa1 [i - 1] * di2;
 			ch [t9] = wa1 [i - 2] * di2 + wa1 [i - 1] * dr2;
 			ch [t10 - 1] = wa2 [i - 2] * dr3 - wa2 [i - 1] * di3;
@@ -820,7 +829,8 @@ static void dradb3 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 	}
 }
 
-static void dradb4 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa1,
+template <typename T>
+static void dradb4 (integer ido, integer l1, T * cc, T * ch, FFT_DATA_TYPE * wa1,
 	FFT_DATA_TYPE * wa2, FFT_DATA_TYPE * wa3)
 {
 	static constexpr double sqrt2 = 1.4142135623730950488016887242097;
@@ -835,10 +845,10 @@ static void dradb4 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 	{
 		t4 = t3 + t6;
 		t5 = t1;
-		const double tr3 = cc [t4 - 1] + cc [t4 - 1];
-		const double tr4 = cc [t4] + cc [t4];
-		const double tr1 = cc [t3] - cc [(t4 += t6) - 1];
-		const double tr2 = cc [t3] + cc [t4 - 1];
+		const T tr3 = cc [t4 - 1] + cc [t4 - 1];
+		const T tr4 = cc [t4] + cc [t4];
+		const T tr1 = cc [t3] - cc [(t4 += t6) - 1];
+		const T tr2 = cc [t3] + cc [t4 - 1];
 		ch [t5] = tr2 + tr3;
 		ch [t5 += t0] = tr1 - tr4;
 		ch [t5 += t0] = tr2 - tr3;
@@ -864,22 +874,22 @@ static void dradb4 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 			t4 -= 2;
 			t5 -= 2;
 			t7 += 2;
-			const double ti1 = cc [t2] + cc [t5];
-			const double ti2 = cc [t2] - cc [t5];
-			const double ti3 = cc [t3] - cc [t4];
-			const double tr4 = cc [t3] + cc [t4];
-			const double tr1 = cc [t2 - 1] - cc [t5 - 1];
-			const double tr2 = cc [t2 - 1] + cc [t5 - 1];
-			const double ti4 = cc [t3 - 1] - cc [t4 - 1];
-			const double tr3 = cc [t3 - 1] + cc [t4 - 1];
+			const T ti1 = cc [t2] + cc [t5];
+			const T ti2 = cc [t2] - cc [t5];
+			const T ti3 = cc [t3] - cc [t4];
+			const T tr4 = cc [t3] + cc [t4];
+			const T tr1 = cc [t2 - 1] - cc [t5 - 1];
+			const T tr2 = cc [t2 - 1] + cc [t5 - 1];
+			const T ti4 = cc [t3 - 1] - cc [t4 - 1];
+			const T tr3 = cc [t3 - 1] + cc [t4 - 1];
 			ch [t7 - 1] = tr2 + tr3;
-			const double cr3 = tr2 - tr3;
+			const T cr3 = tr2 - tr3;
 			ch [t7] = ti2 + ti3;
-			const double ci3 = ti2 - ti3;
-			const double cr2 = tr1 - tr4;
-			const double cr4 = tr1 + tr4;
-			const double ci2 = ti1 + ti4;
-			const double ci4 = ti1 - ti4;
+			const T ci3 = ti2 - ti3;
+			const T cr2 = tr1 - tr4;
+			const T cr4 = tr1 + tr4;
+			const T ci2 = ti1 + ti4;
+			const T ci4 = ti1 - ti4;
 
 			ch [(t8 = t7 + t0) - 1] = wa1 [i - 2] * cr2 - wa1 [i - 1] * ci2;
 			ch [t8] = wa1 [i - 2] * ci2 + wa1 [i - 1] * cr2;
@@ -903,10 +913,10 @@ static void dradb4 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 	for (integer k = 0; k < l1; k++)
 	{
 		t5 = t3;
-		const double ti1 = cc [t1] + cc [t4];
-		const double ti2 = cc [t4] - cc [t1];
-		const double tr1 = cc [t1 - 1] - cc [t4 - 1];
-		const double tr2 = cc [t1 - 1] + cc [t4 - 1];
+		const T ti1 = cc [t1] + cc [t4];
+		const T ti2 = cc [t4] - cc [t1];
+		const T tr1 = cc [t1 - 1] - cc [t4 - 1];
+		const T tr2 = cc [t1 - 1] + cc [t4 - 1];
 		ch [t5] = tr2 + tr2;
 		ch [t5 += t0] = sqrt2 * (tr1 - ti1);
 		ch [t5 += t0] = ti2 + ti2;
@@ -918,8 +928,9 @@ static void dradb4 (integer ido, integer l1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE *
 	}
 }
 
-static void dradbg (integer ido, integer ip, integer l1, integer idl1, FFT_DATA_TYPE * cc, FFT_DATA_TYPE * c1,
-	FFT_DATA_TYPE * c2, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * ch2, FFT_DATA_TYPE * wa)
+template <typename T>
+static void dradbg (integer ido, integer ip, integer l1, integer idl1, T * cc, T * c1,
+	T * c2, T * ch, T * ch2, FFT_DATA_TYPE * wa)
 {
 	static constexpr double tpi = 6.28318530717958647692528676655900577;
 	integer is, t1, t2, t3, t4, t5, t6, t7, t8, t9, t11, t12;
@@ -1270,7 +1281,8 @@ static void dradbg (integer ido, integer ip, integer l1, integer idl1, FFT_DATA_
 	}
 }
 
-static void drftb1 (integer n, FFT_DATA_TYPE * c, FFT_DATA_TYPE * ch, FFT_DATA_TYPE * wa, integer *ifac)
+template <typename T>
+static void drftb1 (integer n, T * c, T * ch, FFT_DATA_TYPE * wa, integer *ifac)
 {
 	const integer nf = ifac [1];
 	integer na = 0;
@@ -24,13 +24,15 @@
 #include "NUM2.h"
 #include "melder.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #define FFT_DATA_TYPE double
 #include "NUMfft_core.h"
 
 void NUMforwardRealFastFourierTransform (VEC data) {
-	autoNUMfft_Table table;
-	NUMfft_Table_init (& table, data.size);
-	NUMfft_forward (& table, data);
+	NUMfft_forward (data);
 	if (data.size > 1) {
 		/*
 			To be compatible with old behaviour.
@@ -43,7 +45,6 @@ void NUMforwardRealFastFourierTransform (VEC data) {
 }
 
 void NUMreverseRealFastFourierTransform (VEC data) {
-	autoNUMfft_Table table;
 	if (data.size > 1) {
 		/*
 			To be compatible with old behaviour.
@@ -53,14 +54,188 @@ void NUMreverseRealFastFourierTransform (VEC data) {
 			data [i] = data [i + 1];
 		data [data.size] = tmp;
 	}
-	NUMfft_Table_init (& table, data.size);
-	NUMfft_backward (& table, data);
+	NUMfft_backward (data);
+}
+
+/*
+	Parselmouth: FFTPACK transforms a size with a prime factor p > 5 with a generic radix-p pass,
+	which takes time proportional to n * p; for a prime n, the transform takes time proportional to n^2.
+	For such sizes we use Bluestein's algorithm instead: with jk = (j^2 + k^2 - (k - j)^2) / 2,
+	the DFT X [k] = sum_j x [j] exp (-2 pi i jk / n) becomes conj (b [k]) * sum_j (x [j] conj (b [j])) b [k - j],
+	with the "chirp" b [j] = exp (i pi j^2 / n), i.e. a cyclic convolution that can be computed with FFTs
+	of any size m >= 2n - 1, and we take m as a power of two. The convolution is complex; its FFTs are computed
+	as two real FFTs each, one for the real and one for the imaginary part. The backward transform of real data
+	is the real part of the forward transform of the complex conjugate of its (Hermitian) spectrum.
+	Bluestein's algorithm takes time proportional to m log m, but with a larger constant than FFTPACK,
+	and FFTPACK's generic pass becomes relatively cheaper as n / p grows. We use Bluestein if p^2 > 50 n
+	(e.g. for a prime n above 50, or for n = 16 p with p above 800), where it was measured to be faster
+	(from about 1.2 times for the smallest such p up to about 100 times for a prime n near 8000).
+	The rounding error of the generic pass grows with p (to about 1e-10 of the largest coefficient for p near 8000),
+	whereas that of Bluestein's algorithm stays near 1e-15, so for these sizes the results are more accurate
+	than, and hence not identical to, those of FFTPACK.
+*/
+static integer NUMfft_getLargestPrimeFactor (integer n) {
+	integer largestPrimeFactor = 1;
+	for (integer factor = 2; factor * factor <= n; factor ++) {
+		while (n % factor == 0) {
+			n /= factor;
+			largestPrimeFactor = factor;
+		}
+	}
+	return std::max (largestPrimeFactor, n);   // what remains of n is 1 or a prime
+}
+
+static bool NUMfft_usesBluestein (integer n) {
+	const integer largestPrimeFactor = NUMfft_getLargestPrimeFactor (n);
+	return largestPrimeFactor * largestPrimeFactor > 50 * n;
+}
+
+static integer NUMfft_getBluesteinSize (integer n) {
+	return Melder_iroundUpToPowerOfTwo (2 * n - 1);
+}
+
+static void NUMfft_Table_initBluestein (NUMfft_Table me) {
+	const integer n = my n;
+	my m = NUMfft_getBluesteinSize (n);
+	const integer m = my m;
+	my convolutionTrigcache = zero_VEC (3 * m);
+	my convolutionSplitcache = zero_INTVEC (32);
+	NUMrffti (m, my convolutionTrigcache.asArgumentToFunctionThatExpectsZeroBasedArray(),
+		my convolutionSplitcache.asArgumentToFunctionThatExpectsZeroBasedArray()
+	);
+	my chirp = raw_VEC (2 * n);
+	for (integer j = 0; j < n; j ++) {
+		const double phase = NUMpi * double ((j * j) % (2 * n)) / n;   // j^2 modulo 2n keeps the phase exact
+		my chirp [2 * j + 1] = cos (phase);
+		my chirp [2 * j + 2] = sin (phase);
+	}
+	/*
+		The chirp, wrapped around m, is symmetric (b [m - j] = b [j]),
+		so the transforms of its real and imaginary parts are real.
+	*/
+	std::vector <double> re (uinteger (m), 0.0), im (uinteger (m), 0.0), scratch (uinteger (m), 0.0);
+	for (integer j = 0; j < n; j ++) {
+		re [uinteger (j)] = my chirp [2 * j + 1];
+		im [uinteger (j)] = my chirp [2 * j + 2];
+		if (j > 0) {
+			re [uinteger (m - j)] = re [uinteger (j)];
+			im [uinteger (m - j)] = im [uinteger (j)];
+		}
+	}
+	const double *wa = my convolutionTrigcache.asArgumentToFunctionThatExpectsZeroBasedArray() + m;
+	integer *ifac = my convolutionSplitcache.asArgumentToFunctionThatExpectsZeroBasedArray();
+	drftf1 (m, re.data(), scratch.data(), const_cast <double *> (wa), ifac);
+	drftf1 (m, im.data(), scratch.data(), const_cast <double *> (wa), ifac);
+	my chirpSpectrum = raw_VEC (m + 2);
+	for (integer k = 0; k <= m / 2; k ++) {
+		const integer ire = ( k == 0 ? 0 : 2 * k - 1 );   // m is even, so the real part of k = m/2 is at m - 1
+		my chirpSpectrum [2 * k + 1] = re [uinteger (ire)] / m;
+		my chirpSpectrum [2 * k + 2] = im [uinteger (ire)] / m;
+	}
+}
+
+/*
+	The forward transform of the complex sequence z [0..n-1] into the complex sequence x [0..n-1];
+	xim can be nullptr if only the real part is needed. Uses 3m elements of scratch memory.
+*/
+static void NUMfft_Table_transformBluestein (NUMfft_Table me, const double *zre, const double *zim,
+	double *xre, double *xim, double *scratch)
+{
+	const integer n = my n, m = my m;
+	double *re = scratch, *im = scratch + m, *work = scratch + 2 * m;
+	double *wa = my convolutionTrigcache.asArgumentToFunctionThatExpectsZeroBasedArray() + m;
+	integer *ifac = my convolutionSplitcache.asArgumentToFunctionThatExpectsZeroBasedArray();
+	const double *chirp = my chirp.asArgumentToFunctionThatExpectsZeroBasedArray();
+	const double *chirpSpectrum = my chirpSpectrum.asArgumentToFunctionThatExpectsZeroBasedArray();
+	/*
+		a [j] = z [j] conj (b [j]), padded with zeroes.
+	*/
+	for (integer j = 0; j < n; j ++) {
+		const double bre = chirp [2 * j], bim = chirp [2 * j + 1];
+		const double are = zre [j], aim = ( zim ? zim [j] : 0.0 );
+		re [j] = are * bre + aim * bim;
+		im [j] = aim * bre - are * bim;
+	}
+	for (integer j = n; j < m; j ++)
+		re [j] = im [j] = 0.0;
+	drftf1 (m, re, work, wa, ifac);
+	drftf1 (m, im, work, wa, ifac);
+	/*
+		The real and imaginary parts of the chirp are even, so their transforms U and V are real,
+		and the transforms of the real and imaginary parts of the convolution c = a * b are
+		FFT (re) U - FFT (im) V and FFT (re) V + FFT (im) U.
+	*/
+	for (integer k = 0; k <= m / 2; k ++) {
+		const double u = chirpSpectrum [2 * k], v = chirpSpectrum [2 * k + 1];
+		const integer ire = ( k == 0 ? 0 : 2 * k - 1 );
+		const double p = re [ire], r = im [ire];
+		re [ire] = p * u - r * v;
+		im [ire] = p * v + r * u;
+		if (k > 0 && k < m / 2) {
+			const double q = re [2 * k], t = im [2 * k];
+			re [2 * k] = q * u - t * v;
+			im [2 * k] = q * v + t * u;
+		}
+	}
+	drftb1 (m, re, work, wa, ifac);
+	drftb1 (m, im, work, wa, ifac);
+	/*
+		x [k] = conj (b [k]) c [k].
+	*/
+	for (integer k = 0; k < n; k ++) {
+		const double bre = chirp [2 * k], bim = chirp [2 * k + 1];
+		xre [k] = re [k] * bre + im [k] * bim;
+		if (xim)
+			xim [k] = im [k] * bre - re [k] * bim;
+	}
+}
+
+/*
+	In place, on data [0..n-1], with the layout of FFTPACK (see NUM2.h). Uses 6m elements of scratch memory.
+*/
+static void NUMfft_Table_forwardBluestein (NUMfft_Table me, double *data, double *scratch) {
+	const integer n = my n;
+	double *xre = scratch + 3 * my m, *xim = xre + n;
+	NUMfft_Table_transformBluestein (me, data, nullptr, xre, xim, scratch);
+	data [0] = xre [0];
+	for (integer k = 1; 2 * k < n; k ++) {
+		data [2 * k - 1] = xre [k];
+		data [2 * k] = xim [k];
+	}
+	if (n % 2 == 0)
+		data [n - 1] = xre [n / 2];
+}
+
+static void NUMfft_Table_backwardBluestein (NUMfft_Table me, double *data, double *scratch) {
+	const integer n = my n;
+	double *zre = scratch + 3 * my m, *zim = zre + n;
+	zre [0] = data [0];
+	zim [0] = 0.0;
+	for (integer k = 1; 2 * k < n; k ++) {
+		zre [k] = zre [n - k] = data [2 * k - 1];
+		zim [k] = - data [2 * k];   // the complex conjugate of the spectrum...
+		zim [n - k] = data [2 * k];   // ...which is Hermitian
+	}
+	if (n % 2 == 0) {
+		zre [n / 2] = data [n - 1];
+		zim [n / 2] = 0.0;
+	}
+	NUMfft_Table_transformBluestein (me, zre, zim, data, nullptr, scratch);
+}
+
+static integer NUMfft_Table_getNumberOfScratchElements (NUMfft_Table me) {
+	return 6 * my m;
 }
 
 void NUMfft_forward (NUMfft_Table me, VEC data) {
 	if (my n == 1)
 		return;
 	Melder_assert (my n == data.size);
+	if (my m > 0) {
+		std::vector <double> scratch (uinteger (NUMfft_Table_getNumberOfScratchElements (me)));
+		NUMfft_Table_forwardBluestein (me, data.asArgumentToFunctionThatExpectsZeroBasedArray(), scratch.data());
+		return;
+	}
 	drftf1 (my n, data.asArgumentToFunctionThatExpectsZeroBasedArray(),
 		my trigcache.asArgumentToFunctionThatExpectsZeroBasedArray(),
 		my trigcache.asArgumentToFunctionThatExpectsZeroBasedArray() + my n,
@@ -72,6 +247,11 @@ void NUMfft_backward (NUMfft_Table me, VEC data) {
 	if (my n == 1)
 		return;
 	Melder_assert (my n == data.size);
+	if (my m > 0) {
+		std::vector <double> scratch (uinteger (NUMfft_Table_getNumberOfScratchElements (me)));
+		NUMfft_Table_backwardBluestein (me, data.asArgumentToFunctionThatExpectsZeroBasedArray(), scratch.data());
+		return;
+	}
 	drftb1 (my n, data.asArgumentToFunctionThatExpectsZeroBasedArray(),
 		my trigcache.asArgumentToFunctionThatExpectsZeroBasedArray(),
 		my trigcache.asArgumentToFunctionThatExpectsZeroBasedArray() + my n,
@@ -86,6 +266,207 @@ void NUMfft_Table_init (NUMfft_Table me, integer n) {
 	NUMrffti (n, my trigcache.asArgumentToFunctionThatExpectsZeroBasedArray(),
 		my splitcache.asArgumentToFunctionThatExpectsZeroBasedArray()
 	);
+	my m = 0;
+	if (NUMfft_usesBluestein (n))
+		NUMfft_Table_initBluestein (me);
+}
+
+/*
+	Parselmouth: many callers transform data of the same few sizes over and over again
+	(e.g. resampling, filtering, or every call to Sound_to_Spectrum), and used to recompute the table every time.
+	We keep the most recently used tables in a per-thread cache instead. The tables cannot be shared between threads,
+	because drftf1 and drftb1 use the first n elements of the trigonometric cache as scratch space.
+	The cache is bounded by the total size of its tables rather than by their number, so that every thread
+	(including the persistent worker threads) holds at most a few megabytes; the least recently used tables are
+	evicted first. Tables that are larger than the whole budget are not cached, since computing them is cheap
+	compared to the transform itself. The cache is a thread_local object, so its tables are freed when the thread exits.
+*/
+static constexpr integer maximumCachedTableBytes = 4 << 20;
+
+static integer NUMfft_Table_getNumberOfBytes (integer n) {
+	integer numberOfBytes = 3 * n * integer (sizeof (double)) + 32 * integer (sizeof (integer));   // trigcache and splitcache
+	if (NUMfft_usesBluestein (n)) {
+		const integer m = NUMfft_getBluesteinSize (n);
+		numberOfBytes += 3 * m * integer (sizeof (double)) + 32 * integer (sizeof (integer))   // the same for the convolution
+				+ (2 * n + m + 2) * integer (sizeof (double));   // chirp and chirpSpectrum
+	}
+	return numberOfBytes;
+}
+
+struct NUMfft_TableCache {
+	std::vector <std::unique_ptr <autoNUMfft_Table>> tables;   // from least to most recently used
+	integer numberOfBytes = 0;
+
+	NUMfft_Table get (integer n) {
+		for (auto it = tables.begin(); it != tables.end(); ++ it) {
+			if ((*it) -> n == n) {
+				std::rotate (it, it + 1, tables.end());
+				return tables.back().get();
+			}
+		}
+		const integer numberOfBytesOfTable = NUMfft_Table_getNumberOfBytes (n);
+		auto table = std::make_unique <autoNUMfft_Table> ();
+		NUMfft_Table_init (table.get(), n);
+		while (! tables.empty() && numberOfBytes + numberOfBytesOfTable > maximumCachedTableBytes) {
+			numberOfBytes -= NUMfft_Table_getNumberOfBytes (tables.front() -> n);
+			tables.erase (tables.begin());
+		}
+		tables.push_back (std::move (table));
+		numberOfBytes += numberOfBytesOfTable;
+		return tables.back().get();
+	}
+};
+
+static bool isCacheable (integer n) {
+	return NUMfft_Table_getNumberOfBytes (n) <= maximumCachedTableBytes;
+}
+
+static NUMfft_Table getCachedTable (integer n) {
+	static thread_local NUMfft_TableCache cache;
+	return cache.get (n);
+}
+
+void NUMfft_forward (VEC data) {
+	if (! isCacheable (data.size)) {
+		autoNUMfft_Table table;
+		NUMfft_Table_init (& table, data.size);
+		NUMfft_forward (& table, data);
+	} else {
+		NUMfft_forward (getCachedTable (data.size), data);
+	}
+}
+
+void NUMfft_backward (VEC data) {
+	if (! isCacheable (data.size)) {
+		autoNUMfft_Table table;
+		NUMfft_Table_init (& table, data.size);
+		NUMfft_backward (& table, data);
+	} else {
+		NUMfft_backward (getCachedTable (data.size), data);
+	}
+}
+
+/*
+	Parselmouth: the batched transforms interleave numberOfLanes rows: element i of a NUMfft_Lanes holds sample i
+	of each of numberOfLanes frames, and every addition, subtraction, and multiplication by a twiddle factor
+	in the FFTPACK routines acts on all of these frames at once. The compiler turns these short fixed-size loops
+	into SIMD instructions (SSE2, AVX, or NEON, depending on the target), but per lane the arithmetic is exactly that
+	of the scalar routines, so every row gets the same result as when it is transformed on its own.
+	The rows that are left over after the last full group of lanes are transformed one by one, with the scalar routines,
+	as are all rows of sizes that are transformed with Bluestein's algorithm.
+*/
+static constexpr integer NUMfft_numberOfLanes = 8;
+
+template <integer numberOfLanes>
+struct NUMfft_Lanes {
+	double lanes [numberOfLanes];
+};
+
+template <integer numberOfLanes>
+inline NUMfft_Lanes <numberOfLanes> operator+ (NUMfft_Lanes <numberOfLanes> const& x, NUMfft_Lanes <numberOfLanes> const& y) {
+	NUMfft_Lanes <numberOfLanes> result;
+	for (integer ilane = 0; ilane < numberOfLanes; ilane ++)
+		result.lanes [ilane] = x.lanes [ilane] + y.lanes [ilane];
+	return result;
+}
+
+template <integer numberOfLanes>
+inline NUMfft_Lanes <numberOfLanes> operator- (NUMfft_Lanes <numberOfLanes> const& x, NUMfft_Lanes <numberOfLanes> const& y) {
+	NUMfft_Lanes <numberOfLanes> result;
+	for (integer ilane = 0; ilane < numberOfLanes; ilane ++)
+		result.lanes [ilane] = x.lanes [ilane] - y.lanes [ilane];
+	return result;
+}
+
+template <integer numberOfLanes>
+inline NUMfft_Lanes <numberOfLanes> operator- (NUMfft_Lanes <numberOfLanes> const& x) {
+	NUMfft_Lanes <numberOfLanes> result;
+	for (integer ilane = 0; ilane < numberOfLanes; ilane ++)
+		result.lanes [ilane] = - x.lanes [ilane];
+	return result;
+}
+
+template <integer numberOfLanes>
+inline NUMfft_Lanes <numberOfLanes> operator* (double factor, NUMfft_Lanes <numberOfLanes> const& x) {
+	NUMfft_Lanes <numberOfLanes> result;
+	for (integer ilane = 0; ilane < numberOfLanes; ilane ++)
+		result.lanes [ilane] = factor * x.lanes [ilane];
+	return result;
+}
+
+template <integer numberOfLanes>
+inline NUMfft_Lanes <numberOfLanes>& operator+= (NUMfft_Lanes <numberOfLanes>& x, NUMfft_Lanes <numberOfLanes> const& y) {
+	for (integer ilane = 0; ilane < numberOfLanes; ilane ++)
+		x.lanes [ilane] += y.lanes [ilane];
+	return x;
+}
+
+template <bool forward, typename T>
+static void NUMfft_transform (NUMfft_Table me, T *data, T *scratch) {
+	if (forward)
+		drftf1 (my n, data, scratch,
+			my trigcache.asArgumentToFunctionThatExpectsZeroBasedArray() + my n,
+			my splitcache.asArgumentToFunctionThatExpectsZeroBasedArray()
+		);
+	else
+		drftb1 (my n, data, scratch,
+			my trigcache.asArgumentToFunctionThatExpectsZeroBasedArray() + my n,
+			my splitcache.asArgumentToFunctionThatExpectsZeroBasedArray()
+		);
+}
+
+template <bool forward>
+static void NUMfft_transformRows (NUMfft_Table me, MATVU const& frames) {
+	Melder_assert (frames.ncol == my n);
+	if (my n == 1)
+		return;
+	if (my m > 0) {
+		std::vector <double> data (uinteger (my n)), scratch (uinteger (NUMfft_Table_getNumberOfScratchElements (me)));
+		for (integer irow = 1; irow <= frames.nrow; irow ++) {
+			for (integer i = 1; i <= my n; i ++)
+				data [uinteger (i - 1)] = frames [irow] [i];
+			if (forward)
+				NUMfft_Table_forwardBluestein (me, data.data(), scratch.data());
+			else
+				NUMfft_Table_backwardBluestein (me, data.data(), scratch.data());
+			for (integer i = 1; i <= my n; i ++)
+				frames [irow] [i] = data [uinteger (i - 1)];
+		}
+		return;
+	}
+	using Lanes = NUMfft_Lanes <NUMfft_numberOfLanes>;
+	const integer numberOfGroups = frames.nrow / NUMfft_numberOfLanes;
+	if (numberOfGroups > 0) {
+		std::vector <Lanes> data (uinteger (my n)), scratch (uinteger (my n));
+		for (integer igroup = 0; igroup < numberOfGroups; igroup ++) {
+			const integer rowOffset = igroup * NUMfft_numberOfLanes;
+			for (integer i = 1; i <= my n; i ++)
+				for (integer ilane = 0; ilane < NUMfft_numberOfLanes; ilane ++)
+					data [uinteger (i - 1)]. lanes [ilane] = frames [rowOffset + 1 + ilane] [i];
+			NUMfft_transform <forward> (me, data.data(), scratch.data());
+			for (integer i = 1; i <= my n; i ++)
+				for (integer ilane = 0; ilane < NUMfft_numberOfLanes; ilane ++)
+					frames [rowOffset + 1 + ilane] [i] = data [uinteger (i - 1)]. lanes [ilane];
+		}
+	}
+	if (numberOfGroups * NUMfft_numberOfLanes < frames.nrow) {
+		std::vector <double> data (uinteger (my n)), scratch (uinteger (my n));
+		for (integer irow = numberOfGroups * NUMfft_numberOfLanes + 1; irow <= frames.nrow; irow ++) {
+			for (integer i = 1; i <= my n; i ++)
+				data [uinteger (i - 1)] = frames [irow] [i];
+			NUMfft_transform <forward> (me, data.data(), scratch.data());
+			for (integer i = 1; i <= my n; i ++)
+				frames [irow] [i] = data [uinteger (i - 1)];
+		}
+	}
+}
+
+void NUMfft_forward (NUMfft_Table me, MATVU const& frames) {
+	NUMfft_transformRows <true> (me, frames);
+}
+
+void NUMfft_backward (NUMfft_Table me, MATVU const& frames) {
+	NUMfft_transformRows <false> (me, frames);
 }
 
 void NUMrealft (VEC data, integer isign) {
@@ -62,6 +62,61 @@ static void regression (const VEC r, const CC me, const integer frameNumber, con
 	}
 }
 
+/*
+	Parselmouth: the regression coefficients of every frame, computed once instead of once for every pair of frames.
+	The frames that are too close to an edge for a whole regression window get those of the last frame that has one,
+	as they did in CCs_to_DTW, where regression () left them unchanged (the first frames got uninitialized memory).
+*/
+static autoMAT CC_getRegressions (const CC me, const integer numberOfCoefficients) {
+	autoMAT regressions = zero_MAT (my nx, my maximumNumberOfCoefficients + 1);
+	for (integer iframe = 1; iframe <= my nx; iframe ++)
+		regression (regressions.row (iframe), me, iframe, numberOfCoefficients);
+	const integer numberOfCoefficientsd2 = numberOfCoefficients / 2;
+	const integer lastFrame = my nx - numberOfCoefficientsd2 - 1;   // the last frame with a whole regression window
+	if (lastFrame > numberOfCoefficientsd2)
+		for (integer iframe = 1; iframe <= my nx; iframe ++)
+			if (iframe <= numberOfCoefficientsd2 || iframe > lastFrame)
+				regressions.row (iframe)  <<=  regressions.row (lastFrame);
+	return regressions;
+}
+
+static double getFrameDistance (const CC_Frame fi, const CC_Frame fj, constVEC const& ri, constVEC const& rj,
+	const double coefficientWeight, const double logEnergyWeight,
+	const double coefficientRegressionWeight, const double logEnergyRegressionWeight
+) {
+	longdouble dist = 0.0;
+
+	if (coefficientWeight != 0.0) {
+		for (integer k = 1; k <= fj -> numberOfCoefficients; k ++) {
+			const double d = fi -> c [k] - fj -> c [k];
+			dist += d * d;
+		}
+		dist *= coefficientWeight;
+	}
+
+	if (logEnergyWeight != 0.0) {
+		const double d = fi -> c0 - fj -> c0;
+		dist += logEnergyWeight * d * d;
+	}
+
+	if (coefficientRegressionWeight != 0.0) {
+		longdouble distr = 0.0;
+		for (integer k = 2; k <= fj -> numberOfCoefficients + 1; k ++) {
+			const double d = ri [k] - rj [k];
+			distr += d * d;
+		}
+		dist += coefficientRegressionWeight * distr;
+	}
+
+	if (logEnergyRegressionWeight != 0.0) {
+		const double d = ri [1] - rj [1];
+		dist += logEnergyRegressionWeight * d * d;
+	}
+
+	dist /= coefficientWeight + logEnergyWeight + coefficientRegressionWeight + logEnergyRegressionWeight;
+	return sqrt ((double) dist);
+}
+
 autoDTW CCs_to_DTW (const CC me, const CC thee,
 	const double coefficientWeight, const double logEnergyWeight,
 	const double coefficientRegressionWeight, const double logEnergyRegressionWeight,
@@ -83,9 +138,12 @@ autoDTW CCs_to_DTW (const CC me, const CC thee,
 trace(1, U" regression window length ", regressionWindowLength, U" dx ", my dx, U" #coeff ", numberOfCoefficients);
 		autoDTW him = DTW_create (my xmin, my xmax, my nx, my dx, my x1, thy xmin, thy xmax, thy nx, thy dx, thy x1);
 trace(2);
-		autoVEC ri = raw_VEC (my maximumNumberOfCoefficients + 1);
-trace(3);
-		autoVEC rj = raw_VEC (my maximumNumberOfCoefficients + 1);
+		const bool useRegression = ( coefficientRegressionWeight != 0.0 || logEnergyRegressionWeight != 0.0 );
+		autoMAT myRegressions, thyRegressions;
+		if (useRegression) {
+			myRegressions = CC_getRegressions (me, numberOfCoefficients);
+			thyRegressions = CC_getRegressions (thee, numberOfCoefficients);
+		}
 trace(4);
 
 		/*
@@ -96,47 +154,14 @@ trace(4);
 			trace (U"iframe ", iframe, U"/", my nx);
 			const CC_Frame fi = & my frame [iframe];
 trace(5);
-			if (coefficientRegressionWeight != 0.0 || logEnergyRegressionWeight != 0.0)
-				regression (ri.get(), me, iframe, numberOfCoefficients);
+			const constVEC ri = ( useRegression ? myRegressions.row (iframe) : constVEC () );
 
 trace(6);
 			for (integer jframe = 1; jframe <= thy nx; jframe ++) {
 				//trace (U"jframe ", jframe, U"/", thy nx);
-				const CC_Frame fj = & thy frame [jframe];
-				longdouble dist = 0.0;
-
-				if (coefficientWeight != 0.0) {
-					for (integer k = 1; k <= fj -> numberOfCoefficients; k ++) {
-						const double d = fi -> c [k] - fj -> c [k];
-						dist += d * d;
-					}
-					dist *= coefficientWeight;
-				}
-
-				if (logEnergyWeight != 0.0) {
-					const double d = fi -> c0 - fj -> c0;
-					dist += logEnergyWeight * d * d;
-				}
-
-				if (coefficientRegressionWeight != 0.0) {
-					longdouble distr = 0.0;
-					regression (rj.get(), thee, jframe, numberOfCoefficients);
-					for (integer k = 2; k <= fj -> numberOfCoefficients + 1; k ++) {
-						const double d = ri [k] - rj [k];
-						distr += d * d;
-					}
-					dist += coefficientRegressionWeight * distr;
-				}
-
-				if (logEnergyRegressionWeight != 0.0) {
-					if (coefficientRegressionWeight == 0.0)
-						regression (rj.get(), thee, jframe, numberOfCoefficients);
-					const double d = ri [1] - rj [1];
-					dist += logEnergyRegressionWeight * d * d;
-				}
-
-				dist /= coefficientWeight + logEnergyWeight + coefficientRegressionWeight + logEnergyRegressionWeight;
-				his z [iframe] [jframe] = sqrt ((double) dist);   // prototype along y-direction
+				const constVEC rj = ( useRegression ? thyRegressions.row (jframe) : constVEC () );
+				his z [iframe] [jframe] = getFrameDistance (fi, & thy frame [jframe], ri, rj,   // prototype along y-direction
+					coefficientWeight, logEnergyWeight, coefficientRegressionWeight, logEnergyRegressionWeight);
 			}
 
 			if (iframe % 10 == 1)
@@ -148,4 +173,45 @@ trace(6);
 	}
 }
 
+autoDurationTier CCs_to_DurationTier_pathInBand (const CC me, const CC thee,
+	const double coefficientWeight, const double logEnergyWeight,
+	const double coefficientRegressionWeight, const double logEnergyRegressionWeight,
+	const double regressionWindowLength, const double sakoeChibaBand, const int slope
+) {
+	try {
+		integer numberOfCoefficients = Melder_ifloor (regressionWindowLength / my dx);
+
+		Melder_require (my maximumNumberOfCoefficients == thy maximumNumberOfCoefficients,
+			U"The maximum number of coefficients should be equal.");
+		Melder_require (! (coefficientRegressionWeight != 0.0 && numberOfCoefficients < 2),
+			U"Time window for regression is too small.");
+
+		if (numberOfCoefficients % 2 == 0)
+			numberOfCoefficients ++;
+
+		Melder_assert (numberOfCoefficients > 1 || (coefficientRegressionWeight == 0.0 && logEnergyRegressionWeight == 0.0));
+		const bool useRegression = ( coefficientRegressionWeight != 0.0 || logEnergyRegressionWeight != 0.0 );
+		autoMAT myRegressions, thyRegressions;
+		if (useRegression) {
+			myRegressions = CC_getRegressions (me, numberOfCoefficients);
+			thyRegressions = CC_getRegressions (thee, numberOfCoefficients);
+		}
+
+		return DTW_findPathInBand (me, thee,
+			[&] (integer ix, integer fromRow, VEC const& distances) {
+				const CC_Frame fj = & thy frame [ix];
+				const constVEC rj = ( useRegression ? thyRegressions.row (ix) : constVEC () );
+				for (integer k = 1; k <= distances.size; k ++) {
+					const integer iframe = fromRow - 1 + k;
+					const constVEC ri = ( useRegression ? myRegressions.row (iframe) : constVEC () );
+					distances [k] = getFrameDistance (& my frame [iframe], fj, ri, rj,
+						coefficientWeight, logEnergyWeight, coefficientRegressionWeight, logEnergyRegressionWeight);
+				}
+			}, sakoeChibaBand, slope, nullptr
+		);
+	} catch (MelderError) {
+		Melder_throw (U"Path in band not found from CCs.");
+	}
+}
+
 /* End of file CCs_to_DTW.cpp */
@@ -49,4 +49,10 @@ autoDTW CCs_to_DTW (CC me, CC thee, double coefficientWeight, double logEnergyWe
 	at least one of the four weights != 0
 */
 
+autoDurationTier CCs_to_DurationTier_pathInBand (CC me, CC thee, double coefficientWeight, double logEnergyWeight, double coefficientRegressionWeight, double logEnergyRegressionWeight, double regressionWindowLength, double sakoeChibaBand, int slope);
+/*
+	Parselmouth: the path of CCs_to_DTW followed by DTW_findPath_bandAndSlope, without the distance matrix
+	(see DTW_findPathInBand), with the same distances between the frames.
+*/
+
 #endif /* _CCs_to_DTW_h_ */
@@ -41,6 +41,7 @@
 #include "Sound_extensions.h"
 #include "NUM2.h"
 #include "NUMmachar.h"
+#include "MelderThread.h"
 
 #include "oo_DESTROY.h"
 #include "DTW_def.h"
@@ -787,6 +788,28 @@ void DTW_drawDistancesAlongPath (DTW me, Graphics g, double xmin, double xmax, d
 /*
 	metric = 1...n (sum (a_i^n))^(1/n)
 */
+static double getFrameDistance (constVECVU const& x, constVECVU const& y, double metric) {
+	/*
+		First divide distance by maximum to prevent overflow when metric
+		is a large number.
+		d = (x^n)^(1/n) may overflow if x>1 & n >>1 even if d would not overflow!
+	*/
+	double dmax = 0.0, d = 0.0;
+	for (integer k = 1; k <= x.size; k ++) {
+		const double dtmp = fabs (x [k] - y [k]);
+		if (dtmp > dmax)
+			dmax = dtmp;
+	}
+	if (dmax > 0) {
+		for (integer k = 1; k <= x.size; k ++) {
+			const double dtmp = fabs (x [k] - y [k]) / dmax;
+			d +=  pow (dtmp, metric);
+		}
+	}
+	d = dmax * pow (d, 1.0 / metric);
+	return d / x.size; // == d * dy / ymax
+}
+
 autoDTW Matrices_to_DTW (Matrix me, Matrix thee, bool matchStart, bool matchEnd, int slope, double metric) {
 	try {
 		Melder_require (thy ny == my ny,
@@ -795,27 +818,8 @@ autoDTW Matrices_to_DTW (Matrix me, Matrix thee, bool matchStart, bool matchEnd,
 		autoDTW him = DTW_create (my xmin, my xmax, my nx, my dx, my x1, thy xmin, thy xmax, thy nx, thy dx, thy x1);
 		autoMelderProgress progess (U"Calculate distances");
 		for (integer i = 1; i <= my nx; i ++) {
-			for (integer j = 1; j <= thy nx; j ++) {
-				/*
-					First divide distance by maximum to prevent overflow when metric
-					is a large number.
-					d = (x^n)^(1/n) may overflow if x>1 & n >>1 even if d would not overflow!
-				*/
-				double dmax = 0.0, d = 0.0;
-				for (integer k = 1; k <= my ny; k ++) {
-					const double dtmp = fabs (my z [k] [i] - thy z [k] [j]);
-					if (dtmp > dmax)
-						dmax = dtmp;
-				}
-				if (dmax > 0) {
-					for (integer k = 1; k <= my ny; k ++) {
-						const double dtmp = fabs (my z [k] [i] - thy z [k] [j]) / dmax;
-						d +=  pow (dtmp, metric);
-					}
-				}
-				d = dmax * pow (d, 1.0 / metric);
-				his z [i] [j] = d / my ny; // == d * dy / ymax
-			}
+			for (integer j = 1; j <= thy nx; j ++)
+				his z [i] [j] = getFrameDistance (my z.column (i), thy z.column (j), metric);
 			if ((i % 10) == 1) {
 				Melder_progress (0.999 * i / my nx, U"Calculate distances: column ", i, U" from ", my nx, U".");
 			}
@@ -916,6 +920,20 @@ autoDTW Pitches_to_DTW_sgc (Pitch me, Pitch thee, double vuv_costs, double time_
 	}
 }
 
+static double getPitchDistance (double pitchy, double pitchx, double t1, double t2, double vuv_costs, double time_weight) {
+	const double dist_t = fabs (t1 - t2);
+	double dist_f = 0; // based on pitch difference
+	if (isundef (pitchy)) {
+		if (isdefined (pitchx))
+			dist_f = vuv_costs;
+	} else if (isundef (pitchx)) {
+		dist_f = vuv_costs;
+	} else {
+		dist_f = fabs (pitchy - pitchx);
+	}
+	return sqrt (dist_f * dist_f + time_weight * dist_t * dist_t);
+}
+
 autoDTW Pitches_to_DTW (Pitch me, Pitch thee, double vuv_costs, double time_weight, bool matchStart, bool matchEnd, int slope) { // vuv_costs=24, time_weight=10 ?
 	try {
 		Melder_require (vuv_costs >= 0.0,
@@ -934,17 +952,7 @@ autoDTW Pitches_to_DTW (Pitch me, Pitch thee, double vuv_costs, double time_weig
 			const double t1 = my x1 + (i - 1) * my dx;
 			for (integer j = 1; j <= thy nx; j ++) {
 				const double t2 = thy x1 + (j - 1) * thy dx;
-				const double dist_t = fabs (t1 - t2);
-				double dist_f = 0; // based on pitch difference
-				if (isundef (pitchy)) {
-					if (isdefined (pitchx [j]))
-						dist_f = vuv_costs;
-				} else if (isundef (pitchx [j])) {
-					dist_f = vuv_costs;
-				} else {
-					dist_f = fabs (pitchy - pitchx [j]);
-				}
-				his z [i] [j] = sqrt (dist_f * dist_f + time_weight * dist_t * dist_t);
+				his z [i] [j] = getPitchDistance (pitchy, pitchx [j], t1, t2, vuv_costs, time_weight);
 			}
 		}
 
@@ -955,8 +963,39 @@ autoDTW Pitches_to_DTW (Pitch me, Pitch thee, double vuv_costs, double time_weig
 	}
 }
 
-autoDurationTier DTW_to_DurationTier (DTW /* me */) {
-	return autoDurationTier();
+/*
+	Parselmouth: the relative durations along the path, i.e. the slopes of the y times as a function of the x times
+	(cf. DTW_getYTimeFromXTime), such that the y time at x is ymin plus the area under the tier up to x,
+	as in TextGrid_DurationTier_scaleTimes. For the area of a piecewise linear tier to be exact on every segment of the path,
+	each segment gets an extra point in its middle; the values at its ends are the smaller of the slopes on either side,
+	so that the middle value is not smaller than the slope of the segment itself, and never negative.
+*/
+autoDurationTier DTW_to_DurationTier (DTW me) {
+	try {
+		const RealTier path = my pathQuery.yfromx.get();
+		Melder_require (path && path -> points.size > 1,
+			U"The path should have been found.");
+		const integer numberOfPoints = path -> points.size;
+		autoVEC slopes = raw_VEC (numberOfPoints - 1);
+		for (integer i = 1; i < numberOfPoints; i ++) {
+			const RealPoint left = path -> points.at [i], right = path -> points.at [i + 1];
+			slopes [i] = (right -> value - left -> value) / (right -> number - left -> number);
+		}
+		auto getRelativeDurationAtPoint = [&] (integer i) -> double {
+			return ( i == 1 ? slopes [1] : i == numberOfPoints ? slopes [numberOfPoints - 1] : std::min (slopes [i - 1], slopes [i]) );
+		};
+		autoDurationTier thee = DurationTier_create (my xmin, my xmax);
+		for (integer i = 1; i < numberOfPoints; i ++) {
+			const double tleft = path -> points.at [i] -> number, tright = path -> points.at [i + 1] -> number;
+			const double left = getRelativeDurationAtPoint (i), right = getRelativeDurationAtPoint (i + 1);
+			RealTier_addPoint (thee.get(), tleft, left);
+			RealTier_addPoint (thee.get(), 0.5 * (tleft + tright), 2.0 * slopes [i] - 0.5 * (left + right));
+		}
+		RealTier_addPoint (thee.get(), path -> points.at [numberOfPoints] -> number, getRelativeDurationAtPoint (numberOfPoints));
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": no DurationTier created.");
+	}
 }
 
 void DTW_Matrix_replace (DTW me, Matrix thee) {
@@ -1021,7 +1060,11 @@ static void DTW_checkSlopeConstraints (DTW me, double band, int slope) {
     }
 }
 
-static void DTW_Polygon_setUnreachableParts (DTW me, Polygon thee, INTMAT const& psi) {
+/*
+	Parselmouth: for every column ix, the rows from firstRowAbove [ix] upwards and the rows from lastRowBelow [ix]
+	downwards lie outside the Polygon (my ny + 1 and 0 if there are no such rows).
+*/
+static void DTW_Polygon_getUnreachableRows (DTW me, Polygon thee, INTVEC const& lastRowBelow, INTVEC const& firstRowAbove) {
     try {
         const double eps = my dx / 100.0;   // safe enough
         const double dtw_slope = (my ymax - my ymin) / (my xmax - my xmin);
@@ -1036,26 +1079,27 @@ static void DTW_Polygon_setUnreachableParts (DTW me, Polygon thee, INTMAT const&
         for (integer ix = 1; ix <= my nx; ix ++) {
             const double x = my x1 + (ix - 1) * my dx;
             const integer iystart = Melder_ifloor (dtw_slope * ix * (my dx / my dy)) + 1;
+            firstRowAbove [ix] = my ny + 1;
             for (integer iy = iystart + 1; iy <= my ny; iy ++) {
 				const double y = my y1 + (iy - 1) * my dy;
                 if (Polygon_getLocationOfPoint (thee, x, y, eps) == Polygon_OUTSIDE) {
-                    for (integer k = iy; k <= my ny; k ++)
-                        psi [k] [ix] = DTW_UNREACHABLE;
+                    firstRowAbove [ix] = iy;
                     break;
                 }
             }
         }
         // find border "below" polygon
+        lastRowBelow [1] = 0;
         for (integer ix = 2; ix <= my nx; ix ++) {
             const double x = my x1 + (ix - 1) * my dx;
             integer iystart = Melder_ifloor (dtw_slope * ix * (my dx / my dy));   // start 1 lower
             if (iystart > my ny)
 				iystart = my ny;
+            lastRowBelow [ix] = 0;
             for (integer iy = iystart - 1; iy >= 1; iy --) {
                 const double y = my y1 + (iy - 1) * my dy;
                 if (Polygon_getLocationOfPoint (thee, x, y, eps) == Polygon_OUTSIDE) {
-                    for (integer k = iy; k >= 1; k --)
-                        psi [k] [ix] = DTW_UNREACHABLE;
+                    lastRowBelow [ix] = iy;
                     break;
                 }
             }
@@ -1065,6 +1109,17 @@ static void DTW_Polygon_setUnreachableParts (DTW me, Polygon thee, INTMAT const&
     }
 }
 
+static void DTW_Polygon_setUnreachableParts (DTW me, Polygon thee, INTMAT const& psi) {
+	autoINTVEC lastRowBelow = raw_INTVEC (my nx), firstRowAbove = raw_INTVEC (my nx);
+	DTW_Polygon_getUnreachableRows (me, thee, lastRowBelow.get(), firstRowAbove.get());
+	for (integer ix = 1; ix <= my nx; ix ++) {
+		for (integer k = firstRowAbove [ix]; k <= my ny; k ++)
+			psi [k] [ix] = DTW_UNREACHABLE;
+		for (integer k = lastRowBelow [ix]; k >= 1; k --)
+			psi [k] [ix] = DTW_UNREACHABLE;
+	}
+}
+
 #define DTW_ISREACHABLE(y,x) ((psi [y] [x] != DTW_UNREACHABLE) && (psi [y] [x] != DTW_FORBIDDEN))
 static void DTW_findPath_special (DTW me, bool /* matchStart */, bool /* matchEnd */, int slope, autoMatrix *cumulativeDists) {
 	try {
@@ -1437,4 +1492,343 @@ void DTW_Polygon_findPathInside (DTW me, Polygon thee, int localSlope, autoMatri
 	}
 }
 
+/*
+	Parselmouth: the same path as DTW_findPath_bandAndSlope, without a distance matrix.
+	Only the reachable part of the distance matrix (the band) is visited: the distances of a block of columns
+	are computed in parallel on demand and are kept, together with the cumulative distances, for as long
+	as the slope rules can look back (three columns), while the backtracking directions are stored for the
+	whole band, one byte per cell. The memory therefore grows with the area of the band instead of with nx * ny.
+	The recursion, the tie breaking and the (quirky) boundary conditions are those of DTW_Polygon_findPathInside.
+*/
+autoDurationTier DTW_findPathInBand (Sampled prototype, Sampled test, DTW_ColumnDistances const& getDistances,
+	double sakoeChibaBand, int localSlope, double *out_weightedDistance)
+{
+	try {
+		const double slopes [5] = { DTW_BIG, DTW_BIG, 3.0, 2.0, 1.5 };
+		Melder_require (localSlope > 0 && localSlope < 5,
+			U"Local slope parameter ", localSlope, U" not supported.");
+		/*
+			A DTW without distances: the geometry for the Polygon and the path.
+		*/
+		autoDTW me = Thing_new (DTW);
+		SampledXY_init (me.get(), test -> xmin, test -> xmax, test -> nx, test -> dx, test -> x1,
+				prototype -> xmin, prototype -> xmax, prototype -> nx, prototype -> dx, prototype -> x1);
+		my path = newvectorzero <structDTW_Path> (my nx + my ny - 1);
+		DTW_Path_Query_init (& my pathQuery, my ny, my nx);
+		const integer nx = my nx, ny = my ny;
+
+		autoPolygon thee = DTW_to_Polygon (me.get(), sakoeChibaBand, localSlope);
+		autoINTVEC lastRowBelow = raw_INTVEC (nx), firstRowAbove = raw_INTVEC (nx);
+		DTW_Polygon_getUnreachableRows (me.get(), thee.get(), lastRowBelow.get(), firstRowAbove.get());
+
+		/*
+			The reachable cells of column ix are the rows lowestRow [ix] .. highestRow [ix]
+			(see the start of DTW_Polygon_findPathInside: the first row and column are only reachable at the start).
+		*/
+		const integer delta_xy = std::min (nx, ny) / 10;
+		const integer rowto = ( localSlope != 1 ? Melder_ifloor (slopes [localSlope]) + 1 : delta_xy );
+		const integer colto = ( localSlope != 1 ? Melder_ifloor (slopes [localSlope]) + 1 : delta_xy );
+		autoINTVEC lowestRow = raw_INTVEC (nx), highestRow = raw_INTVEC (nx), psiOffset = raw_INTVEC (nx);
+		integer bandSize = 0, maximumHeight = 1;
+		for (integer ix = 1; ix <= nx; ix ++) {
+			if (ix == 1) {
+				lowestRow [ix] = 2;
+				highestRow [ix] = std::min (rowto, firstRowAbove [ix] - 1);
+			} else {
+				lowestRow [ix] = ( lastRowBelow [ix] > 0 ? lastRowBelow [ix] + 1 : ix <= colto ? 1 : 2 );
+				highestRow [ix] = firstRowAbove [ix] - 1;
+			}
+			const integer height = std::max (highestRow [ix] - lowestRow [ix] + 1, integer (0));
+			psiOffset [ix] = bandSize - lowestRow [ix] + 1;
+			bandSize += height;
+			maximumHeight = std::max (maximumHeight, height);
+		}
+		autovector <int8> psi = newvectorzero <int8> (bandSize);
+
+		const integer numberOfColumnsPerBlock = std::min (nx, std::max (integer (64), integer (65536) / maximumHeight));
+		const integer numberOfStoredColumns = numberOfColumnsPerBlock + 3;
+		autoMAT distances = zero_MAT (numberOfStoredColumns, maximumHeight);
+		autoMAT cumulativeDistances = zero_MAT (numberOfStoredColumns, maximumHeight);
+
+		auto isReachable = [&] (integer iy, integer ix) -> bool {
+			return iy >= lowestRow [ix] && iy <= highestRow [ix];
+		};
+		auto directionAt = [&] (integer iy, integer ix) -> integer {
+			return isReachable (iy, ix) ? psi [psiOffset [ix] + iy] : DTW_UNREACHABLE;
+		};
+		auto z = [&] (integer iy, integer ix) -> double& {
+			return distances [(ix - 1) % numberOfStoredColumns + 1] [iy - lowestRow [ix] + 1];
+		};
+		auto delta = [&] (integer iy, integer ix) -> double& {
+			return cumulativeDistances [(ix - 1) % numberOfStoredColumns + 1] [iy - lowestRow [ix] + 1];
+		};
+		auto getDistance = [&] (integer iy, integer ix) -> double {
+			double distance;
+			getDistances (ix, iy, VEC (& distance, 1));
+			return distance;
+		};
+
+		/*
+			The cumulative distances along the first row, as far as they can be reached.
+		*/
+		autoVEC firstRowCumulativeDistances;
+		if (localSlope != 1) {
+			firstRowCumulativeDistances = raw_VEC (std::min (colto, nx));
+			firstRowCumulativeDistances [1] = getDistance (1, 1);
+			for (integer ix = 2; ix <= firstRowCumulativeDistances.size; ix ++)
+				firstRowCumulativeDistances [ix] = firstRowCumulativeDistances [ix - 1] + getDistance (1, ix);
+		}
+
+		/*
+			Forward pass, block by block.
+		*/
+		integer numberOfIsolatedPoints = 0;
+		autoMelderProgress progress (U"Find path");
+		for (integer firstColumn = 1; firstColumn <= nx; firstColumn += numberOfColumnsPerBlock) {
+			const integer lastColumn = std::min (firstColumn + numberOfColumnsPerBlock - 1, nx);
+			integer numberOfCells = 0;
+			for (integer ix = firstColumn; ix <= lastColumn; ix ++)
+				numberOfCells += std::max (highestRow [ix] - lowestRow [ix] + 1, integer (0));
+			const integer numberOfThreads = std::min (lastColumn - firstColumn + 1,
+					MelderThread_getNumberOfThreadsForItems (numberOfCells, 2000));
+			MelderThread_runChunks (lastColumn - firstColumn + 1, numberOfThreads,
+				[&] (integer firstItem, integer lastItem, integer /* ithread */) {
+					for (integer ix = firstColumn - 1 + firstItem; ix <= firstColumn - 1 + lastItem; ix ++) {
+						const integer height = highestRow [ix] - lowestRow [ix] + 1;
+						if (height > 0)
+							getDistances (ix, lowestRow [ix], distances.row ((ix - 1) % numberOfStoredColumns + 1).part (1, height));
+					}
+				}
+			);
+
+			for (integer j = firstColumn; j <= lastColumn; j ++) {
+				for (integer i = lowestRow [j]; i <= highestRow [j]; i ++)
+					delta (i, j) = z (i, j);
+				if (j == 1) {
+					double cumulativeDistance = getDistance (1, 1);
+					for (integer iy = 2; iy <= highestRow [j]; iy ++) {
+						if (localSlope != 1) {
+							delta (iy, 1) = cumulativeDistance = cumulativeDistance + z (iy, 1);
+							psi [psiOffset [1] + iy] = DTW_Y;
+						} else {
+							psi [psiOffset [1] + iy] = DTW_START;
+						}
+					}
+					continue;
+				}
+				if (lowestRow [j] == 1 && highestRow [j] >= 1) {
+					if (localSlope != 1) {
+						delta (1, j) = firstRowCumulativeDistances [j];
+						psi [psiOffset [j] + 1] = DTW_X;
+					} else {
+						psi [psiOffset [j] + 1] = DTW_START;
+					}
+				}
+				for (integer i = std::max (lowestRow [j], integer (2)); i <= highestRow [j]; i ++) {
+					double g, gmin = DTW_BIG;
+					integer direction = 0;
+					if (isReachable (i - 1, j - 1)) {
+						gmin = delta (i - 1, j - 1) + 2.0 * z (i, j);
+						direction = DTW_XANDY;
+					} else if (isReachable (i, j - 1)) {
+						gmin = delta (i, j - 1) + z (i, j);
+						direction = DTW_X;
+					} else if (isReachable (i - 1, j)) {
+						gmin = delta (i - 1, j) + z (i, j);
+						direction = DTW_Y;
+					} else {
+						numberOfIsolatedPoints ++;
+						continue;
+					}
+
+					switch (localSlope) {
+					case 1: {   // no restriction
+						if (isReachable (i, j - 1) && ((g = delta (i, j - 1) + z (i, j)) < gmin)) {
+							gmin = g;
+							direction = DTW_X;
+						}
+						if (isReachable (i - 1, j) && ((g = delta (i - 1, j) + z (i, j)) < gmin)) {
+							gmin = g;
+							direction = DTW_Y;
+						}
+					}
+					break;
+					case 2: {   // P = 1/2
+						if (j >= 4 && isReachable (i - 1, j - 3) && directionAt (i, j - 1) == DTW_X && directionAt (i, j - 2) == DTW_XANDY &&
+							(g = delta (i - 1, j - 3) + 2.0 * z (i, j - 2) + z (i, j - 1) + z (i, j)) < gmin) {
+							gmin = g;
+							direction = DTW_X;
+						}
+						if (j >= 3 && isReachable (i - 1, j - 2) && directionAt (i, j - 1) == DTW_XANDY &&
+							(g = delta (i - 1, j - 2) + 2.0 * z (i, j - 1) + z (i, j)) < gmin) {
+							gmin = g;
+							direction = DTW_X;
+						}
+						if (i >= 3 && isReachable (i - 2, j - 1) && directionAt (i - 1, j) == DTW_XANDY &&
+							(g = delta (i - 2, j - 1) + 2.0 * z (i - 1, j) + z (i, j)) < gmin) {
+							gmin = g;
+							direction = DTW_Y;
+						}
+						if (i >= 4 && isReachable (i - 3, j - 1) && directionAt (i - 1, j) == DTW_Y && directionAt (i - 2, j) == DTW_XANDY &&
+							(g = delta (i - 3, j - 1) + 2.0 * z (i - 2, j) + z (i - 1, j) + z (i, j)) < gmin) {
+							gmin = g;
+							direction = DTW_Y;
+						}
+					}
+					break;
+					case 3: {   // P = 1
+						if (j >= 3 && isReachable (i - 1, j - 2) && directionAt (i, j - 1) == DTW_XANDY &&
+								(g = delta (i - 1, j - 2) + 2.0 * z (i, j - 1) + z (i, j)) < gmin)
+						{
+							gmin = g;
+							direction = DTW_X;
+						}
+						if (i >= 3 && isReachable (i - 2, j - 1) && directionAt (i - 1, j) == DTW_XANDY &&
+								(g = delta (i - 2, j - 1) + 2.0 * z (i - 1, j) + z (i, j)) < gmin)
+						{
+							gmin = g;
+							direction = DTW_Y;
+						}
+					}
+					break;
+					case 4: {   // P = 2
+						if (i >= 3 && j >= 4 && isReachable (i - 2, j - 3) && directionAt (i, j - 1) == DTW_XANDY && directionAt (i - 1, j - 2) == DTW_XANDY &&
+								(g = delta (i - 2, j - 3) + 2.0 * z (i - 1, j - 2) + 2.0 * z (i, j - 1) + z (i, j)) < gmin)
+						{
+							gmin = g;
+							direction = DTW_X;
+						}
+						if (i >= 4 && j >= 3 && isReachable (i - 3, j - 2) && directionAt (i - 1, j) == DTW_XANDY && directionAt (i - 2, j - 1) == DTW_XANDY &&
+								(g = delta (i - 3, j - 2) + 2.0 * z (i - 2, j - 1) + 2.0 * z (i - 1, j) + z (i, j)) < gmin)
+						{
+							gmin = g;
+							direction = DTW_Y;
+						}
+					}
+					break;
+					default:
+					break;
+					}
+					Melder_assert (direction != 0);
+					psi [psiOffset [j] + i] = (int8) direction;
+					delta (i, j) = gmin;
+				}
+			}
+			Melder_progress (0.999 * lastColumn / nx, U"Calculate time warp: frame ", lastColumn, U" from ", nx, U".");
+		}
+
+		/*
+			Find minimum at end of path and trace back.
+		*/
+		integer iy = ny;
+		double minimum = ( isReachable (ny, nx) ? delta (ny, nx) : getDistance (ny, nx) );
+		for (integer i = ny - 1; i > 0; i --) {
+			if (! isReachable (i, nx))
+				break;   // we're in unreachable places
+			else if (delta (i, nx) < minimum)
+				minimum = delta (iy = i, nx);
+		}
+
+		integer pathIndex = nx + ny - 1;   // maximum path length
+		my weightedDistance = minimum / (nx + ny);
+		my path [pathIndex]. y = iy;
+		integer ix = my path [pathIndex]. x = nx;
+		while (ix > 1) {
+			const integer direction = directionAt (iy, ix);
+			if (direction == DTW_XANDY) {
+				ix --;
+				iy --;
+			} else if (direction == DTW_X) {
+				ix --;
+			} else if (direction == DTW_Y) {
+				iy --;
+			} else if (direction == DTW_START) {
+				break;
+			}
+			if (pathIndex < 2 || iy < 1)
+				break;
+			my path [-- pathIndex]. x = ix;
+			my path [pathIndex]. y = iy;
+		}
+		my pathLength = nx + ny - 1 - pathIndex + 1;
+		if (pathIndex > 1)
+			for (integer j = 1; j <= my pathLength; j ++)
+				my path [j] = my path [pathIndex ++];
+		my path.resize (my pathLength);
+		DTW_Path_recode (me.get());
+
+		if (out_weightedDistance)
+			*out_weightedDistance = my weightedDistance;
+		return DTW_to_DurationTier (me.get());
+	} catch (MelderError) {
+		Melder_throw (U"Path in band not found.");
+	}
+}
+
+autoDurationTier Matrices_to_DurationTier_pathInBand (Matrix me, Matrix thee, double sakoeChibaBand, int slope, double metric) {
+	try {
+		Melder_require (thy ny == my ny,
+			U"Column sizes should be equal.");
+		/*
+			The feature vectors of every frame contiguous in memory.
+		*/
+		autoMAT myFrames = transpose_MAT (my z.get()), thyFrames = transpose_MAT (thy z.get());
+		return DTW_findPathInBand (me, thee,
+			[&] (integer ix, integer fromRow, VEC const& distances) {
+				for (integer k = 1; k <= distances.size; k ++)
+					distances [k] = getFrameDistance (myFrames.row (fromRow - 1 + k), thyFrames.row (ix), metric);
+			}, sakoeChibaBand, slope, nullptr
+		);
+	} catch (MelderError) {
+		Melder_throw (U"Path in band not found from matrices.");
+	}
+}
+
+autoDurationTier Spectrograms_to_DurationTier_pathInBand (Spectrogram me, Spectrogram thee, double sakoeChibaBand, int slope, double metric) {
+	try {
+		Melder_require (my xmin == thy xmin && my ymax == thy ymax && my ny == thy ny,
+			U"The number of frequencies and/or frequency ranges should be equal.");
+		autoMatrix m1 = Spectrogram_to_Matrix (me);
+		autoMatrix m2 = Spectrogram_to_Matrix (thee);
+		for (integer i = 1; i <= my ny; i ++) {
+			for (integer j = 1; j <= my nx; j ++)
+				m1 -> z [i] [j] = 10.0 * log10 (m1 -> z [i] [j]);
+		}
+		for (integer i = 1; i <= thy ny; i ++) {
+			for (integer j = 1; j <= thy nx; j ++)
+				m2 -> z [i] [j] = 10.0 * log10 (m2 -> z [i] [j]);
+		}
+		return Matrices_to_DurationTier_pathInBand (m1.get(), m2.get(), sakoeChibaBand, slope, metric);
+	} catch (MelderError) {
+		Melder_throw (U"Path in band not found from Spectrograms.");
+	}
+}
+
+autoDurationTier Pitches_to_DurationTier_pathInBand (Pitch me, Pitch thee, double vuv_costs, double time_weight, double sakoeChibaBand, int slope) {
+	try {
+		Melder_require (vuv_costs >= 0.0,
+			U"Voiced-unvoiced costs should not be negative.");
+		Melder_require (time_weight >= 0.0,
+			U"Time costs weight should not be negative.");
+		const kPitch_unit unit = kPitch_unit::SEMITONES_100;
+		autoVEC pitchy = raw_VEC (my nx), pitchx = raw_VEC (thy nx);
+		for (integer i = 1; i <= my nx; i ++)
+			pitchy [i] = Sampled_getValueAtSample (me, i, Pitch_LEVEL_FREQUENCY, (int) unit);
+		for (integer j = 1; j <= thy nx; j ++)
+			pitchx [j] = Sampled_getValueAtSample (thee, j, Pitch_LEVEL_FREQUENCY, (int) unit);
+		return DTW_findPathInBand (me, thee,
+			[&] (integer ix, integer fromRow, VEC const& distances) {
+				const double t2 = thy x1 + (ix - 1) * thy dx;
+				for (integer k = 1; k <= distances.size; k ++) {
+					const integer iy = fromRow - 1 + k;
+					const double t1 = my x1 + (iy - 1) * my dx;
+					distances [k] = getPitchDistance (pitchy [iy], pitchx [ix], t1, t2, vuv_costs, time_weight);
+				}
+			}, sakoeChibaBand, slope, nullptr
+		);
+	} catch (MelderError) {
+		Melder_throw (U"Path in band not found from Pitches.");
+	}
+}
+
 /* End of file DTW.cpp */
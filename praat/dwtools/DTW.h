@@ -119,7 +119,30 @@ autoDTW Spectrograms_to_DTW (Spectrogram me, Spectrogram thee, bool matchStart,
 
 autoDTW Pitches_to_DTW (Pitch me, Pitch thee, double vuv_costs, double time_weight, bool matchStart, bool matchEnd, int slope);
 
+using DTW_ColumnDistances = std::function <void (integer ix, integer fromRow, VEC const& distances)>;
+	/*
+		distances [k] := the distance between frame fromRow - 1 + k of the prototype (y) and frame ix of the test (x);
+		may be called from several threads at once.
+	*/
+
+autoDurationTier DTW_findPathInBand (Sampled prototype, Sampled test, DTW_ColumnDistances const& getDistances,
+	double sakoeChibaBand, int localSlope, double *out_weightedDistance);
+/*
+	Parselmouth: the path that DTW_findPath_bandAndSlope finds, as the DurationTier of DTW_to_DurationTier,
+	without creating the nx x ny distance matrix: the distances are computed in parallel when needed,
+	and only the band is stored.
+*/
+
+autoDurationTier Matrices_to_DurationTier_pathInBand (Matrix me, Matrix thee, double sakoeChibaBand, int slope, double metric);
+
+autoDurationTier Spectrograms_to_DurationTier_pathInBand (Spectrogram me, Spectrogram thee, double sakoeChibaBand, int slope, double metric);
+
+autoDurationTier Pitches_to_DurationTier_pathInBand (Pitch me, Pitch thee, double vuv_costs, double time_weight, double sakoeChibaBand, int slope);
+
 autoDurationTier DTW_to_DurationTier (DTW me);
+/*
+	Parselmouth: the relative durations (dy/dx) along the path; the y time at x is ymin plus the area under the tier from xmin to x.
+*/
 
 void DTW_Matrix_replace (DTW me, Matrix thee);
 
@@ -18,8 +18,8 @@
 
 #include "SampledToSampledWorkspace.h"
 #include "Sound_extensions.h"
-#include <thread>
 #include <atomic>
+#include "MelderThread.h"
 #include "NUM2.h"
 
 #include "oo_DESTROY.h"
@@ -97,73 +97,52 @@ void SampledToSampledWorkspace_replaceOutput (mutableSampledToSampledWorkspace m
 
 
 void SampledToSampledWorkspace_getThreadingInfo (constSampledToSampledWorkspace me, integer *out_numberOfThreads) {
-	const integer numberOfProcessors = std::thread::hardware_concurrency ();
 	/*
-		Our processes are compute bound, therefore it probably makes no sense to start more than two threads on one processor
+		Parselmouth: the number of threads is limited by the size of the process-wide thread pool
+		(see MelderThread_setNumberOfThreads), rather than by twice the number of processors.
 	*/
-	integer maximumNumberOfThreads = 2 * numberOfProcessors;
-	if (my maximumNumberOfThreads > 0)
-		 maximumNumberOfThreads = std::min (my maximumNumberOfThreads, maximumNumberOfThreads);
-	const integer numberOfFrames = my output -> nx;
-	integer numberOfThreads = 1 + (numberOfFrames - 1) / my minimumNumberOfFramesPerThread;
-	Melder_clip (1_integer, & numberOfThreads, maximumNumberOfThreads);
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsForItems (my output -> nx,
+			my minimumNumberOfFramesPerThread, my maximumNumberOfThreads);
 	if (out_numberOfThreads)
 		*out_numberOfThreads = numberOfThreads;
 }
 
+void SampledToSampledWorkspace_analyseFramesThreaded (mutableSampledToSampledWorkspace me, integer fromFrame, integer toFrame) {
+	Melder_assert (fromFrame >= 1 && toFrame <= my output -> nx);
+	const integer numberOfFrames = toFrame - fromFrame + 1;
+	if (my useMultiThreading) {
+		const integer numberOfThreads = MelderThread_getNumberOfThreadsForItems (numberOfFrames,
+				my minimumNumberOfFramesPerThread, my maximumNumberOfThreads);
+		/*
+			We have to reserve all the needed working memory for each thread beforehand;
+			each thread reuses its workspace for all the chunks of frames it analyses.
+		*/
+		OrderedOf<structSampledToSampledWorkspace> workspaces;
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			autoSampledToSampledWorkspace threadWorkspace = Data_copy (me);
+			workspaces.addItem_move (threadWorkspace.move());
+		}
+		std::atomic<integer> globalFrameErrorCount (0);
+		MelderThread_runChunks (numberOfFrames, numberOfThreads,
+			[&] (integer firstItem, integer lastItem, integer ithread) {
+				SampledToSampledWorkspace threadWorkspace = workspaces.at [ithread];
+				threadWorkspace -> inputFramesToOutputFrames (fromFrame - 1 + firstItem, fromFrame - 1 + lastItem);
+				globalFrameErrorCount += threadWorkspace -> globalFrameErrorCount;
+			}
+		);
+		my globalFrameErrorCount = globalFrameErrorCount;
+	} else {
+		my inputFramesToOutputFrames (fromFrame, toFrame); // no threading
+	}
+}
+
 void SampledToSampledWorkspace_analyseThreaded (mutableSampledToSampledWorkspace me)
 {
 	try {
 
 		my allocateOutputFrames ();
 
-		const integer numberOfFrames = my output -> nx;
-		
-		std::atomic<integer> globalFrameErrorCount (0);
-		
-		if (my useMultiThreading) {
-			integer numberOfThreads;
-			SampledToSampledWorkspace_getThreadingInfo (me, & numberOfThreads);
-			const integer numberOfFramesPerThread = my minimumNumberOfFramesPerThread;
-			/*
-				We have to reserve all the needed working memory for each thread beforehand.
-			*/
-			OrderedOf<structSampledToSampledWorkspace> workspaces;
-			for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
-				autoSampledToSampledWorkspace threadWorkspace = Data_copy (me);
-				workspaces.addItem_move (threadWorkspace.move());
-			}
-		
-			autovector<std::thread> threads = autovector<std::thread> (numberOfThreads, MelderArray::kInitializationType::ZERO);
-			
-			try {
-				for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
-					SampledToSampledWorkspace threadWorkspace = workspaces.at [ithread];
-					const integer firstFrame = 1 + (ithread - 1) * numberOfFramesPerThread;
-					const integer lastFrame = ( ithread == numberOfThreads ? numberOfFrames : firstFrame + numberOfFramesPerThread - 1 );
-					
-					auto analyseFrames = [&globalFrameErrorCount] (SampledToSampledWorkspace threadWorkspace, integer fromFrame, integer toFrame) {
-						threadWorkspace -> inputFramesToOutputFrames (fromFrame, toFrame);
-						globalFrameErrorCount += threadWorkspace -> globalFrameErrorCount;
-					};
-
-					threads [ithread] = std::thread (analyseFrames, threadWorkspace, firstFrame, lastFrame);
-				}
-				
-				for (integer ithread = 1; ithread <= numberOfThreads; ithread ++)
-					threads [ithread]. join ();
-				
-			} catch (MelderError) {
-				for (integer ithread = 1; ithread <= numberOfThreads; ithread ++)
-					if (threads [ithread]. joinable ())
-						threads [ithread]. join ();
-				Melder_clearError ();
-				throw;
-			}
-			my globalFrameErrorCount = globalFrameErrorCount;
-		} else {
-			my inputFramesToOutputFrames (1, numberOfFrames); // no threading
-		}
+		SampledToSampledWorkspace_analyseFramesThreaded (me, 1, my output -> nx);
 	} catch (MelderError) {
 		Melder_throw (me, U"The Sampled analysis could not be done.");
 	}
@@ -25,7 +25,7 @@
 
 void SampledToSampledWorkspace_init (mutableSampledToSampledWorkspace me, constSampled input, mutableSampled output);
 
-void SampledToSampledWorkspace_getThreadingInfo (constSampledToSampledWorkspace me, integer maximumNumberOfThreads, integer numberOfFramesPerThread, integer *out_numberOfThreads);
+void SampledToSampledWorkspace_getThreadingInfo (constSampledToSampledWorkspace me, integer *out_numberOfThreads);
 
 void SampledToSampledWorkspace_replaceOutput (mutableSampledToSampledWorkspace me, mutableSampled thee);
 /*
@@ -43,6 +43,12 @@ void SampledToSampledWorkspace_replaceInput (mutableSampledToSampledWorkspace me
 
 void SampledToSampledWorkspace_analyseThreaded (mutableSampledToSampledWorkspace me);
 
+void SampledToSampledWorkspace_analyseFramesThreaded (mutableSampledToSampledWorkspace me, integer fromFrame, integer toFrame);
+/*
+	Parselmouth: analyses only the frames fromFrame .. toFrame (e.g. those of one block of a LongSound),
+	without calling allocateOutputFrames (); SampledToSampledWorkspace_analyseThreaded does both for all frames.
+*/
+
 inline void Sampled_requireEqualSampling (constSampled me,  constSampled thee) {
 	Melder_assert (me && thee);
 	Melder_require (my x1 == thy x1 && my nx == thy nx && my dx == thy dx,
@@ -31,6 +31,7 @@
 #include "Sound_to_Pitch.h"
 #include "Vector.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 autoSound BandFilterSpectrogram_as_Sound (BandFilterSpectrogram me, int to_dB);
 
@@ -43,7 +44,7 @@ autoSound BandFilterSpectrogram_as_Sound (BandFilterSpectrogram me, int to_dB);
 	where erf(x) = 1 - erfc(x) and n is the windowLength in samples.
 	To compare with the rectangular window we need to divide this by the window width (n -1) x 1^2.
 */
-static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSamples_window) {
+static double getGaussianWindowPowerFactor (integer numberOfSamples_window) {
 	double windowFactor = 1.0;
 	if (numberOfSamples_window > 1) {
 		const double e12 = exp (-12);
@@ -54,7 +55,11 @@ static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSampl
 		const double p1 = 4 * NUMsqrtpi * NUMsqrt3 * e12 * (1 - NUMerfcc (arg1)) * (numberOfSamples_window + 1);
 		windowFactor =  (p2 - p1 + 24 * (numberOfSamples_window - 1) * e12 * e12) / denum;
 	}
-	my z.get()  /=  windowFactor;
+	return windowFactor;
+}
+
+static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSamples_window) {
+	my z.get()  /=  getGaussianWindowPowerFactor (numberOfSamples_window);
 }
 
 static autoSpectrum Sound_to_Spectrum_power (Sound me) {
@@ -160,81 +165,230 @@ autoBarkSpectrogram Sound_to_BarkSpectrogram (Sound me, double analysisWidth, do
 	}
 }
 
-static void Sound_into_MelSpectrogram_frame (Sound me, MelSpectrogram thee, integer frame) {
-	autoSpectrum him = Sound_to_Spectrum_power (me);
-
-	for (integer ifilter = 1; ifilter <= thy ny; ifilter ++) {
-		longdouble power = 0.0;
-		const double fc_mel = thy y1 + (ifilter - 1) * thy dy;
-		const double fc_hz = thy v_frequencyToHertz (fc_mel);
-		const double fl_hz = thy v_frequencyToHertz (std::max (fc_mel - thy dy, 0.0));
-		const double fh_hz =  thy v_frequencyToHertz (std::min (fc_mel + thy dy, his xmax));
-		integer ifrom, ito;
-		Sampled_getWindowSamples (him.get(), fl_hz, fh_hz, & ifrom, & ito);
-		for (integer i = ifrom; i <= ito; i ++) {
-			/*
-				Bin with a triangular filter the power (= amplitude-squared)
-			*/
-			const double f = his x1 + (i - 1) * his dx;
-			const double a = NUMtriangularfilter_amplitude (fl_hz, fc_hz, fh_hz, f);
-			power += a * his z [1] [i];
-		}
-		thy z [ifilter] [frame] = double (power);
+/*
+	Parselmouth: the number of filters and frames of the MelSpectrogram of SampledXY_to_MelSpectrogram,
+	after filling in the defaults of the frequency arguments.
+*/
+static void SampledXY_getMelSpectrogramGeometry (SampledXY me, double analysisWidth, double dt,
+	double *inout_f1_mel, double *inout_fmax_mel, double *inout_df_mel,
+	integer *out_numberOfFilters, integer *out_numberOfFrames, double *out_t1)
+{
+	const double samplingFrequency = 1.0 / my dx, nyquist = 0.5 * samplingFrequency;
+	const double windowDuration = 2.0 * analysisWidth;   // Gaussian window
+	const double fbottom = NUMhertzToMel2 (100.0), fceiling = NUMhertzToMel2 (nyquist);
+	double f1_mel = *inout_f1_mel, fmax_mel = *inout_fmax_mel, df_mel = *inout_df_mel;
+
+	// Check defaults.
+
+	if (fmax_mel <= 0.0 || fmax_mel > fceiling)
+		fmax_mel = fceiling;
+	if (fmax_mel <= f1_mel) {
+		f1_mel = fbottom;
+		fmax_mel = fceiling;
 	}
+	if (f1_mel <= 0.0)
+		f1_mel = fbottom;
+	if (df_mel <= 0.0)
+		df_mel = 100.0;
+
+	// Determine the number of filters.
+
+	*out_numberOfFilters = Melder_iround ((fmax_mel - f1_mel) / df_mel);
+	Sampled_shortTermAnalysis (me, windowDuration, dt, out_numberOfFrames, out_t1);
+	*inout_f1_mel = f1_mel;
+	*inout_fmax_mel = fmax_mel;
+	*inout_df_mel = df_mel;
 }
 
-autoMelSpectrogram Sound_to_MelSpectrogram (Sound me, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
-	try {
-		const double samplingFrequency = 1.0 / my dx, nyquist = 0.5 * samplingFrequency;
-		const double windowDuration = 2.0 * analysisWidth;   // Gaussian window
-		double fmin_mel = 0.0;
-		const double fbottom = NUMhertzToMel2 (100.0), fceiling = NUMhertzToMel2 (nyquist);
-
-		// Check defaults.
+/*
+	Parselmouth: the filter bank analysis shared by SampledXY_to_MelSpectrogram and SampledXY_to_MFCC.
+	'me' can be a Sound or a LongSound; the frames of a LongSound are analysed
+	in blocks of samples read from the file (see LongSound_analyseInBlocks).
+
+	Instead of creating a Sound and a Spectrum for every frame (see Sound_to_Spectrum_power),
+	and evaluating all triangular filter shapes for every frame (see Spectrum_into_MelSpectrogram_frame),
+	the filters are computed once, as a sparse matrix of weights over the frequency bins,
+	and the frames are analysed in parallel, each thread with its own buffers, in batches of melFramesPerBatch frames
+	that are transformed in one call (see NUMfft_forward with a matrix of frames in NUM2.h).
+	For every frame, analyseFrame receives the filter powers, already corrected for the window,
+	with exactly the values that the MelSpectrogram used to get.
+*/
+using MelFrameAnalysis = std::function <void (integer iframe, constVEC const& filterPowers, integer ithread)>;
 
-		if (fmax_mel <= 0.0 || fmax_mel > fceiling)
-			fmax_mel = fceiling;
-		if (fmax_mel <= f1_mel) {
-			f1_mel = fbottom;
-			fmax_mel = fceiling;
+static void SampledXY_analyseMelFilterbank (SampledXY me, constSampled frames, double analysisWidth,
+	double f1_mel, double df_mel, integer numberOfFilters, double blockDuration,
+	integer maximumNumberOfThreads, MelFrameAnalysis const& analyseFrame)
+{
+	const double samplingFrequency = 1.0 / my dx;
+	const double windowDuration = 2.0 * analysisWidth;   // Gaussian window
+	autoSound sframe = Sound_createSimple (1, windowDuration, samplingFrequency);
+	autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
+	const integer nsamp_window = sframe -> nx;
+	const integer nsampFFT = Melder_iroundUpToPowerOfTwo (nsamp_window);
+	autoSpectrum spectrum = Spectrum_create (0.5 / sframe -> dx, nsampFFT / 2 + 1);   // only for its frequency axis
+	spectrum -> dx = 1.0 / (sframe -> dx * nsampFFT);   // as in Sound_to_Spectrum
+	const integer numberOfFrequencies = spectrum -> nx;
+	const double scaling = sframe -> dx;
+	const double powerScale = 2.0 * spectrum -> dx / (sframe -> xmax - sframe -> xmin);
+	const double windowFactor = getGaussianWindowPowerFactor (window -> nx);
+
+	/*
+		The weights of filter i are filterWeights [firstWeights [i] .. firstWeights [i + 1] - 1],
+		for the frequency bins firstBins [i], firstBins [i] + 1, ...
+	*/
+	autoINTVEC firstBins = raw_INTVEC (numberOfFilters);
+	autoINTVEC firstWeights = raw_INTVEC (numberOfFilters + 1);
+	autoVEC fl_hz = raw_VEC (numberOfFilters), fc_hz = raw_VEC (numberOfFilters), fh_hz = raw_VEC (numberOfFilters);
+	firstWeights [1] = 1;
+	for (integer ifilter = 1; ifilter <= numberOfFilters; ifilter ++) {
+		const double fc_mel = f1_mel + (ifilter - 1) * df_mel;
+		fc_hz [ifilter] = NUMmelToHertz2 (fc_mel);
+		fl_hz [ifilter] = NUMmelToHertz2 (std::max (fc_mel - df_mel, 0.0));
+		fh_hz [ifilter] = NUMmelToHertz2 (std::min (fc_mel + df_mel, spectrum -> xmax));
+		integer ifrom, ito;
+		const integer numberOfBins = Sampled_getWindowSamples (spectrum.get(), fl_hz [ifilter], fh_hz [ifilter], & ifrom, & ito);
+		firstBins [ifilter] = ifrom;
+		firstWeights [ifilter + 1] = firstWeights [ifilter] + numberOfBins;
+	}
+	autoVEC filterWeights = raw_VEC (firstWeights [numberOfFilters + 1] - 1);
+	for (integer ifilter = 1; ifilter <= numberOfFilters; ifilter ++) {
+		for (integer iweight = firstWeights [ifilter]; iweight < firstWeights [ifilter + 1]; iweight ++) {
+			const integer i = firstBins [ifilter] + (iweight - firstWeights [ifilter]);
+			const double f = spectrum -> x1 + (i - 1) * spectrum -> dx;
+			filterWeights [iweight] = NUMtriangularfilter_amplitude (fl_hz [ifilter], fc_hz [ifilter], fh_hz [ifilter], f);
 		}
-		if (f1_mel <= 0.0)
-			f1_mel = fbottom;
-		if (df_mel <= 0.0)
-			df_mel = 100.0;
-
-		// Determine the number of filters.
-
-		const integer numberOfFilters = Melder_iround ((fmax_mel - f1_mel) / df_mel);
-
-
-		integer numberOfFrames;
-		double t1;
-		Sampled_shortTermAnalysis (me, windowDuration, dt, & numberOfFrames, & t1);
-		autoSound sframe = Sound_createSimple (1, windowDuration, samplingFrequency);
-		autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
-		autoMelSpectrogram thee = MelSpectrogram_create (my xmin, my xmax, numberOfFrames, dt, t1, fmin_mel, fmax_mel, numberOfFilters, df_mel, f1_mel);
+	}
 
-		autoMelderProgress progress (U"MelSpectrogram analysis");
+	constexpr integer melFramesPerBatch = 8;
+	autoNUMfft_Table fftTable;   // not modified by the batched transform, so shared by all threads
+	NUMfft_Table_init (& fftTable, nsampFFT);
+	autoMAT frameBuffers = raw_MAT (maximumNumberOfThreads * melFramesPerBatch, nsampFFT);
+	autoMAT powerBuffers = raw_MAT (maximumNumberOfThreads, numberOfFrequencies);
+	autoMAT filterBuffers = raw_MAT (maximumNumberOfThreads, numberOfFilters);
+
+	autoMelderProgress progress (U"MelSpectrogram analysis");
+
+	Sampled_analyseSoundInBlocks (me, frames, 0.5 * windowDuration + my dx, blockDuration,
+		[&] (Sound sound, integer sampleOffset, integer firstFrameOfSound, integer lastFrameOfSound) {
+			const integer numberOfThreads = std::min (maximumNumberOfThreads,
+					MelderThread_getNumberOfThreadsForItems (lastFrameOfSound - firstFrameOfSound + 1, 20));
+			MelderThread_runChunks (lastFrameOfSound - firstFrameOfSound + 1, numberOfThreads,
+				[&] (integer firstItem, integer lastItem, integer ithread) {
+					const MATVU batch = frameBuffers.horizontalBand ((ithread - 1) * melFramesPerBatch + 1, ithread * melFramesPerBatch);
+					const VEC pow = powerBuffers.row (ithread), filterPowers = filterBuffers.row (ithread);
+					for (integer firstFrame = firstFrameOfSound - 1 + firstItem; firstFrame <= firstFrameOfSound - 1 + lastItem; firstFrame += melFramesPerBatch) {
+						const integer numberOfFramesInBatch = std::min (melFramesPerBatch, firstFrameOfSound - 1 + lastItem - firstFrame + 1);
+						for (integer ibatch = 1; ibatch <= numberOfFramesInBatch; ibatch ++) {
+							const double t = Sampled_indexToX (frames, firstFrame - 1 + ibatch);
+							const integer index = Sampled_xToNearestIndex (me, t - windowDuration / 2.0);   // as in Sound_into_Sound
+							const VECVU data = batch.row (ibatch);
+							for (integer i = 1; i <= nsamp_window; i ++) {
+								const integer j = index - 1 + i;
+								data [i] = ( j < 1 || j > my nx ? 0.0 : sound -> z [1] [j - sampleOffset] ) * window -> z [1] [i];
+							}
+							data.part (nsamp_window + 1, nsampFFT)  <<=  0.0;
+						}
+						NUMfft_forward (& fftTable, frameBuffers.horizontalBand ((ithread - 1) * melFramesPerBatch + 1,
+								(ithread - 1) * melFramesPerBatch + numberOfFramesInBatch));
+
+						for (integer ibatch = 1; ibatch <= numberOfFramesInBatch; ibatch ++) {
+							const integer iframe = firstFrame - 1 + ibatch;
+							const constVECVU data = batch.row (ibatch);
+							for (integer i = 1; i <= numberOfFrequencies; i ++) {
+								const double re = ( i == 1 ? data [1] : i == numberOfFrequencies ? data [nsampFFT] : data [i + i - 2] ) * scaling;
+								const double im = ( i == 1 || i == numberOfFrequencies ? 0.0 : data [i + i - 1] * scaling );
+								pow [i] = powerScale * (re * re + im * im);
+							}
+							pow [1] *= 0.5;   // frequency bins at 0 Hz and Nyquist don't count for two
+							pow [numberOfFrequencies] *= 0.5;
+
+							for (integer ifilter = 1; ifilter <= numberOfFilters; ifilter ++) {
+								/*
+									Bin with a triangular filter the power (= amplitude-squared)
+								*/
+								longdouble power = 0.0;
+								const integer offset = firstBins [ifilter] - firstWeights [ifilter];
+								for (integer iweight = firstWeights [ifilter]; iweight < firstWeights [ifilter + 1]; iweight ++)
+									power += filterWeights [iweight] * pow [offset + iweight];
+								filterPowers [ifilter] = double (power) / windowFactor;
+							}
+							analyseFrame (iframe, filterPowers, ithread);
+
+							if (ithread == 1 && iframe % 10 == 1)
+								Melder_progress ((double) iframe / frames -> nx, U"Frame ", iframe, U" out of ", frames -> nx, U".");
+						}
+					}
+				}
+			);
+		}
+	);
+}
 
-		for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
-			const double t = Sampled_indexToX (thee.get(), iframe);
-			Sound_into_Sound (me, sframe.get(), t - windowDuration / 2.0);
-			Sounds_multiply (sframe.get(), window.get());
-			Sound_into_MelSpectrogram_frame (sframe.get(), thee.get(), iframe);
-			
-			if (iframe % 10 == 1)
-				Melder_progress ((double) iframe / numberOfFrames, U"Frame ", iframe, U" out of ", numberOfFrames, U".");
+static autoMelSpectrogram SampledXY_to_MelSpectrogram (SampledXY me, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel, double blockDuration) {
+	const double fmin_mel = 0.0;
+	integer numberOfFilters, numberOfFrames;
+	double t1;
+	SampledXY_getMelSpectrogramGeometry (me, analysisWidth, dt, & f1_mel, & fmax_mel, & df_mel, & numberOfFilters, & numberOfFrames, & t1);
+	autoMelSpectrogram thee = MelSpectrogram_create (my xmin, my xmax, numberOfFrames, dt, t1, fmin_mel, fmax_mel, numberOfFilters, df_mel, f1_mel);
+	SampledXY_analyseMelFilterbank (me, thee.get(), analysisWidth, f1_mel, df_mel, numberOfFilters, blockDuration,
+		MelderThread_getNumberOfThreadsForItems (numberOfFrames, 20),
+		[&] (integer iframe, constVEC const& filterPowers, integer /* ithread */) {
+			for (integer ifilter = 1; ifilter <= numberOfFilters; ifilter ++)
+				thy z [ifilter] [iframe] = filterPowers [ifilter];
 		}
-		
-		_Spectrogram_windowCorrection ((Spectrogram) thee.get(), window -> nx);
+	);
+	return thee;
+}
 
-		return thee;
+autoMelSpectrogram Sound_to_MelSpectrogram (Sound me, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
+	try {
+		return SampledXY_to_MelSpectrogram (me, analysisWidth, dt, f1_mel, fmax_mel, df_mel, 0.0);
+	} catch (MelderError) {
+		Melder_throw (me, U": No MelSpectrogram created.");
+	}
+}
+
+autoMelSpectrogram LongSound_to_MelSpectrogram (LongSound me, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel, double blockDuration) {
+	try {
+		return SampledXY_to_MelSpectrogram (me, analysisWidth, dt, f1_mel, fmax_mel, df_mel, blockDuration);
 	} catch (MelderError) {
 		Melder_throw (me, U": No MelSpectrogram created.");
 	}
 }
 
+autoMFCC SampledXY_to_MFCC (SampledXY me, integer numberOfCoefficients, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel, double blockDuration) {
+	const double fmin_mel = 0.0;
+	integer numberOfFilters, numberOfFrames;
+	double t1;
+	SampledXY_getMelSpectrogramGeometry (me, analysisWidth, dt, & f1_mel, & fmax_mel, & df_mel, & numberOfFilters, & numberOfFrames, & t1);
+	/*
+		As in MelSpectrogram_to_MFCC and BandFilterSpectrogram_into_CC.
+	*/
+	if (numberOfCoefficients <= 0 || numberOfCoefficients > numberOfFilters - 1)
+		numberOfCoefficients = numberOfFilters - 1;
+	autoMFCC thee = MFCC_create (my xmin, my xmax, numberOfFrames, dt, t1, numberOfFilters - 1, fmin_mel, fmax_mel);
+	Melder_assert (numberOfCoefficients > 0);
+	for (integer iframe = 1; iframe <= numberOfFrames; iframe ++)
+		CC_Frame_init (& thy frame [iframe], numberOfCoefficients);
+	autoMAT cosinesTable = MATcosinesTable (numberOfFilters);
+	const integer maximumNumberOfThreads = MelderThread_getNumberOfThreadsForItems (numberOfFrames, 20);
+	autoMAT levelBuffers = raw_MAT (maximumNumberOfThreads, numberOfFilters);
+	SampledXY_analyseMelFilterbank (me, thee.get(), analysisWidth, f1_mel, df_mel, numberOfFilters, blockDuration,
+		maximumNumberOfThreads,
+		[&] (integer iframe, constVEC const& filterPowers, integer ithread) {
+			const VEC levels = levelBuffers.row (ithread);
+			for (integer ifilter = 1; ifilter <= numberOfFilters; ifilter ++)
+				levels [ifilter] = ( filterPowers [ifilter] > 0.0 ?
+						10.0 * log10 (filterPowers [ifilter] / 4e-10) : -300.0 );   // dB, as in BandFilterSpectrogram::v_getValueAtSample
+			const CC_Frame ccframe = & thy frame [iframe];
+			ccframe -> c0 = NUMinner (levels, cosinesTable.row (1));
+			for (integer i = 1; i <= numberOfCoefficients; i ++)
+				ccframe -> c [i] = NUMinner (levels, cosinesTable.row (i + 1));
+		}
+	);
+	return thee;
+}
+
 /*
 	Analog formant filter response :
 	H(f) = i f B / (f1^2 - f^2 + i f B)
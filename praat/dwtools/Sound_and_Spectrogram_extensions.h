@@ -24,7 +24,7 @@
 
 #include "Spectrogram_extensions.h"
 #include "Pitch.h"
-#include "Sound.h"
+#include "LongSound.h"
 
 autoBarkSpectrogram Sound_to_BarkSpectrogram (Sound me, double analysisWidth, double dt,
 	double f1_bark, double fmax_bark, double df_bark);
@@ -40,6 +40,21 @@ autoBarkSpectrogram Sound_to_BarkSpectrogram (Sound me, double analysisWidth, do
 autoMelSpectrogram Sound_to_MelSpectrogram (Sound me, double analysisWidth, double dt,
 	double f1_mel, double fmax_mel, double df_mel);
 
+autoMelSpectrogram LongSound_to_MelSpectrogram (LongSound me, double analysisWidth, double dt,
+	double f1_mel, double fmax_mel, double df_mel, double blockDuration);
+/*
+	Parselmouth: the same analysis, reading blocks of about 'blockDuration' seconds of frames from the file;
+	the result is identical to that of Sound_to_MelSpectrogram on the whole file.
+*/
+
+autoMFCC SampledXY_to_MFCC (SampledXY me, integer numberOfCoefficients, double analysisWidth, double dt,
+	double f1_mel, double fmax_mel, double df_mel, double blockDuration);
+/*
+	Parselmouth: Sound_to_MelSpectrogram (or LongSound_to_MelSpectrogram) followed by MelSpectrogram_to_MFCC,
+	in a single pass over the frames, without storing the MelSpectrogram; 'me' is a Sound or a LongSound,
+	and blockDuration is only used for a LongSound. The result is identical.
+*/
+
 autoSpectrogram Sound_to_Spectrogram_pitchDependent (Sound me, double analysisWidth,
 	double dt, double f1_hz, double fmax_hz, double df_hz, double relative_bw,
 	double pitchFloor, double pitchCeiling);
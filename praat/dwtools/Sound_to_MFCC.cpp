@@ -26,9 +26,15 @@
 
 autoMFCC Sound_to_MFCC (Sound me, integer numberOfCoefficients, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
 	try {
-		autoMelSpectrogram mf = Sound_to_MelSpectrogram (me, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
-		autoMFCC mfcc = MelSpectrogram_to_MFCC (mf.get(), numberOfCoefficients);
-		return mfcc;
+		return SampledXY_to_MFCC (me, numberOfCoefficients, analysisWidth, dt, f1_mel, fmax_mel, df_mel, 0.0);   // Parselmouth: without storing the MelSpectrogram
+	} catch (MelderError) {
+		Melder_throw (me, U": no MFCC created.");
+	}
+}
+
+autoMFCC LongSound_to_MFCC (LongSound me, integer numberOfCoefficients, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel, double blockDuration) {
+	try {
+		return SampledXY_to_MFCC (me, numberOfCoefficients, analysisWidth, dt, f1_mel, fmax_mel, df_mel, blockDuration);   // Parselmouth: without storing the MelSpectrogram
 	} catch (MelderError) {
 		Melder_throw (me, U": no MFCC created.");
 	}
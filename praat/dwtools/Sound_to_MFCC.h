@@ -25,9 +25,12 @@
 */
 
 #include "MFCC.h"
-#include "Sound.h"
+#include "LongSound.h"
 
 autoMFCC Sound_to_MFCC (Sound me, integer numberOfCoefficients, double analysisWidth,
 	double dt, double f1_mel, double fmax_mel, double df_mel);
 
+autoMFCC LongSound_to_MFCC (LongSound me, integer numberOfCoefficients, double analysisWidth,
+	double dt, double f1_mel, double fmax_mel, double df_mel, double blockDuration);
+
 #endif /* _Sound_to_MFCC_h_ */
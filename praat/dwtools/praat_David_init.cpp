@@ -484,6 +484,28 @@ DO
 	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get());
 }
 
+FORM (CONVERT_TWO_TO_ONE__CCs_to_DurationTier_pathInBand, U"CC: To DurationTier (DTW path in band)", nullptr) {
+	COMMENT (U"Distance  between cepstral coefficients")
+	REAL (cepstralWeight, U"Cepstral weight", U"1.0")
+	REAL (logEnergyWeight, U"Log energy weight", U"0.0")
+	REAL (regressionWeight, U"Regression weight", U"0.0")
+	REAL (regressionLogEnergyWeight, U"Regression log energy weight", U"0.0")
+	REAL (regressionWindowLength, U"Regression window length (s)", U"0.056")
+	REAL (sakoeChibaBand, U"Sakoe-Chiba band (s)", U"0.1")
+	CHOICE (slopeConstraint, U"Slope constraint", 1)
+		OPTION (U"no restriction")
+		OPTION (U"1/3 < slope < 3")
+		OPTION (U"1/2 < slope < 2")
+		OPTION (U"2/3 < slope < 3/2")
+	OK
+DO
+	CONVERT_TWO_TO_ONE (CC)
+		autoDurationTier result = CCs_to_DurationTier_pathInBand (me, you, cepstralWeight, logEnergyWeight, regressionWeight,
+			regressionLogEnergyWeight, regressionWindowLength, sakoeChibaBand, slopeConstraint
+		);
+	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get());
+}
+
 DIRECT (CONVERT_EACH_TO_ONE__CC_to_Matrix) {
 	CONVERT_EACH_TO_ONE (CC)
 		autoMatrix result = CC_to_Matrix (me);
@@ -4875,6 +4897,22 @@ DO
 	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get())
 }
 
+FORM (CONVERT_TWO_TO_ONE__Pitches_to_DurationTier_pathInBand, U"Pitches: To DurationTier (DTW path in band)", nullptr) {
+	REAL (vuvCosts, U"Voiced-unvoiced costs", U"24.0")
+	REAL (weight, U"Time costs weight", U"10.0")
+	REAL (sakoeChibaBand, U"Sakoe-Chiba band (s)", U"0.1")
+	CHOICE (slopeConstraint, U"Slope constraint", 1)
+		OPTION (U"no restriction")
+		OPTION (U"1/3 < slope < 3")
+		OPTION (U"1/2 < slope < 2")
+		OPTION (U"2/3 < slope < 3/2")
+	OK
+DO
+	CONVERT_TWO_TO_ONE (Pitch)
+		autoDurationTier result = Pitches_to_DurationTier_pathInBand (me, you, vuvCosts, weight, sakoeChibaBand, slopeConstraint);
+	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get())
+}
+
 FORM (CONVERT_EACH_TO_ONE__PitchTier_to_Pitch, U"PitchTier: To Pitch", U"PitchTier: To Pitch...") {
 	POSITIVE (stepSize, U"Step size", U"0.02")
 	POSITIVE (pitchFloor, U"Pitch floor (Hz)", U"60.0")
@@ -6167,6 +6205,20 @@ DO
 	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get())
 }
 
+FORM (CONVERT_TWO_TO_ONE__Spectrograms_to_DurationTier_pathInBand, U"Spectrograms: To DurationTier (DTW path in band)", nullptr) {
+	REAL (sakoeChibaBand, U"Sakoe-Chiba band (s)", U"0.1")
+	CHOICE (slopeConstraint, U"Slope constraint", 1)
+		OPTION (U"no restriction")
+		OPTION (U"1/3 < slope < 3")
+		OPTION (U"1/2 < slope < 2")
+		OPTION (U"2/3 < slope < 3/2")
+	OK
+DO
+	CONVERT_TWO_TO_ONE (Spectrogram)
+		autoDurationTier result = Spectrograms_to_DurationTier_pathInBand (me, you, sakoeChibaBand, slopeConstraint, 1.0);
+	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get())
+}
+
 FORM (GRAPHICS_EACH__Spectrogram_drawLongtermSpectralFlatness, U"Spectrogram: Draw long-term spectral flatness", U"") {
 //double tmin, double tmax, double minimumFlatness_db,
 //	double longtermWindow, double shorttermWindow, double fmin, double fmax, bool garnish
@@ -8709,6 +8761,8 @@ void praat_CC_init (ClassInfo klas) {
 			CONVERT_EACH_TO_ONE__CC_to_Matrix);
 	praat_addAction1 (klas, 2, U"To DTW...", nullptr, 0, 
 			CONVERT_TWO_TO_ONE__CCs_to_DTW);
+	praat_addAction1 (klas, 2, U"To DurationTier (DTW path in band)...", nullptr, 0,
+			CONVERT_TWO_TO_ONE__CCs_to_DurationTier_pathInBand);
 }
 
 static void praat_Eigen_Matrix_project (ClassInfo klase, ClassInfo klasm); // deprecated 2014
@@ -10101,6 +10155,8 @@ void praat_David_init () {
 
 	praat_addAction1 (classPitch, 2, U"To DTW...", U"To PointProcess",
 			GuiMenu_HIDDEN, CONVERT_TWO_TO_ONE__Pitches_to_DTW);
+	praat_addAction1 (classPitch, 2, U"To DurationTier (DTW path in band)...", U"To DTW...",
+			GuiMenu_HIDDEN, CONVERT_TWO_TO_ONE__Pitches_to_DurationTier_pathInBand);
 
 	praat_addAction1 (classPitchTier, 0, U"To Pitch...",
 			U"To Sound (sine)...", 1, CONVERT_EACH_TO_ONE__PitchTier_to_Pitch);
@@ -10291,6 +10347,8 @@ void praat_David_init () {
 
 	praat_addAction1 (classSpectrogram, 2, U"To DTW...", U"To Spectrum (slice)...", 1, 
 			CONVERT_TWO_TO_ONE__Spectrograms_to_DTW);
+	praat_addAction1 (classSpectrogram, 2, U"To DurationTier (DTW path in band)...", U"To DTW...", 1,
+			CONVERT_TWO_TO_ONE__Spectrograms_to_DurationTier_pathInBand);
 	praat_addAction1 (classSpectrogram, 0, U"Draw long-term spectral flatness...", U"Paint...", GuiMenu_HIDDEN | GuiMenu_DEPTH_1,
 			GRAPHICS_EACH__Spectrogram_drawLongtermSpectralFlatness);
 	praat_addAction1 (classSpectrogram, 0, U"Get long-term spectral flatness...", U"To DTW...", GuiMenu_HIDDEN | GuiMenu_DEPTH_1,
@@ -275,9 +275,13 @@ autoLongSound LongSound_open (MelderFile file) {
 	}
 }
 
+/*
+	Parselmouth: the _process functions decode numberOfSamples samples, starting at the 1-based sample number firstSample,
+	like _LongSound_FILE_seekSample; the decoders themselves seek to 0-based sample numbers.
+*/
 static void _LongSound_FLAC_process (LongSound me, const integer firstSample, const integer numberOfSamples) {
-	my compressedSamplesLeft = numberOfSamples - 1;
-	if (! FLAC__stream_decoder_seek_absolute (my flacDecoder, firstSample))
+	my compressedSamplesLeft = numberOfSamples;
+	if (! FLAC__stream_decoder_seek_absolute (my flacDecoder, firstSample - 1))
 		Melder_throw (U"Cannot seek in FLAC file ", & my file, U".");
 	while (my compressedSamplesLeft > 0) {
 		if (FLAC__stream_decoder_get_state (my flacDecoder) == FLAC__STREAM_DECODER_END_OF_STREAM)
@@ -294,12 +298,12 @@ static void _LongSound_FILE_seekSample (LongSound me, const integer firstSample)
 
 static void _LongSound_FLAC_readAudioToShort (LongSound me, int16 *buffer, const integer firstSample, const integer numberOfSamples) {
 	my compressedMode = COMPRESSED_MODE_READ_SHORT;
-	my compressedShorts = buffer + 1;
+	my compressedShorts = buffer;   // Parselmouth: base-0, like Melder_readAudioToShort
 	_LongSound_FLAC_process (me, firstSample, numberOfSamples);
 }
 
 static void _LongSound_MP3_process (LongSound me, const integer firstSample, const integer numberOfSamples) {
-	if (! mp3f_seek (my mp3f, firstSample))
+	if (! mp3f_seek (my mp3f, firstSample - 1))
 		Melder_throw (U"Cannot seek in MP3 file ", & my file, U".");
 	my compressedSamplesLeft = numberOfSamples;
 	if (! mp3f_read (my mp3f, numberOfSamples))
@@ -308,8 +312,8 @@ static void _LongSound_MP3_process (LongSound me, const integer firstSample, con
 
 static void _LongSound_MP3_readAudioToShort (LongSound me, int16 *buffer, const integer firstSample, const integer numberOfSamples) {
 	my compressedMode = COMPRESSED_MODE_READ_SHORT;
-	my compressedShorts = buffer + 1;
-	_LongSound_MP3_process (me, firstSample, numberOfSamples - 1);
+	my compressedShorts = buffer;   // Parselmouth: base-0, like Melder_readAudioToShort
+	_LongSound_MP3_process (me, firstSample, numberOfSamples);
 }
 
 void LongSound_readAudioToFloat (LongSound me, const MAT buffer, const integer firstSample) {
@@ -368,6 +372,31 @@ autoSound LongSound_extractPart (LongSound me, double tmin, double tmax, const b
 	}
 }
 
+void LongSound_analyseInBlocks (LongSound me, constSampled frames, double margin, double blockDuration, SoundBlockAnalysis const& analyseBlock) {
+	const integer framesPerBlock = std::max (1_integer, Melder_ifloor (blockDuration / frames -> dx));
+	const integer marginSamples = Melder_iceiling (margin / my dx) + 1;   // one extra against rounding
+	for (integer firstFrame = 1; firstFrame <= frames -> nx; firstFrame += framesPerBlock) {
+		const integer lastFrame = std::min (firstFrame + framesPerBlock - 1, frames -> nx);
+		const integer firstSample = std::max (1_integer, Sampled_xToLowIndex (me, Sampled_indexToX (frames, firstFrame)) - marginSamples);
+		const integer lastSample = std::min (my nx, Sampled_xToHighIndex (me, Sampled_indexToX (frames, lastFrame)) + marginSamples);
+		const integer numberOfSamples = lastSample - firstSample + 1;
+		const double x1 = Sampled_indexToX (me, firstSample);
+		autoSound block = Sound_create (my numberOfChannels, x1 - 0.5 * my dx, x1 + (numberOfSamples - 0.5) * my dx,
+				numberOfSamples, my dx, x1);
+		LongSound_readAudioToFloat (me, block -> z.get(), firstSample);
+		analyseBlock (block.get(), firstSample - 1, firstFrame, lastFrame);
+	}
+}
+
+void Sampled_analyseSoundInBlocks (Sampled me, constSampled frames, double margin, double blockDuration, SoundBlockAnalysis const& analyseBlock) {
+	if (Thing_isa (me, classLongSound)) {
+		LongSound_analyseInBlocks (static_cast <LongSound> (me), frames, margin, blockDuration, analyseBlock);
+	} else {
+		Melder_assert (Thing_isa (me, classSound));
+		analyseBlock (static_cast <Sound> (me), 0, 1, frames -> nx);
+	}
+}
+
 static void _LongSound_readSamples (LongSound me, int16 *buffer, const integer imin, const integer imax) {
 	LongSound_readAudioToShort (me, buffer, imin, imax - imin + 1);
 }
@@ -21,6 +21,8 @@
 #include "Sound.h"
 #include "Collection.h"
 
+#include <functional>
+
 #define COMPRESSED_MODE_READ_FLOAT 0
 #define COMPRESSED_MODE_READ_SHORT 1
 
@@ -80,6 +82,22 @@ void LongSound_saveChannelAsAudioFile (LongSound me, int audioFileType, integer
 void LongSound_readAudioToFloat (LongSound me, MAT buffer, integer firstSample);
 void LongSound_readAudioToShort (LongSound me, int16 *buffer, integer firstSample, integer numberOfSamples);
 
+/*
+	Parselmouth: analysis of long sound files in blocks, with a bounded amount of memory.
+
+	LongSound_analyseInBlocks reads the samples that the frames of 'frames' (a Sampled in the time domain of 'me') need,
+	for about 'blockDuration' seconds of frames at a time, plus 'margin' seconds of samples on either side,
+	and calls analyseBlock (block, sampleOffset, firstFrame, lastFrame) for every block of frames.
+	'block' contains the samples sampleOffset + 1 .. sampleOffset + block -> nx of the file, at their times in the file;
+	analyses should compute sample numbers in 'me' (not in 'block'), and subtract sampleOffset,
+	such that the frames are analysed exactly as they would be in a Sound read from the whole file.
+
+	Sampled_analyseSoundInBlocks does the same if 'me' is a LongSound, and calls analyseBlock (me, 0, 1, frames -> nx) if 'me' is a Sound.
+*/
+using SoundBlockAnalysis = std::function <void (Sound block, integer sampleOffset, integer firstFrame, integer lastFrame)>;
+void LongSound_analyseInBlocks (LongSound me, constSampled frames, double margin, double blockDuration, SoundBlockAnalysis const& analyseBlock);
+void Sampled_analyseSoundInBlocks (Sampled me, constSampled frames, double margin, double blockDuration, SoundBlockAnalysis const& analyseBlock);
+
 Collection_define (SoundAndLongSoundList, OrderedOf, SampledXY) {
 };
 
@@ -547,16 +547,26 @@ void Pitch_pathFinder (Pitch me, double silenceThreshold, double voicingThreshol
 		my ceiling = ceiling;
 		autoMAT delta = zero_MAT (my nx, maxnCandidates);
 		autoINTMAT psi = zero_INTMAT (my nx, maxnCandidates);
+		/*
+			Parselmouth: gather the candidates' frequencies and voicing into contiguous matrices once,
+			such that the search below does not have to follow every frame's candidate vector
+			(or test the voicing of every candidate) for each pair of candidates.
+		*/
+		autoMAT frequencies = zero_MAT (my nx, maxnCandidates);
+		automatrix <bool> voiceless = newmatrixzero <bool> (my nx, maxnCandidates);
+		autoINTVEC numberOfCandidates = raw_INTVEC (my nx);
 
 		for (integer iframe = 1; iframe <= my nx; iframe ++) {
 			const Pitch_Frame frame = & my frames [iframe];
 			double unvoicedStrength = ( silenceThreshold <= 0 ? 0.0 :
 				2.0 - frame -> intensity / (silenceThreshold / (1.0 + voicingThreshold)) );
 			unvoicedStrength = voicingThreshold + std::max (0.0, unvoicedStrength);
+			numberOfCandidates [iframe] = frame -> nCandidates;
 			for (integer icand = 1; icand <= frame -> nCandidates; icand ++) {
 				const Pitch_Candidate candidate = & frame -> candidates [icand];
-				const bool voiceless = ! Pitch_util_frequencyIsVoiced (candidate -> frequency, ceiling2);
-				delta [iframe] [icand] = ( voiceless ? unvoicedStrength :
+				frequencies [iframe] [icand] = candidate -> frequency;
+				voiceless [iframe] [icand] = ! Pitch_util_frequencyIsVoiced (candidate -> frequency, ceiling2);
+				delta [iframe] [icand] = ( voiceless [iframe] [icand] ? unvoicedStrength :
 					candidate -> strength - octaveCost * NUMlog2 (ceiling / candidate -> frequency) );
 			}
 		}
@@ -566,19 +576,20 @@ void Pitch_pathFinder (Pitch me, double silenceThreshold, double voicingThreshol
 		/* and a cost for a frequency jump. */
 
 		for (integer iframe = 2; iframe <= my nx; iframe ++) {
-			const Pitch_Frame prevFrame = & my frames [iframe - 1], curFrame = & my frames [iframe];
+			const constVEC prevFrequencies = frequencies [iframe - 1], curFrequencies = frequencies [iframe];
+			const constvector <bool> prevVoiceless = voiceless [iframe - 1], curVoiceless = voiceless [iframe];
 			const constVEC prevDelta = delta [iframe - 1];
 			const VEC curDelta = delta [iframe];
 			const INTVEC curPsi = psi [iframe];
-			for (integer icand2 = 1; icand2 <= curFrame -> nCandidates; icand2 ++) {
-				const double f2 = curFrame -> candidates [icand2]. frequency;
+			for (integer icand2 = 1; icand2 <= numberOfCandidates [iframe]; icand2 ++) {
+				const double f2 = curFrequencies [icand2];
+				const bool currentVoiceless = curVoiceless [icand2];
 				maximum = -1e30;
 				place = 0;
-				for (integer icand1 = 1; icand1 <= prevFrame -> nCandidates; icand1 ++) {
-					double f1 = prevFrame -> candidates [icand1]. frequency;
+				for (integer icand1 = 1; icand1 <= numberOfCandidates [iframe - 1]; icand1 ++) {
+					double f1 = prevFrequencies [icand1];
 					double transitionCost;
-					const bool previousVoiceless = ! Pitch_util_frequencyIsVoiced (f1, ceiling2);
-					const bool currentVoiceless = ! Pitch_util_frequencyIsVoiced (f2, ceiling2);
+					const bool previousVoiceless = prevVoiceless [icand1];
 					if (currentVoiceless) {
 						if (previousVoiceless) {
 							transitionCost = 0.0;   // both voiceless
@@ -25,6 +25,7 @@
 #include "Sound.h"
 #include "Sound_extensions.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 #include "enums_getText.h"
 #include "Sound_enums.h"
@@ -456,6 +457,126 @@ autoSound Sound_resample (constSound me, double samplingFrequency, integer preci
 	}
 }
 
+/*
+	Parselmouth: polyphase resampling.
+	Every output sample is the inner product of a window of input samples with a Hann-windowed sinc lowpass filter,
+	whose cutoff is the lower of the two Nyquist frequencies, and which has 'precision' zero crossings on either side.
+	For rational ratios (e.g. 48 kHz to 16 kHz, or 44.1 kHz to 16 kHz) the output positions cycle through only a limited number
+	of fractional positions relative to the input samples, so all filters can be computed beforehand;
+	for other ratios a finely sampled table of filters is interpolated linearly.
+	Either way, no sines are computed per output sample and no memory is needed in proportion to the duration of the sound,
+	and the output samples are computed in chunks on multiple threads.
+*/
+static void computePolyphaseFilter (VEC const& taps, double fraction, double cutoff, double halfWidth) {
+	const integer halfNumberOfTaps = taps.size / 2;
+	longdouble sum = 0.0;
+	for (integer itap = 1; itap <= taps.size; itap ++) {
+		const double distance = fraction + halfNumberOfTaps - itap;   // from the input sample to the output position, in input samples
+		double tap = 0.0;
+		if (fabs (distance) < halfWidth) {
+			const double phase = NUMpi * cutoff * distance;
+			tap = ( phase == 0.0 ? 1.0 : sin (phase) / phase ) * 0.5 * (1.0 + cos (NUMpi * distance / halfWidth));
+		}
+		taps [itap] = tap;
+		sum += tap;
+	}
+	if (sum != 0.0)
+		taps  *=  1.0 / double (sum);   // unity gain at zero frequency
+}
+
+static inline double applyPolyphaseFilter (constVEC const& input, integer firstInputSample, constVEC const& taps) {
+	const integer firstTap = std::max (1_integer, 2 - firstInputSample);
+	const integer lastTap = std::min (taps.size, input.size + 1 - firstInputSample);
+	double result = 0.0;
+	for (integer itap = firstTap; itap <= lastTap; itap ++)
+		result += input [firstInputSample - 1 + itap] * taps [itap];   // zero outside the sound
+	return result;
+}
+
+autoSound Sound_resample_polyphase (constSound me, double samplingFrequency, integer precision) {
+	try {
+		constexpr integer maximumNumberOfExactPhases = 1000;
+		constexpr integer numberOfInterpolatedPhases = 512;
+		const integer numberOfSamples = Melder_iround ((my xmax - my xmin) * samplingFrequency);
+		if (numberOfSamples < 1)
+			Melder_throw (U"The resampled Sound would have no samples.");
+		autoSound thee = Sound_create (my ny, my xmin, my xmax, numberOfSamples, 1.0 / samplingFrequency,
+				0.5 * (my xmin + my xmax - (numberOfSamples - 1) / samplingFrequency));
+
+		const double step = 1.0 / (samplingFrequency * my dx);   // input samples per output sample
+		const double cutoff = std::min (1.0, 1.0 / step);   // relative to the input Nyquist frequency
+		const double halfWidth = std::max (1_integer, precision) / cutoff;   // in input samples
+		const integer halfNumberOfTaps = Melder_iceiling (halfWidth);
+		const double firstIndex = Sampled_xToIndex (me, Sampled_indexToX (thee.get(), 1));
+
+		/*
+			Is the ratio of the sampling frequencies a fraction numberOfPhases / inputStep with a small numerator?
+		*/
+		integer numberOfPhases = 0, inputStep = 0;
+		for (integer numerator = 1; numerator <= maximumNumberOfExactPhases; numerator ++) {
+			const integer denominator = Melder_iround (numerator * step);
+			if (denominator >= 1 && fabs (numerator * step - denominator) < 1e-9 * denominator) {
+				numberOfPhases = numerator;
+				inputStep = denominator;
+				break;
+			}
+		}
+
+		autoMAT filters;
+		autoINTVEC firstInputSamples;
+		if (numberOfPhases > 0) {
+			/*
+				Output sample i = q * numberOfPhases + k + 1 lies at input index firstIndex + q * inputStep + k * step,
+				so it uses filter k + 1, shifted by q * inputStep input samples.
+			*/
+			filters = raw_MAT (numberOfPhases, 2 * halfNumberOfTaps);
+			firstInputSamples = raw_INTVEC (numberOfPhases);
+			for (integer iphase = 1; iphase <= numberOfPhases; iphase ++) {
+				const double index = firstIndex + (iphase - 1) * inputStep / (double) numberOfPhases;
+				const integer leftSample = Melder_ifloor (index);
+				computePolyphaseFilter (filters.row (iphase), index - leftSample, cutoff, halfWidth);
+				firstInputSamples [iphase] = leftSample - halfNumberOfTaps + 1;
+			}
+		} else {
+			filters = raw_MAT (numberOfInterpolatedPhases + 1, 2 * halfNumberOfTaps);
+			for (integer iphase = 1; iphase <= numberOfInterpolatedPhases + 1; iphase ++)
+				computePolyphaseFilter (filters.row (iphase), (iphase - 1) / (double) numberOfInterpolatedPhases, cutoff, halfWidth);
+		}
+
+		const integer numberOfThreads = MelderThread_getNumberOfThreadsForItems (numberOfSamples, 10000);
+		autoMAT interpolatedFilters = raw_MAT (numberOfThreads, 2 * halfNumberOfTaps);
+		MelderThread_runChunks (numberOfSamples, numberOfThreads,
+			[&] (integer firstSample, integer lastSample, integer ithread) {
+				const VEC taps = interpolatedFilters.row (ithread);
+				for (integer isample = firstSample; isample <= lastSample; isample ++) {
+					integer firstInputSample;
+					constVEC filter;
+					if (numberOfPhases > 0) {
+						const integer cycle = (isample - 1) / numberOfPhases, iphase = (isample - 1) % numberOfPhases + 1;
+						firstInputSample = firstInputSamples [iphase] + cycle * inputStep;
+						filter = filters.row (iphase);
+					} else {
+						const double index = firstIndex + (isample - 1) * step;
+						const integer leftSample = Melder_ifloor (index);
+						const double position = (index - leftSample) * numberOfInterpolatedPhases;
+						const integer iphase = std::min (Melder_ifloor (position), numberOfInterpolatedPhases - 1) + 1;
+						const double weight = position - (iphase - 1);
+						for (integer itap = 1; itap <= taps.size; itap ++)
+							taps [itap] = (1.0 - weight) * filters [iphase] [itap] + weight * filters [iphase + 1] [itap];
+						firstInputSample = leftSample - halfNumberOfTaps + 1;
+						filter = taps;
+					}
+					for (integer ichan = 1; ichan <= my ny; ichan ++)
+						thy z [ichan] [isample] = applyPolyphaseFilter (my z.row (ichan), firstInputSample, filter);
+				}
+			}
+		);
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": not resampled.");
+	}
+}
+
 autoSound Sounds_append (constSound me, double silenceDuration, constSound thee) {
 	try {
 		const integer nx_silence = Melder_iround (silenceDuration / my dx), nx = my nx + nx_silence + thy nx;
@@ -542,6 +663,71 @@ autoSound Sounds_concatenate (SoundList list, double overlapTime) {
 	}
 }
 
+/*
+	Parselmouth: convolving a long signal with a much shorter kernel (e.g. an impulse response) does not need
+	both signals padded to a single FFT of the size of the whole result. Overlap-save instead transforms the kernel once,
+	and filters the signal in independent blocks of a few kernel lengths, which can be processed in parallel,
+	with memory proportional to the block size. The result is the same up to rounding,
+	but not scaled by the FFT size, as the single-FFT result is.
+*/
+static integer getOverlapSaveFftSize (integer signalLength, integer kernelLength) {
+	if (kernelLength * 8 > signalLength)
+		return 0;
+	const integer blockFftSize = Melder_iroundUpToPowerOfTwo (std::max (8 * kernelLength, 4096_integer));
+	const integer singleFftSize = Melder_iroundUpToPowerOfTwo (signalLength + kernelLength - 1);
+	return ( blockFftSize * 4 <= singleFftSize ? blockFftSize : 0 );
+}
+
+static void convolve_overlapSave (constVEC const& signal, bool signalReversed, constVEC const& kernel, bool kernelReversed,
+	integer nfft, VEC const& result)
+{
+	const integer signalLength = signal.size, kernelLength = kernel.size;
+	Melder_assert (result.size == signalLength + kernelLength - 1);
+	Melder_assert (nfft >= kernelLength);
+	/*
+		The kernel spectrum, including the 1/nfft of the inverse transform.
+	*/
+	autoVEC kernelSpectrum = zero_VEC (nfft);
+	for (integer i = 1; i <= kernelLength; i ++)
+		kernelSpectrum [i] = kernel [kernelReversed ? kernelLength + 1 - i : i] / nfft;
+	NUMfft_forward (kernelSpectrum.get());
+	/*
+		Block b produces the result samples firstSample .. firstSample + blockStep - 1,
+		from the signal samples firstSample - (kernelLength - 1) .. firstSample + blockStep - 1;
+		the first kernelLength - 1 samples of its circular convolution are wrapped around, and are discarded.
+	*/
+	const integer blockStep = nfft - kernelLength + 1;
+	const integer numberOfBlocks = (result.size - 1) / blockStep + 1;
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsForItems (numberOfBlocks, 2);
+	autoMAT blocks = raw_MAT (numberOfThreads, nfft);
+	MelderThread_runChunks (numberOfBlocks, numberOfThreads,
+		[&] (integer firstBlock, integer lastBlock, integer ithread) {
+			const VEC data = blocks.row (ithread);
+			for (integer iblock = firstBlock; iblock <= lastBlock; iblock ++) {
+				const integer firstSample = 1 + (iblock - 1) * blockStep;
+				const integer offset = firstSample - kernelLength;   // data [i] is signal sample offset + i
+				for (integer i = 1; i <= nfft; i ++) {
+					const integer isample = offset + i;
+					data [i] = ( isample < 1 || isample > signalLength ? 0.0 :
+							signal [signalReversed ? signalLength + 1 - isample : isample] );
+				}
+				NUMfft_forward (data);
+				data [1] *= kernelSpectrum [1];
+				for (integer i = 2; i < nfft; i += 2) {
+					const double temp = data [i] * kernelSpectrum [i] - data [i + 1] * kernelSpectrum [i + 1];
+					data [i + 1] = data [i] * kernelSpectrum [i + 1] + data [i + 1] * kernelSpectrum [i];
+					data [i] = temp;
+				}
+				data [nfft] *= kernelSpectrum [nfft];
+				NUMfft_backward (data);
+				const integer numberOfSamples = std::min (blockStep, result.size - firstSample + 1);
+				for (integer i = 1; i <= numberOfSamples; i ++)
+					result [firstSample - 1 + i] = data [kernelLength - 1 + i];
+			}
+		}
+	);
+}
+
 autoSound Sounds_convolve (constSound me, constSound thee, kSounds_convolve_scaling scaling, kSounds_convolve_signalOutsideTimeDomain signalOutsideTimeDomain) {
 	try {
 		if (my ny > 1 && thy ny > 1 && my ny != thy ny)
@@ -550,35 +736,46 @@ autoSound Sounds_convolve (constSound me, constSound thee, kSounds_convolve_scal
 			Melder_throw (U"The sampling frequencies of the two sounds have to be equal.");
 		const integer n1 = my nx, n2 = thy nx;
 		const integer n3 = n1 + n2 - 1;
-		const integer nfft = Melder_iroundUpToPowerOfTwo (n3);
-		autoVEC data1 = raw_VEC (nfft);
-		autoVEC data2 = raw_VEC (nfft);
+		integer nfft = Melder_iroundUpToPowerOfTwo (n3);
 		integer numberOfChannels = std::max (my ny, thy ny);
 		autoSound him = Sound_create (numberOfChannels, my xmin + thy xmin, my xmax + thy xmax, n3, my dx, my x1 + thy x1);
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			VEC a = my z.row (my ny == 1 ? 1 : channel);
-			for (integer i = n1; i > 0; i --)
-				data1 [i] = a [i];
-			for (integer i = n1 + 1; i <= nfft; i ++)
-				data1 [i] = 0.0;
-			a = thy z.row (thy ny == 1 ? 1 : channel);
-			for (integer i = n2; i > 0; i --)
-				data2 [i] = a [i];
-			for (integer i = n2 + 1; i <= nfft; i ++)
-				data2 [i] = 0.0;
-			NUMrealft (data1.get(), 1);
-			NUMrealft (data2.get(), 1);
-			data2 [1] *= data1 [1];
-			data2 [2] *= data1 [2];
-			for (integer i = 3; i <= nfft; i += 2) {
-				const double temp = data1 [i] * data2 [i] - data1 [i + 1] * data2 [i + 1];
-				data2 [i + 1] = data1 [i] * data2 [i + 1] + data1 [i + 1] * data2 [i];
-				data2 [i] = temp;
+		if (const integer blockFftSize = getOverlapSaveFftSize (std::max (n1, n2), std::min (n1, n2))) {
+			for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+				const constVEC mine = my z.row (my ny == 1 ? 1 : channel), thine = thy z.row (thy ny == 1 ? 1 : channel);
+				if (n1 >= n2)
+					convolve_overlapSave (mine, false, thine, false, blockFftSize, his z.row (channel));
+				else
+					convolve_overlapSave (thine, false, mine, false, blockFftSize, his z.row (channel));
+			}
+			nfft = 1;   // the overlap-save result is not scaled by the FFT size
+		} else {
+			autoVEC data1 = raw_VEC (nfft);
+			autoVEC data2 = raw_VEC (nfft);
+			for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+				VEC a = my z.row (my ny == 1 ? 1 : channel);
+				for (integer i = n1; i > 0; i --)
+					data1 [i] = a [i];
+				for (integer i = n1 + 1; i <= nfft; i ++)
+					data1 [i] = 0.0;
+				a = thy z.row (thy ny == 1 ? 1 : channel);
+				for (integer i = n2; i > 0; i --)
+					data2 [i] = a [i];
+				for (integer i = n2 + 1; i <= nfft; i ++)
+					data2 [i] = 0.0;
+				NUMrealft (data1.get(), 1);
+				NUMrealft (data2.get(), 1);
+				data2 [1] *= data1 [1];
+				data2 [2] *= data1 [2];
+				for (integer i = 3; i <= nfft; i += 2) {
+					const double temp = data1 [i] * data2 [i] - data1 [i + 1] * data2 [i + 1];
+					data2 [i + 1] = data1 [i] * data2 [i + 1] + data1 [i + 1] * data2 [i];
+					data2 [i] = temp;
+				}
+				NUMrealft (data2.get(), -1);
+				a = his z.row (channel);
+				for (integer i = 1; i <= n3; i ++)
+					a [i] = data2 [i];
 			}
-			NUMrealft (data2.get(), -1);
-			a = his z.row (channel);
-			for (integer i = 1; i <= n3; i ++)
-				a [i] = data2 [i];
 		}
 		switch (signalOutsideTimeDomain) {
 			case kSounds_convolve_signalOutsideTimeDomain::ZERO: {
@@ -631,37 +828,51 @@ autoSound Sounds_crossCorrelate (constSound me, constSound thee, kSounds_convolv
 			U"The sampling frequencies of the two sounds have to be equal.");
 		const integer numberOfChannels = std::max (my ny, thy ny);
 		const integer n1 = my nx, n2 = thy nx, n3 = n1 + n2 - 1;
-		const integer nfft = Melder_iroundUpToPowerOfTwo (n3);
-		autoVEC data1 = raw_VEC (nfft);
-		autoVEC data2 = raw_VEC (nfft);
+		integer nfft = Melder_iroundUpToPowerOfTwo (n3);
 		const double my_xlast = my x1 + (n1 - 1) * my dx;
 		autoSound him = Sound_create (numberOfChannels, thy xmin - my xmax, thy xmax - my xmin, n3, my dx, thy x1 - my_xlast);
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			VEC a = my z.row (my ny == 1 ? 1 : channel);
-			for (integer i = n1; i > 0; i --)
-				data1 [i] = a [i];
-			for (integer i = n1 + 1; i <= nfft; i ++)
-				data1 [i] = 0.0;
-			a = thy z.row (thy ny == 1 ? 1 : channel);
-			for (integer i = n2; i > 0; i --)
-				data2 [i] = a [i];
-			for (integer i = n2 + 1; i <= nfft; i ++)
-				data2 [i] = 0.0;
-			NUMrealft (data1.get(), 1);
-			NUMrealft (data2.get(), 1);
-			data2 [1] *= data1 [1];
-			data2 [2] *= data1 [2];
-			for (integer i = 3; i <= nfft; i += 2) {
-				const double temp = data1 [i] * data2 [i] + data1 [i + 1] * data2 [i + 1];   // reverse me by taking the conjugate of data1
-				data2 [i + 1] = data1 [i] * data2 [i + 1] - data1 [i + 1] * data2 [i];   // reverse me by taking the conjugate of data1
-				data2 [i] = temp;
+		if (const integer blockFftSize = getOverlapSaveFftSize (std::max (n1, n2), std::min (n1, n2))) {
+			/*
+				The cross-correlation is the convolution of the reversed me with thee.
+			*/
+			for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+				const constVEC mine = my z.row (my ny == 1 ? 1 : channel), thine = thy z.row (thy ny == 1 ? 1 : channel);
+				if (n2 >= n1)
+					convolve_overlapSave (thine, false, mine, true, blockFftSize, his z.row (channel));
+				else
+					convolve_overlapSave (mine, true, thine, false, blockFftSize, his z.row (channel));
+			}
+			nfft = 1;   // the overlap-save result is not scaled by the FFT size
+		} else {
+			autoVEC data1 = raw_VEC (nfft);
+			autoVEC data2 = raw_VEC (nfft);
+			for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+				VEC a = my z.row (my ny == 1 ? 1 : channel);
+				for (integer i = n1; i > 0; i --)
+					data1 [i] = a [i];
+				for (integer i = n1 + 1; i <= nfft; i ++)
+					data1 [i] = 0.0;
+				a = thy z.row (thy ny == 1 ? 1 : channel);
+				for (integer i = n2; i > 0; i --)
+					data2 [i] = a [i];
+				for (integer i = n2 + 1; i <= nfft; i ++)
+					data2 [i] = 0.0;
+				NUMrealft (data1.get(), 1);
+				NUMrealft (data2.get(), 1);
+				data2 [1] *= data1 [1];
+				data2 [2] *= data1 [2];
+				for (integer i = 3; i <= nfft; i += 2) {
+					const double temp = data1 [i] * data2 [i] + data1 [i + 1] * data2 [i + 1];   // reverse me by taking the conjugate of data1
+					data2 [i + 1] = data1 [i] * data2 [i + 1] - data1 [i + 1] * data2 [i];   // reverse me by taking the conjugate of data1
+					data2 [i] = temp;
+				}
+				NUMrealft (data2.get(), -1);
+				a = his z.row (channel);
+				for (integer i = 1; i < n1; i ++)
+					a [i] = data2 [i + (nfft - (n1 - 1))];   // data for the first part ("negative lags") is at the end of data2
+				for (integer i = 1; i <= n2; i ++)
+					a [i + (n1 - 1)] = data2 [i];   // data for the second part ("positive lags") is at the beginning of data2
 			}
-			NUMrealft (data2.get(), -1);
-			a = his z.row (channel);
-			for (integer i = 1; i < n1; i ++)
-				a [i] = data2 [i + (nfft - (n1 - 1))];   // data for the first part ("negative lags") is at the end of data2
-			for (integer i = 1; i <= n2; i ++)
-				a [i + (n1 - 1)] = data2 [i];   // data for the second part ("positive lags") is at the beginning of data2
 		}
 		switch (signalOutsideTimeDomain) {
 			case kSounds_convolve_signalOutsideTimeDomain::ZERO: {
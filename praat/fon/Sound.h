@@ -117,6 +117,13 @@ autoSound Sound_resample (constSound me, double samplingFrequency, integer preci
 		precision >= 2: sinx/x interpolation with maximum depth equal to 'precision'.
 */
 
+autoSound Sound_resample_polyphase (constSound me, double samplingFrequency, integer precision);
+/*
+	Parselmouth: the same time sampling as Sound_resample, but computed with a polyphase windowed-sinc filter
+	that has 'precision' zero crossings on either side and a cutoff at the lower of the two Nyquist frequencies,
+	without the whole-signal FFT of the anti-aliasing step, and on multiple threads.
+*/
+
 autoSound Sounds_append (constSound me, double silenceDuration, constSound thee);
 /*
 	Function:
@@ -309,6 +316,8 @@ void Sound_saveAsKayFile (constSound me, MelderFile file);   // 16-bit
 void Sound_saveAsSesamFile (constSound me, MelderFile file);   // 12-bit SESAM/LVS
 
 autoSound Sound_readFromSoundFile (MelderFile file);   // AIFF, WAV, NeXT/Sun, or NIST
+autoSound Sound_readFromSoundFileStream (MelderFile file);
+	/* Parselmouth: the same, from a file that is already open; file -> filePointer can be any seekable stream (e.g. in memory). */
 autoDaata Sound_readFromAnyKayFile (MelderFile file);   // 16-bit
 autoSound Sound_readFromSesamFile (MelderFile file);   // 12-bit SESAM/LVS
 autoSound Sound_readFromBellLabsFile (MelderFile file);   // 16-bit
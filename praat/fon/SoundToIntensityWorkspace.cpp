@@ -0,0 +1,130 @@
+/* SoundToIntensityWorkspace.cpp
+ *
+ * Copyright (C) 2026 Yannick Jadoul
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SoundToIntensityWorkspace.h"
+
+#include "oo_DESTROY.h"
+#include "SoundToIntensityWorkspace_def.h"
+#include "oo_COPY.h"
+#include "SoundToIntensityWorkspace_def.h"
+#include "oo_EQUAL.h"
+#include "SoundToIntensityWorkspace_def.h"
+#include "oo_CAN_WRITE_AS_ENCODING.h"
+#include "SoundToIntensityWorkspace_def.h"
+#include "oo_WRITE_TEXT.h"
+#include "SoundToIntensityWorkspace_def.h"
+#include "oo_WRITE_BINARY.h"
+#include "SoundToIntensityWorkspace_def.h"
+#include "oo_READ_TEXT.h"
+#include "SoundToIntensityWorkspace_def.h"
+#include "oo_READ_BINARY.h"
+#include "SoundToIntensityWorkspace_def.h"
+#include "oo_DESCRIPTION.h"
+#include "SoundToIntensityWorkspace_def.h"
+
+Thing_implement (SoundToIntensityWorkspace, SoundToSampledWorkspace, 0);
+
+void structSoundToIntensityWorkspace :: getInputFrame (void) {
+	const double midTime = Sampled_indexToX (output, currentFrame);
+	const integer soundCentreSampleNumber = Sampled_xToNearestIndex (input, midTime);   // time accuracy is half a sampling period
+	const integer halfWindowSamples = soundFrameSize / 2;
+	leftSample = soundCentreSampleNumber - halfWindowSamples;
+	rightSample = soundCentreSampleNumber + halfWindowSamples;
+	/*
+		Catch some edge cases, which are uncommon because Sampled_shortTermAnalysis() filtered out most problems.
+	*/
+	Melder_clipLeft (1_integer, & leftSample);
+	Melder_clipRight (& rightSample, input -> nx);
+	Melder_require (rightSample >= leftSample,
+		U"Unexpected edge case: right sample (", rightSample, U") less than left sample (", leftSample, U").");
+	windowFromSoundOffset = halfWindowSamples + 1 - soundCentreSampleNumber;
+}
+
+bool structSoundToIntensityWorkspace :: inputFrameToOutputFrame (void) {
+	const constVEC windowPart = windowFunction.part (windowFromSoundOffset + leftSample, windowFromSoundOffset + rightSample);
+	/*
+		The energy of all channels is added, in the same order as the window weights of wholeWindowSum.
+	*/
+	longdouble sumxw = 0.0;
+	for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
+		constVEC amplitudePart = block -> z [ichan].part (leftSample - sampleOffset, rightSample - sampleOffset);
+		if (subtractFrameMean) {
+			const VEC centredPart = soundFrame.part (1, amplitudePart.size);
+			centredPart  <<=  amplitudePart;
+			centre_VEC_inout (centredPart);
+			amplitudePart = centredPart;
+		}
+		for (integer isamp = 1; isamp <= amplitudePart.size; isamp ++)
+			sumxw += sqr (amplitudePart [isamp]) * windowPart [isamp];
+	}
+	longdouble sumw = wholeWindowSum;
+	if (windowPart.size < soundFrameSize) {
+		sumw = 0.0;
+		for (integer ichan = 1; ichan <= numberOfChannels; ichan ++)
+			for (integer isamp = 1; isamp <= windowPart.size; isamp ++)
+				sumw += windowPart [isamp];
+	}
+	const double intensity_in_Pa2 = double (sumxw / sumw);
+	constexpr double hearingThreshold_in_Pa = 2.0e-5;
+	constexpr double hearingThreshold_in_Pa2 = sqr (hearingThreshold_in_Pa);
+	const double intensity_re_hearingThreshold = intensity_in_Pa2 / hearingThreshold_in_Pa2;
+	intensity_dB = ( intensity_re_hearingThreshold < 1.0e-30 ? -300.0 : 10.0 * log10 (intensity_re_hearingThreshold) );
+	return true;
+}
+
+void structSoundToIntensityWorkspace :: saveOutputFrame (void) {
+	Intensity me = reinterpret_cast<Intensity> (output);
+	my z [1] [currentFrame] = intensity_dB;
+}
+
+autoSoundToIntensityWorkspace SoundToIntensityWorkspace_create (constSampledXY input, mutableIntensity output,
+	double logicalWindowDuration, bool subtractMeanPressure)
+{
+	try {
+		autoSoundToIntensityWorkspace me = Thing_new (SoundToIntensityWorkspace);
+		SampledToSampledWorkspace_init (me.get(), input, output);
+		SoundToSampledWorkspace_init (me.get(), input -> dx, logicalWindowDuration, kSound_windowShape::KAISER_2);
+		my subtractFrameMean = subtractMeanPressure;
+		my numberOfChannels = input -> ny;
+		/*
+			Not the normalized Kaiser window of windowShape_into_VEC, but the one intensity has always used.
+		*/
+		const double halfWindowDuration = 0.5 * my physicalAnalysisWidth;
+		const integer windowCentreSampleNumber = my soundFrameSize / 2 + 1;
+		for (integer i = 1; i <= my soundFrameSize; i ++) {
+			const double x = (i - windowCentreSampleNumber) * input -> dx / halfWindowDuration;
+			const double root = sqrt (Melder_clippedLeft (0.0, 1.0 - sqr (x)));   // clipping should be rare
+			my windowFunction [i] = NUMbessel_i0_f ((2.0 * NUMpi * NUMpi + 0.5) * root);
+		}
+		my wholeWindowSum = 0.0;
+		for (integer ichan = 1; ichan <= my numberOfChannels; ichan ++)
+			for (integer i = 1; i <= my soundFrameSize; i ++)
+				my wholeWindowSum += my windowFunction [i];
+		return me;
+	} catch (MelderError) {
+		Melder_throw (U"SoundToIntensityWorkspace not created.");
+	}
+}
+
+void SoundToIntensityWorkspace_setBlock (mutableSoundToIntensityWorkspace me, constSound block, integer sampleOffset) {
+	Melder_assert (block -> ny == my numberOfChannels);
+	my block = block;
+	my sampleOffset = sampleOffset;
+}
+
+/* End of file SoundToIntensityWorkspace.cpp */
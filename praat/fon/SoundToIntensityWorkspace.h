@@ -0,0 +1,37 @@
+#ifndef _SoundToIntensityWorkspace_h_
+#define _SoundToIntensityWorkspace_h_
+/* SoundToIntensityWorkspace.h
+ *
+ * Copyright (C) 2026 Yannick Jadoul
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Intensity.h"
+#include "Sound.h"
+#include "SoundToSampledWorkspace.h"
+
+#include "SoundToIntensityWorkspace_def.h"
+
+autoSoundToIntensityWorkspace SoundToIntensityWorkspace_create (constSampledXY input, mutableIntensity output,
+	double logicalWindowDuration, bool subtractMeanPressure
+);
+/*
+	'input' is a Sound or a LongSound: it only provides the sampling and the number of channels;
+	the samples are read from the Sound set with SoundToIntensityWorkspace_setBlock.
+*/
+
+void SoundToIntensityWorkspace_setBlock (mutableSoundToIntensityWorkspace me, constSound block, integer sampleOffset);
+
+#endif /* _SoundToIntensityWorkspace_h_ */
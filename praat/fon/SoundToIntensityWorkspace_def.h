@@ -0,0 +1,53 @@
+/* SoundToIntensityWorkspace_def.h
+ *
+ * Copyright (C) 2026 Yannick Jadoul
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define ooSTRUCT SoundToIntensityWorkspace
+oo_DEFINE_CLASS (SoundToIntensityWorkspace, SoundToSampledWorkspace)
+
+	oo_UNSAFE_BORROWED_TRANSIENT_CONST_OBJECT_REFERENCE (Sound, block)	// the samples of the input, which can be a LongSound
+	oo_INTEGER (sampleOffset)				// sample i of the input is block -> z [ichan] [i - sampleOffset]
+	oo_INTEGER (numberOfChannels)
+	oo_INTEGER (leftSample)					// the part of the input in the current frame
+	oo_INTEGER (rightSample)
+	oo_INTEGER (windowFromSoundOffset)		// sample i of the input gets weight windowFunction [windowFromSoundOffset + i]
+	oo_DOUBLE (intensity_dB)
+
+	#if oo_DECLARING
+
+		/*
+			The sum of the window weights over all channels, accumulated in the same order as
+			in a frame with a whole window; only the frames at the edges need their own sum.
+		*/
+		longdouble wholeWindowSum;
+
+		void getInputFrame (void) override;
+		bool inputFrameToOutputFrame (void) override;
+		void saveOutputFrame (void) override;
+
+	#endif
+
+	#if oo_COPYING
+
+		thy wholeWindowSum = wholeWindowSum;
+
+	#endif
+
+oo_END_CLASS (SoundToIntensityWorkspace)
+#undef ooSTRUCT
+
+/* End of file SoundToIntensityWorkspace_def.h */
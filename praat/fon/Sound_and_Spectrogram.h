@@ -18,7 +18,7 @@
  * along with this work. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "Sound.h"
+#include "LongSound.h"
 #include "Spectrogram.h"
 
 #include "Sound_and_Spectrogram_enums.h"
@@ -27,6 +27,14 @@ autoSpectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, d
 	double minimumTimeStep1, double minimumFreqStep1, kSound_to_Spectrogram_windowShape windowShape,
 	double maximumTimeOversampling, double maximumFreqOversampling);
 
+/*
+	Parselmouth: the same analysis, reading blocks of about 'blockDuration' seconds of frames from the file;
+	the result is identical to that of Sound_to_Spectrogram on the whole file.
+*/
+autoSpectrogram LongSound_to_Spectrogram (LongSound me, double effectiveAnalysisWidth, double fmax,
+	double minimumTimeStep1, double minimumFreqStep1, kSound_to_Spectrogram_windowShape windowShape,
+	double maximumTimeOversampling, double maximumFreqOversampling, double blockDuration);
+
 autoSound Spectrogram_to_Sound (Spectrogram me, double fsamp);
 
 /* End of Sound_and_Spectrogram.h */
@@ -38,9 +38,7 @@ autoSpectrum Sound_to_Spectrum (Sound me, bool fast) {
 			data.part (1, my nx)  *=  1.0 / numberOfChannels;
 		}
 
-		autoNUMfft_Table fourierTable;
-		NUMfft_Table_init (& fourierTable, numberOfFourierSamples);
-		NUMfft_forward (& fourierTable, data.get());
+		NUMfft_forward (data.get());   // Parselmouth: cached table
 
 		autoSpectrum thee = Spectrum_create (0.5 / my dx, numberOfFrequencies);
 		thy dx = 1.0 / (my dx * numberOfFourierSamples);   // override, just in case numberOfFourierSamples is odd
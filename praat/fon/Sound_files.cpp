@@ -68,21 +68,7 @@ static void Sound_alawDecode (Sound me) {
 autoSound Sound_readFromSoundFile (MelderFile file) {
 	try {
 		autoMelderFile mfile = MelderFile_open (file);
-		int encoding;
-		double sampleRate;
-		integer startOfData, numberOfSamples, numberOfChannels;
-		int fileType = MelderFile_checkSoundFile (file, & numberOfChannels, & encoding, & sampleRate, & startOfData, & numberOfSamples);
-		if (fileType == 0)
-			Melder_throw (U"Not an audio file.");
-		if (fseek (file -> filePointer, startOfData, SEEK_SET) == EOF)   // start from beginning of Data Chunk
-			Melder_throw (U"No data in audio file.");
-		if (numberOfSamples < 1)
-			Melder_throw (U"Audio file contains 0 samples.");
-		autoSound me = Sound_createSimple (numberOfChannels, numberOfSamples / sampleRate, sampleRate);
-		Melder_assert (my z.ncol == numberOfSamples);
-		if (encoding == Melder_SHORTEN)
-			Melder_throw (U"Cannot unshorten. Write to paul.boersma@uva.nl for more information.");
-		Melder_readAudioToFloat (file -> filePointer, encoding, my z.get());
+		autoSound me = Sound_readFromSoundFileStream (file);
 		mfile.close ();
 		return me;
 	} catch (MelderError) {
@@ -90,6 +76,25 @@ autoSound Sound_readFromSoundFile (MelderFile file) {
 	}
 }
 
+autoSound Sound_readFromSoundFileStream (MelderFile file) {
+	int encoding;
+	double sampleRate;
+	integer startOfData, numberOfSamples, numberOfChannels;
+	int fileType = MelderFile_checkSoundFile (file, & numberOfChannels, & encoding, & sampleRate, & startOfData, & numberOfSamples);
+	if (fileType == 0)
+		Melder_throw (U"Not an audio file.");
+	if (fseek (file -> filePointer, startOfData, SEEK_SET) == EOF)   // start from beginning of Data Chunk
+		Melder_throw (U"No data in audio file.");
+	if (numberOfSamples < 1)
+		Melder_throw (U"Audio file contains 0 samples.");
+	autoSound me = Sound_createSimple (numberOfChannels, numberOfSamples / sampleRate, sampleRate);
+	Melder_assert (my z.ncol == numberOfSamples);
+	if (encoding == Melder_SHORTEN)
+		Melder_throw (U"Cannot unshorten. Write to paul.boersma@uva.nl for more information.");
+	Melder_readAudioToFloat (file -> filePointer, encoding, my z.get());
+	return me;
+}
+
 autoSound Sound_readFromSesamFile (MelderFile file) {
 	try {
 		autofile f = Melder_fopen (file, "rb");
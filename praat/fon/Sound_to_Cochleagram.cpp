@@ -31,6 +31,8 @@
 #include "Sound_to_Cochleagram.h"
 #include "Sound_and_Spectrum.h"
 #include "Spectrum_to_Excitation.h"
+#include "NUM2.h"
+#include "MelderThread.h"
 
 autoCochleagram Sound_to_Cochleagram (Sound me, double dt, double df, double dt_window, double forwardMaskingTime) {
 	try {
@@ -45,7 +47,51 @@ autoCochleagram Sound_to_Cochleagram (Sound me, double dt, double df, double dt_
 		if (nFrames < 2) return autoCochleagram ();
 		double t1 = my x1 + 0.5 * (duration - my dx - (nFrames - 1) * dt);   // centre of first frame
 		autoCochleagram thee = Cochleagram_create (my xmin, my xmax, nFrames, dt, t1, df, nf);
-		autoSound window = Sound_createSimple (1, nsamp_window * my dx, 1.0 / my dx);
+
+		/*
+			Parselmouth: every frame used to be copied into a new Sound, converted to a new Spectrum
+			(Sound_to_Spectrum) and then to a new Excitation (Spectrum_to_Excitation), which recomputed
+			the band edges and the masking filter every time. We do the same computations in place,
+			with everything that does not depend on the frame computed once, and analyse the frames in parallel;
+			only the forward masking is left to a sequential pass afterwards. The results are identical.
+		*/
+		Melder_require (nsamp_window >= 2,
+			U"The window length should be at least four samples.");
+		const double windowDx = 1.0 / (1.0 / my dx);   // as in the window Sound that Sound_createSimple () would create
+		const integer nfft = Melder_iroundUpToPowerOfTwo (nsamp_window);
+		const integer numberOfFrequencies = nfft / 2 + 1;
+		const double spectrumDx = 1.0 / (windowDx * nfft);
+		autoVEC window = raw_VEC (nsamp_window);
+		for (integer i = 1; i <= nsamp_window; i ++)
+			window [i] = 0.5 - 0.5 * cos (2.0 * NUMpi * i / (nsamp_window + 1));
+
+		/*
+			The spectrum-to-Bark mapping is sparse: each band sums the power of a range of consecutive bins,
+			with one weight per band (the anti-undersampling correction of Spectrum_to_Excitation).
+		*/
+		const integer nbark = Melder_iround (25.6 / df);
+		Melder_assert (nf <= nbark);
+		autoVEC auditoryFilter = raw_VEC (nbark);
+		for (integer i = 1; i <= nbark; i ++) {
+			const double bark = df * (i - nbark/2) + 0.474;
+			auditoryFilter [i] = pow (10, (1.581 + 0.75 * bark - 1.75 * sqrt (1 + bark * bark)));
+		}
+		autoVEC rFreqs = raw_VEC (nbark + 1);
+		autoINTVEC iFreqs = raw_INTVEC (nbark + 1);
+		for (integer i = 1; i <= nbark + 1; i ++) {
+			rFreqs [i] = NUMbarkToHertz (df * (i - 1));
+			iFreqs [i] = Melder_iround (rFreqs [i] / spectrumDx + 1.0);
+		}
+		autoINTVEC lowBins = raw_INTVEC (nbark), highBins = raw_INTVEC (nbark);
+		autoVEC bandWeights = raw_VEC (nbark);
+		for (integer i = 1; i <= nbark; i ++) {
+			lowBins [i] = std::max (1_integer, iFreqs [i]);
+			highBins [i] = std::min (iFreqs [i + 1] - 1, numberOfFrequencies);
+			bandWeights [i] = ( highBins [i] >= lowBins [i] ?
+					2.0 * (rFreqs [i + 1] - rFreqs [i]) / (highBins [i] - lowBins [i] + 1) * spectrumDx : 1.0 );
+		}
+
+		autoINTVEC startSamples = raw_INTVEC (nFrames);
 		for (integer iframe = 1; iframe <= nFrames; iframe ++) {
 			double t = Sampled_indexToX (thee.get(), iframe);
 			integer leftSample = Sampled_xToLowIndex (me, t);
@@ -63,17 +109,53 @@ autoCochleagram Sound_to_Cochleagram (Sound me, double dt, double df, double dt_
 					U".");
 				endSample = my nx;
 			}
+			startSamples [iframe] = startSample;
+		}
+
+		const integer numberOfThreads = MelderThread_getNumberOfThreadsForItems (nFrames, 10);
+		autoMAT frameBuffers = raw_MAT (numberOfThreads, nfft);
+		autoMAT bandBuffers = raw_MAT (numberOfThreads, nbark);
+		MelderThread_runChunks (nFrames, numberOfThreads,
+			[&] (integer firstFrame, integer lastFrame, integer ithread) {
+				const VEC data = frameBuffers.row (ithread), inSig = bandBuffers.row (ithread);
+				for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+					/* Copy a window to a frame. */
+					const integer startSample = startSamples [iframe];
+					for (integer i = 1; i <= nsamp_window; i ++)
+						data [i] =
+							( my ny == 1 ? my z [1] [i+startSample-1] : 0.5 * (my z [1] [i+startSample-1] + my z [2] [i+startSample-1]) ) *
+							window [i];
+					data.part (nsamp_window + 1, nfft)  <<=  0.0;
+					NUMfft_forward (data);   // Parselmouth: cached table
 
-			/* Copy a window to a frame. */
-			for (integer i = 1; i <= nsamp_window; i ++)
-				window -> z [1] [i] =
-					( my ny == 1 ? my z [1] [i+startSample-1] : 0.5 * (my z [1] [i+startSample-1] + my z [2] [i+startSample-1]) ) *
-					(0.5 - 0.5 * cos (2.0 * NUMpi * i / (nsamp_window + 1)));
-			autoSpectrum spec = Sound_to_Spectrum (window.get(), true);
-			autoExcitation excitation = Spectrum_to_Excitation (spec.get(), df);
+					/* The power density in each band, from the spectrum as Sound_to_Spectrum () would scale it. */
+					for (integer i = 1; i <= nbark; i ++) {
+						double power = 0.0;
+						for (integer j = lowBins [i]; j <= highBins [i]; j ++) {
+							const bool isRealBin = (j == 1 || j == numberOfFrequencies);
+							const double re = ( j == 1 ? data [1] : j == numberOfFrequencies ? data [nfft] : data [j + j - 2] ) * windowDx;
+							const double im = ( isRealBin ? 0.0 : data [j + j - 1] * windowDx );
+							power += re * re + im * im;   // Pa2 s2
+						}
+						if (highBins [i] >= lowBins [i])
+							power *= bandWeights [i];   // Pa2: power density in this band
+						inSig [i] = power;
+					}
+
+					/* Convolution with auditory (masking) filter, summed in the same order as in Spectrum_to_Excitation (). */
+					for (integer ifreq = 1; ifreq <= nf; ifreq ++) {
+						const integer k = ifreq + nbark/2;
+						double outSig = 0.0;
+						for (integer i = std::max (1_integer, k - nbark); i <= std::min (nbark, k - 1); i ++)
+							outSig += inSig [i] * auditoryFilter [k - i];
+						thy z [ifreq] [iframe] = NUMsoundPressureToPhon (sqrt (outSig), 0.5 * df + (ifreq - 1) * df);   // the Excitation's x
+					}
+				}
+			}
+		);
+		for (integer iframe = 2; iframe <= nFrames; iframe ++)
 			for (integer ifreq = 1; ifreq <= nf; ifreq ++)
-				thy z [ifreq] [iframe] = excitation -> z [1] [ifreq] + ( iframe > 1 ? dampingFactor * thy z [ifreq] [iframe - 1] : 0 );
-		}
+				thy z [ifreq] [iframe] += dampingFactor * thy z [ifreq] [iframe - 1];
 		for (integer iframe = 1; iframe <= nFrames; iframe ++)
 			for (integer ifreq = 1; ifreq <= nf; ifreq ++)
 				thy z [ifreq] [iframe] *= integrationCorrection;
@@ -32,6 +32,7 @@
 #include "NUM2.h"
 #include "Polynomial.h"
 #include "Roots.h"
+#include "MelderThread.h"
 
 static void burg (constVEC samples, VEC coefficients,
 	Formant_Frame frame, double nyquistFrequency, double safetyMargin)
@@ -287,30 +288,28 @@ void Formant_sort (Formant me) {
 	}
 }
 
-static autoFormant Sound_to_Formant_any_inplace (Sound me, double dt_in, integer numberOfPoles,
-	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin)
+/*
+	Parselmouth: the frame grid and window of a formant analysis of the (resampled) sound 'whole'.
+*/
+static autoFormant Formant_createForAnalysis (constSampled whole, double dt_in, integer numberOfPoles, double halfdt_window,
+	autoVEC *out_window, integer *out_halfnsamp_window)
 {
 	const double dt = ( dt_in > 0.0 ? dt_in : halfdt_window / 4.0 );
-	const double physicalDuration = my nx * my dx;
+	const double physicalDuration = whole -> nx * whole -> dx;
 	double dt_window = 2.0 * halfdt_window;
 	integer nFrames = 1 + Melder_ifloor ((physicalDuration - dt_window) / dt);
-	integer nsamp_window = Melder_ifloor (dt_window / my dx), halfnsamp_window = nsamp_window / 2;
+	integer nsamp_window = Melder_ifloor (dt_window / whole -> dx), halfnsamp_window = nsamp_window / 2;
 
 	if (nsamp_window < numberOfPoles + 1)
 		Melder_throw (U"Window too short.");
-	double t1 = my x1 + 0.5 * (physicalDuration - my dx - (nFrames - 1) * dt);   // centre of first frame
+	double t1 = whole -> x1 + 0.5 * (physicalDuration - whole -> dx - (nFrames - 1) * dt);   // centre of first frame
 	if (nFrames < 1) {
 		nFrames = 1;
-		t1 = my x1 + 0.5 * physicalDuration;
+		t1 = whole -> x1 + 0.5 * physicalDuration;
 		dt_window = physicalDuration;
-		nsamp_window = my nx;
+		nsamp_window = whole -> nx;
 	}
-	autoFormant thee = Formant_create (my xmin, my xmax, nFrames, dt, t1, (numberOfPoles + 1) / 2);   // e.g. 11 poles -> maximally 6 formants
-
-	autoMelderProgress progress (U"Formant analysis...");
-
-	/* Pre-emphasis. */
-	Sound_preEmphasize_inplace (me, preemphasisFrequency);
+	autoFormant thee = Formant_create (whole -> xmin, whole -> xmax, nFrames, dt, t1, (numberOfPoles + 1) / 2);   // e.g. 11 poles -> maximally 6 formants
 
 	/* Gaussian window. */
 	autoVEC window = raw_VEC (nsamp_window);
@@ -318,48 +317,93 @@ static autoFormant Sound_to_Formant_any_inplace (Sound me, double dt_in, integer
 		const double imid = 0.5 * (nsamp_window + 1), edge = exp (-12.0);
 		window [i] = (exp (-48.0 * (i - imid) * (i - imid) / (nsamp_window + 1) / (nsamp_window + 1)) - edge) / (1.0 - edge);
 	}
+	*out_window = window.move();
+	*out_halfnsamp_window = halfnsamp_window;
+	return thee;
+}
 
-	integer maximumFrameLength = nsamp_window;
-	auto frameBuffer = raw_VEC (maximumFrameLength);
-	auto coefficients = raw_VEC (numberOfPoles);   // superfluous if which==2, but nobody uses that anyway
-	for (integer iframe = 1; iframe <= nFrames; iframe ++) {
-		const double t = Sampled_indexToX (thee.get(), iframe);
-		const integer leftSample = Sampled_xToLowIndex (me, t);
-		const integer rightSample = leftSample + 1;
-		integer startSample = rightSample - halfnsamp_window;
-		integer endSample = leftSample + halfnsamp_window;
-		double maximumIntensity = 0.0;
-		Melder_clipLeft (1_integer, & startSample);   // this should not be more than a rounding problem
-		Melder_clipRight (& endSample, my nx);   // this should not be more than a rounding problem
-		for (integer i = startSample; i <= endSample; i ++) {
-			const double value = Sampled_getValueAtSample (me, i, Sound_LEVEL_MONO, 0);
-			if (value * value > maximumIntensity)
-				maximumIntensity = value * value;
-		}
-		thy frames [iframe]. intensity = maximumIntensity;
-		if (maximumIntensity == 0.0)
-			continue;   // Burg cannot stand all zeroes
-
-		/* Copy a pre-emphasized window to a frame. */
-		const integer actualFrameLength = endSample - startSample + 1;   // should rarely be less than nsamp_window
-		VEC frame = frameBuffer.part (1, actualFrameLength);
-		const integer offset = startSample - 1;
-		for (integer isamp = 1; isamp <= actualFrameLength; isamp ++)
-			frame [isamp] = Sampled_getValueAtSample (me, offset + isamp, Sound_LEVEL_MONO, 0) * window [isamp];
-
-		if (which == 1) {
-			burg (frame, coefficients.get(), & thy frames [iframe], 0.5 / my dx, safetyMargin);
-		} else if (which == 2) {
-			if (! splitLevinson (frame, numberOfPoles, & thy frames [iframe], 0.5 / my dx)) {
-				Melder_clearError ();
-				Melder_casual (U"(Sound_to_Formant:)"
-					U" Analysis results of frame ", iframe,
-					U" will be wrong."
-				);
+/*
+	Parselmouth: analyses the frames firstFrame .. lastFrame of 'thee' from the pre-emphasized Sound 'me',
+	which contains the samples sampleOffset + 1 .. sampleOffset + my nx of the (resampled) sound 'whole'
+	and all samples that these frames need; sample numbers are computed in 'whole'.
+*/
+static void Sound_into_Formant (Sound me, constSampled whole, integer sampleOffset, Formant thee, integer firstFrameToAnalyse, integer lastFrameToAnalyse,
+	constVEC const& window, integer halfnsamp_window, integer numberOfPoles, int which, double safetyMargin)
+{
+	/*
+		Parselmouth: the frames are independent, so they are distributed over the threads of the work-stealing pool;
+		every thread gets its own frame buffer and coefficients, which it reuses for all of its chunks.
+	*/
+	const integer numberOfFramesToAnalyse = lastFrameToAnalyse - firstFrameToAnalyse + 1;
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsForItems (numberOfFramesToAnalyse, 20);
+	integer maximumFrameLength = window.size;
+	std::vector <autoVEC> frameBuffers (integer_to_uinteger (numberOfThreads)), coefficientBuffers (integer_to_uinteger (numberOfThreads));
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		frameBuffers [integer_to_uinteger (ithread - 1)] = raw_VEC (maximumFrameLength);
+		coefficientBuffers [integer_to_uinteger (ithread - 1)] = raw_VEC (numberOfPoles);   // superfluous if which==2, but nobody uses that anyway
+	}
+	MelderThread_runChunks (numberOfFramesToAnalyse, numberOfThreads,
+		[&] (integer firstItem, integer lastItem, integer ithread) {
+			VEC frameBuffer = frameBuffers [integer_to_uinteger (ithread - 1)].get();
+			VEC coefficients = coefficientBuffers [integer_to_uinteger (ithread - 1)].get();
+			for (integer iframe = firstFrameToAnalyse - 1 + firstItem; iframe <= firstFrameToAnalyse - 1 + lastItem; iframe ++) {
+				const double t = Sampled_indexToX (thee, iframe);
+				const integer leftSample = Sampled_xToLowIndex (whole, t);
+				const integer rightSample = leftSample + 1;
+				integer startSample = rightSample - halfnsamp_window;
+				integer endSample = leftSample + halfnsamp_window;
+				double maximumIntensity = 0.0;
+				Melder_clipLeft (1_integer, & startSample);   // this should not be more than a rounding problem
+				Melder_clipRight (& endSample, whole -> nx);   // this should not be more than a rounding problem
+				Melder_assert (startSample - sampleOffset >= 1);
+				Melder_assert (endSample - sampleOffset <= my nx);
+				for (integer i = startSample; i <= endSample; i ++) {
+					const double value = Sampled_getValueAtSample (me, i - sampleOffset, Sound_LEVEL_MONO, 0);
+					if (value * value > maximumIntensity)
+						maximumIntensity = value * value;
+				}
+				thy frames [iframe]. intensity = maximumIntensity;
+				if (maximumIntensity == 0.0)
+					continue;   // Burg cannot stand all zeroes
+
+				/* Copy a pre-emphasized window to a frame. */
+				const integer actualFrameLength = endSample - startSample + 1;   // should rarely be less than nsamp_window
+				VEC frame = frameBuffer.part (1, actualFrameLength);
+				const integer offset = startSample - 1 - sampleOffset;
+				for (integer isamp = 1; isamp <= actualFrameLength; isamp ++)
+					frame [isamp] = Sampled_getValueAtSample (me, offset + isamp, Sound_LEVEL_MONO, 0) * window [isamp];
+
+				if (which == 1) {
+					burg (frame, coefficients, & thy frames [iframe], 0.5 / my dx, safetyMargin);
+				} else if (which == 2) {
+					if (! splitLevinson (frame, numberOfPoles, & thy frames [iframe], 0.5 / my dx)) {
+						Melder_clearError ();
+						Melder_casual (U"(Sound_to_Formant:)"
+							U" Analysis results of frame ", iframe,
+							U" will be wrong."
+						);
+					}
+				}
+				if (ithread == 1)   // the calling thread is always participant 1
+					Melder_progress ((double) iframe / (double) thy nx, U"Formant analysis: frame ", iframe);
 			}
 		}
-		Melder_progress ((double) iframe / (double) nFrames, U"Formant analysis: frame ", iframe);
-	}
+	);
+}
+
+static autoFormant Sound_to_Formant_any_inplace (Sound me, double dt_in, integer numberOfPoles,
+	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin)
+{
+	autoVEC window;
+	integer halfnsamp_window;
+	autoFormant thee = Formant_createForAnalysis (me, dt_in, numberOfPoles, halfdt_window, & window, & halfnsamp_window);
+
+	autoMelderProgress progress (U"Formant analysis...");
+
+	/* Pre-emphasis. */
+	Sound_preEmphasize_inplace (me, preemphasisFrequency);
+
+	Sound_into_Formant (me, me, 0, thee.get(), 1, thy nx, window.get(), halfnsamp_window, numberOfPoles, which, safetyMargin);
 	Formant_sort (thee.get());
 	return thee;
 }
@@ -377,6 +421,73 @@ autoFormant Sound_to_Formant_any (Sound me, double dt, integer numberOfPoles, do
 	return Sound_to_Formant_any_inplace (sound.get(), dt, numberOfPoles, halfdt_window, which, preemphasisFrequency, safetyMargin);
 }
 
+autoFormant LongSound_to_Formant_any (LongSound me, double dt, integer numberOfPoles, double maximumFrequency,
+	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin, double blockDuration)
+{
+	/*
+		The geometry of the resampled sound, as Sound_resample would create it from the whole file.
+	*/
+	const double nyquist = 0.5 / my dx;
+	const bool resample = ! (maximumFrequency <= 0.0 || fabs (maximumFrequency / nyquist - 1) < 1.0e-12);
+	const double samplingFrequency = ( resample ? maximumFrequency * 2 : 1.0 / my dx );
+	const double upfactor = samplingFrequency * my dx;
+	autoSampled whole = Thing_new (Sampled);
+	if (! resample || fabs (upfactor - 1.0) < 1e-6) {
+		Sampled_init (whole.get(), my xmin, my xmax, my nx, my dx, my x1);
+	} else if (fabs (upfactor - 2.0) < 1e-6) {
+		Sampled_init (whole.get(), my xmin, my xmax, my nx * 2, 0.5 * my dx, my x1 - 0.25 * my dx);   // as in Sound_upsample
+	} else {
+		const integer numberOfSamples = Melder_iround ((my xmax - my xmin) * samplingFrequency);
+		Melder_require (numberOfSamples >= 1,
+			U"The resampled Sound would have no samples.");
+		Sampled_init (whole.get(), my xmin, my xmax, numberOfSamples, 1.0 / samplingFrequency,
+				0.5 * (my xmin + my xmax - (numberOfSamples - 1) / samplingFrequency));
+	}
+
+	autoVEC window;
+	integer halfnsamp_window;
+	autoFormant thee = Formant_createForAnalysis (whole.get(), dt, numberOfPoles, halfdt_window, & window, & halfnsamp_window);
+
+	autoMelderProgress progress (U"Formant analysis...");
+
+	/*
+		Without resampling, the frames are analysed exactly as in the whole file.
+		Pre-emphasis changes every sample but the first of the block, so the margin contains one sample more than the frames need.
+
+		Sound_resample filters the whole sound with a single FFT, whose impulse response (a sinc) decays only slowly,
+		so every block that is resampled on its own differs slightly from the same stretch of the whole resampled file.
+		The resampling margin keeps the block's edges, where the difference is largest, a second away from the frames;
+		the resampled samples then differ by less than 1e-4 times the RMS of the sound.
+		Most formants and bandwidths stay within 0.1 percent of those of the whole file,
+		but a frame in which two roots of the LPC polynomial lie close together can differ by more.
+	*/
+	constexpr double resamplingMargin = 1.0;   // seconds
+	const double margin = halfdt_window + ( resample ? resamplingMargin : 0.0 ) + whole -> dx;
+	LongSound_analyseInBlocks (me, thee.get(), margin, blockDuration,
+		[&] (Sound block, integer sampleOffset, integer firstFrame, integer lastFrame) {
+			if (resample) {
+				/*
+					Let the resampled block consist of samples of 'whole'.
+				*/
+				const integer firstSample = std::max (1_integer, Sampled_xToHighIndex (whole.get(), block -> x1));
+				const integer lastSample = std::min (whole -> nx, Sampled_xToLowIndex (whole.get(), Sampled_indexToX (block, block -> nx)));
+				block -> xmin = Sampled_indexToX (whole.get(), firstSample) - 0.5 * whole -> dx;
+				block -> xmax = Sampled_indexToX (whole.get(), lastSample) + 0.5 * whole -> dx;
+				autoSound resampled = Sound_resample (block, samplingFrequency, 50);
+				Sound_preEmphasize_inplace (resampled.get(), preemphasisFrequency);
+				Sound_into_Formant (resampled.get(), whole.get(), Melder_iround ((resampled -> x1 - whole -> x1) / whole -> dx), thee.get(),
+						firstFrame, lastFrame, window.get(), halfnsamp_window, numberOfPoles, which, safetyMargin);
+			} else {
+				Sound_preEmphasize_inplace (block, preemphasisFrequency);
+				Sound_into_Formant (block, whole.get(), sampleOffset, thee.get(), firstFrame, lastFrame,
+						window.get(), halfnsamp_window, numberOfPoles, which, safetyMargin);
+			}
+		}
+	);
+	Formant_sort (thee.get());
+	return thee;
+}
+
 autoFormant Sound_to_Formant_burg (Sound me, double dt, double nFormants, double maximumFrequency, double halfdt_window, double preemphasisFrequency) {
 	try {
 		return Sound_to_Formant_any (me, dt, Melder_iround (2.0 * nFormants), maximumFrequency, halfdt_window, 1, preemphasisFrequency, 50.0);
@@ -401,4 +512,12 @@ autoFormant Sound_to_Formant_willems (Sound me, double dt, double nFormants, dou
 	}
 }
 
+autoFormant LongSound_to_Formant_burg (LongSound me, double dt, double nFormants, double maximumFrequency, double halfdt_window, double preemphasisFrequency, double blockDuration) {
+	try {
+		return LongSound_to_Formant_any (me, dt, Melder_iround (2.0 * nFormants), maximumFrequency, halfdt_window, 1, preemphasisFrequency, 50.0, blockDuration);
+	} catch (MelderError) {
+		Melder_throw (me, U": formant analysis (Burg) not performed.");
+	}
+}
+
 /* End of file Sound_to_Formant.cpp */
@@ -16,7 +16,7 @@
  * along with this work. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "Sound.h"
+#include "LongSound.h"
 #include "Formant.h"
 
 autoFormant Sound_to_Formant_any (Sound me, double timeStep, integer numberOfPoles, double maximumFrequency,
@@ -37,4 +37,14 @@ autoFormant Sound_to_Formant_keepAll (Sound me, double timeStep, double maximumN
 autoFormant Sound_to_Formant_willems (Sound me, double timeStep, double numberOfFormants,
 	double maximumFormantFrequency, double windowLength, double preemphasisFrequency);
 
+autoFormant LongSound_to_Formant_any (LongSound me, double timeStep, integer numberOfPoles, double maximumFrequency,
+	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin, double blockDuration);
+autoFormant LongSound_to_Formant_burg (LongSound me, double timeStep, double maximumNumberOfFormants,
+	double maximumFormantFrequency, double windowLength, double preemphasisFrequency, double blockDuration);
+/*
+	Parselmouth: the same analyses, reading blocks of about 'blockDuration' seconds of frames from the file.
+	Every block is resampled separately, so the results are close to, but not identical with,
+	those of Sound_to_Formant_any on the whole file (unless no resampling is needed).
+*/
+
 /* End of file Sound_to_Formant.h */
@@ -27,22 +27,46 @@
 #include "Sound_to_Harmonicity.h"
 #include "Sound_and_LPC.h"
 #include "Sound_and_Spectrum.h"
+#include "NUM2.h"
+#include "MelderThread.h"
 
-static void bandFilter (Spectrum me, double fmid, double bandwidth) {
-	double *re = & my z [1] [0], *im = & my z [2] [0];
-	double fmin = fmid - bandwidth / 2.0, fmax = fmid + bandwidth / 2.0;
-	double twopibybandwidth = 2.0 * NUMpi / bandwidth;
-	for (integer col = 1; col <= my nx; col ++) {
-		double x = my x1 + (col - 1) * my dx;
-		if (x < fmin || x > fmax) {
-			re [col] = 0.0;
-			im [col] = 0.0;
-		} else {
-			double factor = 0.5 + 0.5 * cos (twopibybandwidth * (x - fmid));
-			re [col] *= factor;
-			im [col] *= factor;
-		}
+/*
+	Parselmouth: the band filter of MGS, applied on the fly to the spectrum `re`, `im`,
+	and the result converted to samples as Spectrum_to_Sound does, but into `amp` (at least 2 * re.size - 1 long).
+	Returns the number of samples, which is the size of the Sound that Spectrum_to_Sound would have created.
+*/
+static integer bandFilterToSamples (constVEC const& re, constVEC const& im, double x1, double dx, double xmax,
+	double fmid, double bandwidth, VEC const& amp)
+{
+	const integer nx = re.size;
+	const double fmin = fmid - bandwidth / 2.0, fmax = fmid + bandwidth / 2.0;
+	const double twopibybandwidth = 2.0 * NUMpi / bandwidth;
+	auto filtered = [&] (const constVEC& part, integer col) -> double {
+		const double x = x1 + (col - 1) * dx;
+		if (x < fmin || x > fmax)
+			return 0.0;
+		const double factor = 0.5 + 0.5 * cos (twopibybandwidth * (x - fmid));
+		return part [col] * factor;
+	};
+	const double lastFrequency = x1 + (nx - 1) * dx;
+	const double imLast = filtered (im, nx);
+	const bool originalNumberOfSamplesProbablyOdd = ( imLast != 0.0 || xmax - lastFrequency > 0.25 * dx );
+	const integer numberOfSamples = 2 * nx - ( originalNumberOfSamplesProbablyOdd ? 1 : 2 );
+	const double scaling = dx;
+	amp [1] = filtered (re, 1) * scaling;
+	for (integer i = 2; i < nx; i ++) {
+		amp [i + i - 1] = filtered (re, i) * scaling;
+		amp [i + i] = filtered (im, i) * scaling;
 	}
+	if (originalNumberOfSamplesProbablyOdd) {
+		amp [numberOfSamples] = filtered (re, nx) * scaling;
+		if (numberOfSamples > 1)
+			amp [2] = imLast * scaling;
+	} else {
+		amp [2] = filtered (re, nx) * scaling;
+	}
+	NUMrealft (amp.part (1, numberOfSamples), -1);
+	return numberOfSamples;
 }
 
 autoMatrix Sound_to_Harmonicity_GNE (Sound me,
@@ -52,11 +76,6 @@ autoMatrix Sound_to_Harmonicity_GNE (Sound me,
 	double step)   // 80 Hz
 {
 	try {
-		autoSound envelope [1+100];
-		integer nenvelopes = Melder_ifloor ((fmax - fmin) / step);
-		for (integer ienvelope = 1; ienvelope <= 100; ienvelope ++)
-			Melder_assert (! envelope [ienvelope].get());
-
 		/*
 		 * Step 1: down-sampling to 10 kHz,
 		 * in order to be able to flatten the spectrum
@@ -81,67 +100,132 @@ autoMatrix Sound_to_Harmonicity_GNE (Sound me,
 		autoLPC lpc = Sound_to_LPC_autocorrelation (original10k.get(), 13, 30e-3, 10e-3, 1e9);
 		autoSound flat = LPC_Sound_filterInverse (lpc.get(), original10k.get());
 		autoSpectrum flatSpectrum = Sound_to_Spectrum (flat.get(), true);
-		autoSpectrum hilbertSpectrum = Data_copy (flatSpectrum.get());
-		for (integer col = 1; col <= hilbertSpectrum -> nx; col ++) {
-			hilbertSpectrum -> z [1] [col] = flatSpectrum -> z [2] [col];
-			hilbertSpectrum -> z [2] [col] = - flatSpectrum -> z [1] [col];
-		}
-		double fmid = fmin;
-		integer ienvelope = 1;
+		/*
+			The spectrum of the Hilbert transform.
+		*/
+		autoVEC hilbertRe = copy_VEC (flatSpectrum -> z.row (2));
+		autoVEC hilbertIm = raw_VEC (flatSpectrum -> nx);
+		for (integer col = 1; col <= flatSpectrum -> nx; col ++)
+			hilbertIm [col] = - flatSpectrum -> z [1] [col];
+
 		autoMelderMonitor monitor (U"Computing Hilbert envelopes...");
-		while (fmid <= fmax) {
-			/*
-			 * Step 3: calculate Hilbert envelopes of bands.
-			 */
-			autoSpectrum bandSpectrum = Data_copy (flatSpectrum.get());
-			autoSpectrum hilbertBandSpectrum = Data_copy (hilbertSpectrum.get());
-			/*
-			 * 3a: Filter both the spectrum of the original flat sound and its Hilbert transform.
-			 */
-			bandFilter (bandSpectrum.get(), fmid, bandwidth);
-			bandFilter (hilbertBandSpectrum.get(), fmid, bandwidth);
-			/*
-			 * 3b: Create both the band-filtered flat sound and its Hilbert transform.
-			 */
-			autoSound band = Spectrum_to_Sound (bandSpectrum.get());
-			/*if (graphics) {
-				Graphics_beginMovieFrame (graphics, & Melder_WHITE);
-				Spectrum_draw (bandSpectrum, graphics, 0, 5000, 0, 0, true);
-				Graphics_endMovieFrame (graphics, 0.0);
-			}*/
-			Melder_monitor (ienvelope / (nenvelopes + 1.0), U"Computing Hilbert envelope ", ienvelope, U"...");
-			autoSound hilbertBand = Spectrum_to_Sound (hilbertBandSpectrum.get());
-			envelope [ienvelope] = Sound_extractPart (band.get(), 0, duration, kSound_windowShape::RECTANGULAR, 1.0, true);
-			/*
-			 * 3c: Compute the Hilbert envelope of the band-passed flat signal.
-			 */
-			for (integer col = 1; col <= envelope [ienvelope] -> nx; col ++) {
-				double self = envelope [ienvelope] -> z [1] [col], other = hilbertBand -> z [1] [col];
-				envelope [ienvelope] -> z [1] [col] = hypot (self, other);
+		autoVEC bandCentres = raw_VEC (0);
+		for (double fmid = fmin; fmid <= fmax; fmid += step)
+			bandCentres. insert (bandCentres.size + 1, fmid);
+		const integer nenvelopes = bandCentres.size;
+
+		/*
+			The envelopes are the part from 0 to `duration` of the band-filtered flat sound
+			(cf. Sound_extractPart with preserved times; the sound starts at time 0).
+		*/
+		const integer maximumNumberOfSamples = 2 * flatSpectrum -> nx - 1;
+		const double bandSamplingFrequency = ( 2 * flatSpectrum -> nx - 2 ) * flatSpectrum -> dx;
+		const double bandDx = 1.0 / bandSamplingFrequency, bandX1 = 0.5 / bandSamplingFrequency;
+		const integer itmin = 1 + Melder_iceiling ((0.0 - bandX1) / bandDx);
+		const integer itmax = 1 + Melder_ifloor   ((duration - bandX1) / bandDx);
+		Melder_require (itmax >= itmin,
+			U"Extracted Sound would contain no samples.");
+		const integer numberOfEnvelopeSamples = itmax - itmin + 1;
+		autoMAT envelopes = raw_MAT (nenvelopes, numberOfEnvelopeSamples);
+
+		/*
+			Step 3: calculate Hilbert envelopes of bands, in parallel.
+			Parselmouth: each thread filters the flat spectrum and its Hilbert transform into its own buffers.
+		*/
+		const integer numberOfThreads = MelderThread_getNumberOfThreadsForItems (nenvelopes, 1);
+		autoMAT bandBuffers = raw_MAT (2 * numberOfThreads, maximumNumberOfSamples);
+		MelderThread_runChunks (nenvelopes, numberOfThreads,
+			[&] (integer firstEnvelope, integer lastEnvelope, integer ithread) {
+				const VEC band = bandBuffers.row (2 * ithread - 1), hilbertBand = bandBuffers.row (2 * ithread);
+				for (integer ienvelope = firstEnvelope; ienvelope <= lastEnvelope; ienvelope ++) {
+					/*
+						3a, 3b: filter both the spectrum of the original flat sound and its Hilbert transform,
+						and create both the band-filtered flat sound and its Hilbert transform.
+					*/
+					const integer numberOfBandSamples = bandFilterToSamples (flatSpectrum -> z.row (1), flatSpectrum -> z.row (2),
+							flatSpectrum -> x1, flatSpectrum -> dx, flatSpectrum -> xmax, bandCentres [ienvelope], bandwidth, band);
+					Melder_assert (numberOfBandSamples == 2 * flatSpectrum -> nx - 2);
+					const integer numberOfHilbertSamples = bandFilterToSamples (hilbertRe.get(), hilbertIm.get(),
+							flatSpectrum -> x1, flatSpectrum -> dx, flatSpectrum -> xmax, bandCentres [ienvelope], bandwidth, hilbertBand);
+					/*
+						3c: Compute the Hilbert envelope of the band-passed flat signal.
+					*/
+					const VEC envelope = envelopes.row (ienvelope);
+					for (integer col = 1; col <= numberOfEnvelopeSamples; col ++) {
+						const integer iband = itmin - 1 + col;
+						const double self = ( iband >= 1 && iband <= numberOfBandSamples ? band [iband] : 0.0 );
+						const double other = ( col <= numberOfHilbertSamples ? hilbertBand [col] : 0.0 );
+						envelope [col] = hypot (self, other);
+					}
+					centre_VEC_inout (envelope);
+				}
 			}
-			Vector_subtractMean (envelope [ienvelope].get());
-			/*
-			 * Next band.
-			 */
-			fmid += step;
-			ienvelope += 1;
-		}
+		);
 
 		/*
 		 * Step 4: crosscorrelation
+		 * Parselmouth: the normalized cross-correlations between -0.31 and +0.31 ms of Sounds_crossCorrelate_short,
+		 * summed for all pairs of a row in blocks of samples, such that the row's envelope stays in the cache.
 		 */
-		nenvelopes = ienvelope - 1;
-		autoMatrix cc = Matrix_createSimple (nenvelopes, nenvelopes);
-		for (integer row = 2; row <= nenvelopes; row ++) {
-			for (integer col = 1; col <= row - 1; col ++) {
-				autoSound crossCorrelation = Sounds_crossCorrelate_short (envelope [row].get(), envelope [col].get(), -3.1e-4, 3.1e-4, true);
-				/*
-				 * Step 5: the maximum of each correlation function
-				 */
-				double ccmax = Vector_getMaximum (crossCorrelation.get(), 0.0, 0.0, kVector_peakInterpolation :: NONE);
-				cc -> z [row] [col] = ccmax;
+		Melder_monitor (0.9, U"Cross-correlating Hilbert envelopes...");
+		const double dt = bandDx;
+		const integer i1 = Melder_iceiling (-3.1e-4 / dt);
+		const integer i2 = Melder_ifloor   (3.1e-4 / dt);
+		const integer numberOfLags = i2 - i1 + 1;
+		Melder_require (numberOfLags >= 1,
+			U"Window too small.");
+		autoVEC rootPowers = raw_VEC (nenvelopes);
+		autoBOOLVEC hasPower = raw_BOOLVEC (nenvelopes);
+		for (integer ienvelope = 1; ienvelope <= nenvelopes; ienvelope ++) {
+			longdouble power = 0.0;
+			for (integer i = 1; i <= numberOfEnvelopeSamples; i ++) {
+				const double value = envelopes [ienvelope] [i];
+				power += value * value;
 			}
+			rootPowers [ienvelope] = sqrt (double (power));
+			hasPower [ienvelope] = ( power != 0.0 );
 		}
+		autoMatrix cc = Matrix_createSimple (nenvelopes, nenvelopes);
+		constexpr integer numberOfSamplesPerBlock = 2048;
+		const integer nx = numberOfEnvelopeSamples;
+		const integer numberOfCorrelationThreads = std::min (std::max (nenvelopes - 1, integer (1)),
+				MelderThread_getNumberOfThreadsForItems (nenvelopes * (nenvelopes - 1) / 2 * numberOfLags * nx, 1000000));
+		autoMAT sums = raw_MAT (numberOfCorrelationThreads, std::max (nenvelopes - 1, integer (1)) * numberOfLags);
+		MelderThread_runChunks (nenvelopes - 1, numberOfCorrelationThreads,
+			[&] (integer firstItem, integer lastItem, integer ithread) {
+				const VEC rowSums = sums.row (ithread);
+				for (integer row = firstItem + 1; row <= lastItem + 1; row ++) {
+					const constVEC x = envelopes.row (row);
+					rowSums.part (1, (row - 1) * numberOfLags)  <<=  0.0;
+					for (integer firstSample = 1; firstSample <= nx; firstSample += numberOfSamplesPerBlock) {
+						const integer lastSample = std::min (firstSample + numberOfSamplesPerBlock - 1, nx);
+						for (integer col = 1; col <= row - 1; col ++) {
+							const constVEC y = envelopes.row (col);
+							double *lagSums = & rowSums [(col - 1) * numberOfLags + 1];
+							for (integer ilag = 0; ilag < numberOfLags; ilag ++) {
+								const integer di = i1 + ilag;
+								const integer from = std::max (firstSample, 1 - di), to = std::min (lastSample, nx - di);
+								double sum = lagSums [ilag];
+								for (integer ime = from; ime <= to; ime ++)
+									sum += x [ime] * y [ime + di];
+								lagSums [ilag] = sum;
+							}
+						}
+					}
+					/*
+						Step 5: the maximum of each correlation function
+					*/
+					for (integer col = 1; col <= row - 1; col ++) {
+						const double *lagSums = & rowSums [(col - 1) * numberOfLags + 1];
+						const double factor = ( hasPower [row] && hasPower [col] ? 1.0 / (rootPowers [row] * rootPowers [col]) : 1.0 );
+						double ccmax = lagSums [0] * factor;
+						for (integer ilag = 1; ilag < numberOfLags; ilag ++)
+							ccmax = std::max (ccmax, lagSums [ilag] * factor);
+						cc -> z [row] [col] = ccmax;
+					}
+				}
+			}
+		);
 
 		/*
 		 * Step 6: maximum of the maxima, ignoring those too close to the diagonal.
@@ -16,7 +16,7 @@
  * along with this work. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "Sound.h"
+#include "LongSound.h"
 #include "Intensity.h"
 #include "IntensityTier.h"
 
@@ -45,6 +45,12 @@ autoIntensity Sound_to_Intensity (Sound me, double pitchFloor, double timeStep,
 		actual window duration = 64 ms;
 */
 
+autoIntensity LongSound_to_Intensity (LongSound me, double pitchFloor, double timeStep, bool subtractMean, double blockDuration);
+/*
+	Parselmouth: the same analysis, reading blocks of about 'blockDuration' seconds of frames from the file;
+	the result is identical to that of Sound_to_Intensity on the whole file.
+*/
+
 autoIntensityTier Sound_to_IntensityTier (Sound me, double pitchFloor, double timeStep, bool subtractMean);
 
 /* End of file Sound_to_Intensity.h */
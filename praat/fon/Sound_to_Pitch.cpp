@@ -37,20 +37,33 @@
 #include "MelderThread.h"
 #include "Sound_and_Spectrum.h"
 
+#include <vector>
+
 #define AC_HANNING  0
 #define AC_GAUSS  1
 #define FCC_NORMAL  2
 #define FCC_ACCURATE  3
 
-static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
-	double pitchFloor, int maxnCandidates, int method, double voicingThreshold, double octaveCost,
-	NUMfft_Table fftTable, double dt_window, integer nsamp_window, integer halfnsamp_window,
-	integer maximumLag, integer nsampFFT, integer nsamp_period, integer halfnsamp_period,
-	integer brent_ixmax, integer brent_depth, double globalPeak,
-	MAT const& frame, VEC const& ac, VEC const& window, VEC const& windowR,
-	double *r, INTVEC const& imax, VEC const& localMean)
+/*
+	Parselmouth: 'me' can be a part of a longer Sound 'whole' (e.g. a block of a LongSound), containing the samples
+	sampleOffset + 1 .. sampleOffset + my nx of 'whole' and all samples that the frame needs;
+	sample numbers are computed in 'whole', such that the frame is analysed exactly as in 'whole'.
+*/
+
+/*
+	Parselmouth: the analysis of a frame falls apart into three steps, so that the autocorrelation methods
+	can transform the windowed frames of several frames at once (see Sound_into_PitchFrames_ac):
+	- Sound_into_PitchFrame_window puts the samples around t, minus the local mean, into the rows of 'frame'
+	  (one row per channel; windowed and zero-padded for the autocorrelation methods),
+	  sets the intensity of the frame, and returns the local peak;
+	- the correlation of the frame is computed into the array 'r';
+	- PitchFrame_findCandidates registers the maxima of 'r' as the candidates of the frame.
+*/
+static double Sound_into_PitchFrame_window (Sound me, constSampled whole, integer sampleOffset, Pitch_Frame pitchFrame, double t,
+	int method, integer nsamp_window, integer halfnsamp_window, integer nsampFFT, integer nsamp_period, integer halfnsamp_period,
+	double globalPeak, MAT const& frame, VEC const& window, VEC const& localMean)
 {
-	integer leftSample = Sampled_xToLowIndex (me, t), rightSample = leftSample + 1;
+	integer leftSample = Sampled_xToLowIndex (whole, t) - sampleOffset, rightSample = leftSample + 1;
 	integer startSample, endSample;
 
 	for (integer channel = 1; channel <= my ny; channel ++) {
@@ -101,6 +114,50 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 		}
 	}
 	pitchFrame -> intensity = ( localPeak > globalPeak ? 1.0 : localPeak / globalPeak );
+	return localPeak;
+}
+
+/*
+	Parselmouth: the autocorrelation methods. The FFT of the autocorrelation is the power spectrum;
+	the rows of 'spectra' are the complex spectra of the (windowed) channels of the frame.
+*/
+static void PitchFrame_powerSpectrum (constMATVU const& spectra, VEC const& ac) {
+	const integer nsampFFT = ac.size;
+	for (integer i = 1; i <= nsampFFT; i ++)
+		ac [i] = 0.0;
+	for (integer channel = 1; channel <= spectra.nrow; channel ++) {
+		ac [1] += spectra [channel] [1] * spectra [channel] [1];   // DC component
+		for (integer i = 2; i < nsampFFT; i += 2)
+			ac [i] += spectra [channel] [i] * spectra [channel] [i] + spectra [channel] [i+1] * spectra [channel] [i+1];   // power spectrum
+		ac [nsampFFT] += spectra [channel] [nsampFFT] * spectra [channel] [nsampFFT];   // Nyquist frequency
+	}
+}
+
+/*
+	Parselmouth: the autocorrelation methods. Normalize the autocorrelation 'ac' (the inverse FFT of the power spectrum)
+	to the value with zero lag, and divide it by the normalized autocorrelation of the window.
+*/
+static void PitchFrame_normalizeAutocorrelation (constVEC const& ac, constVEC const& windowR, integer brent_ixmax, double *r) {
+	r [0] = 1.0;
+	for (integer i = 1; i <= brent_ixmax; i ++)
+		r [- i] = r [i] = ac [i + 1] / (ac [1] * windowR [i + 1]);
+}
+
+static void PitchFrame_findCandidates (Pitch_Frame pitchFrame, double samplingPeriod, double localPeak,
+	double pitchFloor, int maxnCandidates, int method, double voicingThreshold, double octaveCost,
+	integer maximumLag, integer brent_ixmax, integer brent_depth, double *r, INTVEC const& imax);
+
+static void Sound_into_PitchFrame (Sound me, constSampled whole, integer sampleOffset, Pitch_Frame pitchFrame, double t,
+	double pitchFloor, int maxnCandidates, int method, double voicingThreshold, double octaveCost,
+	NUMfft_Table fftTable, double dt_window, integer nsamp_window, integer halfnsamp_window,
+	integer maximumLag, integer nsampFFT, integer nsamp_period, integer halfnsamp_period,
+	integer brent_ixmax, integer brent_depth, double globalPeak,
+	MAT const& frame, VEC const& ac, VEC const& span, VEC const& window, VEC const& windowR,
+	double *r, INTVEC const& imax, VEC const& localMean)
+{
+	const double localPeak = Sound_into_PitchFrame_window (me, whole, sampleOffset, pitchFrame, t,
+			method, nsamp_window, halfnsamp_window, nsampFFT, nsamp_period, halfnsamp_period, globalPeak, frame, window, localMean);
+	integer startSample;
 
 	/*
 		Compute the correlation into the array 'r'.
@@ -108,12 +165,12 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 	if (method >= FCC_NORMAL) {
 		const double startTime = t - 0.5 * (1.0 / pitchFloor + dt_window);
 		integer localSpan = maximumLag + nsamp_window;
-		if ((startSample = Sampled_xToLowIndex (me, startTime)) < 1)
+		if ((startSample = Sampled_xToLowIndex (whole, startTime)) < 1)
 			startSample = 1;
-		if (localSpan > my nx + 1 - startSample)
-			localSpan = my nx + 1 - startSample;
+		if (localSpan > whole -> nx + 1 - startSample)
+			localSpan = whole -> nx + 1 - startSample;
 		const integer localMaximumLag = localSpan - nsamp_window;
-		const integer offset = startSample - 1;
+		const integer offset = startSample - 1 - sampleOffset;
 		longdouble sumx2 = 0.0;   // sum of squares
 		for (integer channel = 1; channel <= my ny; channel ++) {
 			const double * const amp = & my z [channel] [0] + offset;
@@ -124,7 +181,47 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 		}
 		longdouble sumy2 = sumx2;   // at zero lag, these are still equal
 		r [0] = 1.0;
-		for (integer i = 1; i <= localMaximumLag; i ++) {
+		if (nsampFFT > 0) {
+			/*
+				Parselmouth: for all but the shortest windows, compute the cross-correlation of the window
+				with the whole span in one go, as the inverse FFT of the cross spectrum;
+				the zero padding up to nsampFFT >= maximumLag + nsamp_window prevents any circular wrap-around.
+				The normalization by the running energies is the same as in the direct computation below.
+			*/
+			for (integer i = 1; i <= nsampFFT; i ++)
+				ac [i] = 0.0;
+			for (integer channel = 1; channel <= my ny; channel ++) {
+				const double * const amp = & my z [channel] [0] + offset;
+				const VEC x = frame.row (channel);
+				for (integer j = 1; j <= nsamp_window; j ++)
+					x [j] = amp [j] - localMean [channel];
+				for (integer j = nsamp_window + 1; j <= nsampFFT; j ++)
+					x [j] = 0.0;
+				for (integer j = 1; j <= localSpan; j ++)
+					span [j] = amp [j] - localMean [channel];
+				for (integer j = localSpan + 1; j <= nsampFFT; j ++)
+					span [j] = 0.0;
+				NUMfft_forward (fftTable, x);
+				NUMfft_forward (fftTable, span);
+				ac [1] += x [1] * span [1];   // DC component
+				for (integer i = 2; i < nsampFFT; i += 2) {   // conjugate of window spectrum times span spectrum
+					ac [i] += x [i] * span [i] + x [i + 1] * span [i + 1];
+					ac [i + 1] += x [i] * span [i + 1] - x [i + 1] * span [i];
+				}
+				ac [nsampFFT] += x [nsampFFT] * span [nsampFFT];   // Nyquist frequency
+			}
+			NUMfft_backward (fftTable, ac);   // cross-correlation, times nsampFFT
+			for (integer i = 1; i <= localMaximumLag; i ++) {
+				for (integer channel = 1; channel <= my ny; channel ++) {
+					const double * const amp = & my z [channel] [0] + offset;
+					const double y0 = amp [i] - localMean [channel];
+					const double yZ = amp [i + nsamp_window] - localMean [channel];
+					sumy2 += yZ * yZ - y0 * y0;
+				}
+				const double product = ac [i + 1] / nsampFFT;
+				r [- i] = r [i] = product / sqrt ((double) sumx2 * (double) sumy2);
+			}
+		} else for (integer i = 1; i <= localMaximumLag; i ++) {
 			longdouble product = 0.0;
 			for (integer channel = 1; channel <= my ny; channel ++) {
 				const double * const amp = & my z [channel] [0] + offset;
@@ -140,30 +237,20 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 			r [- i] = r [i] = (double) product / sqrt ((double) sumx2 * (double) sumy2);
 		}
 	} else {
-
-		/*
-			The FFT of the autocorrelation is the power spectrum.
-		*/
-		for (integer i = 1; i <= nsampFFT; i ++)
-			ac [i] = 0.0;
-		for (integer channel = 1; channel <= my ny; channel ++) {
-			NUMfft_forward (fftTable, VEC (& frame [channel] [1], fftTable->n));   // complex spectrum
-			ac [1] += frame [channel] [1] * frame [channel] [1];   // DC component
-			for (integer i = 2; i < nsampFFT; i += 2)
-				ac [i] += frame [channel] [i] * frame [channel] [i] + frame [channel] [i+1] * frame [channel] [i+1];   // power spectrum
-			ac [nsampFFT] += frame [channel] [nsampFFT] * frame [channel] [nsampFFT];   // Nyquist frequency
-		}
+		NUMfft_forward (fftTable, frame);   // complex spectra of the channels
+		PitchFrame_powerSpectrum (frame, ac);
 		NUMfft_backward (fftTable, ac);   // autocorrelation
-
-		/*
-			Normalize the autocorrelation to the value with zero lag,
-			and divide it by the normalized autocorrelation of the window.
-		*/
-		r [0] = 1.0;
-		for (integer i = 1; i <= brent_ixmax; i ++)
-			r [- i] = r [i] = ac [i + 1] / (ac [1] * windowR [i + 1]);
+		PitchFrame_normalizeAutocorrelation (ac, windowR, brent_ixmax, r);
 	}
 
+	PitchFrame_findCandidates (pitchFrame, my dx, localPeak, pitchFloor, maxnCandidates, method, voicingThreshold, octaveCost,
+			maximumLag, brent_ixmax, brent_depth, r, imax);
+}
+
+static void PitchFrame_findCandidates (Pitch_Frame pitchFrame, double samplingPeriod, double localPeak,
+	double pitchFloor, int maxnCandidates, int method, double voicingThreshold, double octaveCost,
+	integer maximumLag, integer brent_ixmax, integer brent_depth, double *r, INTVEC const& imax)
+{
 	/*
 		Register the first candidate, which is always present: voicelessness.
 	*/
@@ -194,10 +281,10 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 			and sin(x)/x interpolation to compute the strength of this frequency.
 		*/
 		const double dr = 0.5 * (r [i+1] - r [i-1]), d2r = 2.0 * r [i] - r [i-1] - r [i+1];
-		const double frequencyOfMaximum = 1.0 / my dx / (i + dr / d2r);
+		const double frequencyOfMaximum = 1.0 / samplingPeriod / (i + dr / d2r);
 		const integer offset = - brent_ixmax - 1;
 		double strengthOfMaximum = /* method & 1 ? */
-			NUM_interpolate_sinc (constVEC (& r [offset + 1], brent_ixmax - offset), 1.0 / my dx / frequencyOfMaximum - offset, 30)
+			NUM_interpolate_sinc (constVEC (& r [offset + 1], brent_ixmax - offset), 1.0 / samplingPeriod / frequencyOfMaximum - offset, 30)
 			/* : r [i] + 0.5 * dr * dr / d2r */;
 		/*
 			High values due to short windows are to be reflected around 1.
@@ -245,13 +332,13 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 		Second pass: for extra precision, maximize sin(x)/x interpolation ('sinc').
 	*/
 	for (integer i = 2; i <= pitchFrame -> nCandidates; i ++) {
-		if (method != AC_HANNING || pitchFrame -> candidates [i]. frequency > 0.0 / my dx) {
+		if (method != AC_HANNING || pitchFrame -> candidates [i]. frequency > 0.0 / samplingPeriod) {
 			double xmid, ymid;
 			const integer offset = - brent_ixmax - 1;
 			ymid = NUMimproveMaximum (constVEC (& r [offset + 1], brent_ixmax - offset), imax [i] - offset,
-					pitchFrame -> candidates [i]. frequency > 0.3 / my dx ? NUM_PEAK_INTERPOLATE_SINC700 : brent_depth, & xmid);
+					pitchFrame -> candidates [i]. frequency > 0.3 / samplingPeriod ? NUM_PEAK_INTERPOLATE_SINC700 : brent_depth, & xmid);
 			xmid += offset;
-			pitchFrame -> candidates [i]. frequency = 1.0 / my dx / xmid;
+			pitchFrame -> candidates [i]. frequency = 1.0 / samplingPeriod / xmid;
 			if (ymid > 1.0)
 				ymid = 1.0 / ymid;
 			pitchFrame -> candidates [i]. strength = ymid;
@@ -259,36 +346,259 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 	}
 }
 
-Thing_define (Sound_into_Pitch_Args, Thing) { public:
-	Sound sound;
-	Pitch pitch;
-	integer firstFrame, lastFrame;
-	double pitchFloor;
-	int maxnCandidates, method;
-	double voicingThreshold, octaveCost, dt_window;
-	integer nsamp_window, halfnsamp_window, maximumLag, nsampFFT, nsamp_period, halfnsamp_period, brent_ixmax, brent_depth;
-	double globalPeak;
-	VEC window, windowR;
-	bool isMainThread;
-	volatile int *cancelled;
-	autoNUMfft_Table fftTable;
-	autoMAT frame;
-	autoVEC ac, rbuffer, localMean;
-	double *r;
-	autoINTVEC imax;
-};
-
 Thing_implement (Sound_into_Pitch_Args, Thing, 0);
 
+/*
+	Parselmouth: the analysis settings of Sound_to_Pitch_any that do not depend on the frames,
+	computed once for all threads of Sound_to_Pitch_any, or for the whole stream of a PitchTracker.
+	The windows are stored in 'out_window' and 'out_windowR', which should outlive 'me'.
+*/
+static void Sound_into_Pitch_Args_initAnalysis (Sound_into_Pitch_Args me, double samplingPeriod, double duration,
+	int method, double periodsPerWindow, double pitchFloor, double pitchCeiling, integer maxnCandidates,
+	double voicingThreshold, double octaveCost, autoVEC *out_window, autoVEC *out_windowR)
+{
+	double interpolation_depth;
+	integer brent_depth;
+
+	Melder_assert (maxnCandidates >= 2);
+	Melder_assert (method >= AC_HANNING && method <= FCC_ACCURATE);
+
+	if (maxnCandidates < pitchCeiling / pitchFloor)
+		maxnCandidates = Melder_ifloor (pitchCeiling / pitchFloor);
+
+	switch (method) {
+		case AC_HANNING:
+			brent_depth = NUM_PEAK_INTERPOLATE_SINC70;
+			interpolation_depth = 0.5;
+			break;
+		case AC_GAUSS:
+			periodsPerWindow *= 2;   // because Gaussian window is twice as long
+			brent_depth = NUM_PEAK_INTERPOLATE_SINC700;
+			interpolation_depth = 0.25;   // because Gaussian window is twice as long
+			break;
+		case FCC_NORMAL:
+			brent_depth = NUM_PEAK_INTERPOLATE_SINC70;
+			interpolation_depth = 1.0;
+			break;
+		case FCC_ACCURATE:
+			brent_depth = NUM_PEAK_INTERPOLATE_SINC700;
+			interpolation_depth = 1.0;
+			break;
+	}
+	if (duration > 0.0 && pitchFloor < periodsPerWindow / duration)   // a stream has no duration
+		Melder_throw (U"To analyse this Sound, “pitch floor” must not be less than ", periodsPerWindow / duration, U" Hz.");
+
+	/*
+		Determine the number of samples in the longest period.
+		We need this to compute the local mean of the sound (looking one period in both directions),
+		and to compute the local peak of the sound (looking half a period in both directions).
+	*/
+	const integer nsamp_period = Melder_ifloor (1.0 / samplingPeriod / pitchFloor);
+	const integer halfnsamp_period = nsamp_period / 2 + 1;
+
+	Melder_clipRight (& pitchCeiling, 0.5 / samplingPeriod);
+
+	/*
+		Determine window duration in seconds and in samples.
+	*/
+	const double dt_window = periodsPerWindow / pitchFloor;
+	integer nsamp_window = Melder_ifloor (dt_window / samplingPeriod);
+	const integer halfnsamp_window = nsamp_window / 2 - 1;
+	if (halfnsamp_window < 2)
+		Melder_throw (U"Analysis window too short.");
+	nsamp_window = halfnsamp_window * 2;
+
+	/*
+	 * Determine the maximum lag.
+	 */
+	const integer maximumLag = std::min (Melder_ifloor (nsamp_window / periodsPerWindow) + 2, nsamp_window);
+
+	integer nsampFFT;
+	autoVEC window, windowR;
+	if (method >= FCC_NORMAL) {   // for cross-correlation analysis
+
+		/*
+			Parselmouth: the cross-correlation over all lags costs nsamp_window * maximumLag operations per channel
+			if computed directly, and about three real FFTs of nsampFFT samples if computed via the cross spectrum.
+			Only very short windows (low sampling frequencies, high pitch floors) are faster the direct way;
+			debug option 58 forces the direct computation, so that the two can be compared.
+		*/
+		nsampFFT = 1;
+		while (nsampFFT < maximumLag + nsamp_window)
+			nsampFFT *= 2;
+		if ((double) nsamp_window * maximumLag < 3.0 * nsampFFT * NUMlog2 (nsampFFT) || Melder_debug == 58)
+			nsampFFT = 0;
+
+	} else {   // for autocorrelation analysis
+
+		/*
+			Compute the number of samples needed for doing FFT.
+			To avoid edge effects, we have to append zeroes to the window.
+			The maximum lag considered for maxima is maximumLag.
+			The maximum lag used in interpolation is nsamp_window * interpolation_depth.
+		*/
+		nsampFFT = 1;
+		while (nsampFFT < nsamp_window * (1 + interpolation_depth))
+			nsampFFT *= 2;
+
+		/*
+			Create buffers for autocorrelation analysis.
+		*/
+		autoNUMfft_Table fftTable;
+		windowR. resize (nsampFFT);
+		window. resize (nsamp_window);
+		NUMfft_Table_init (& fftTable, nsampFFT);
+
+		/*
+			A Gaussian or Hanning window is applied against phase effects.
+			The Hanning window is 2 to 5 dB better for 3 periods/window.
+			The Gaussian window is 25 to 29 dB better for 6 periods/window.
+		*/
+		if (method == AC_GAUSS) {   // Gaussian window
+			double imid = 0.5 * (nsamp_window + 1), edge = exp (-12.0);
+			for (integer i = 1; i <= nsamp_window; i ++)
+				window [i] = (exp (-48.0 * (i - imid) * (i - imid) /
+						(nsamp_window + 1) / (nsamp_window + 1)) - edge) / (1.0 - edge);
+		} else {   // Hanning window
+			for (integer i = 1; i <= nsamp_window; i ++)
+				window [i] = 0.5 - 0.5 * cos (i * 2 * NUMpi / (nsamp_window + 1));
+		}
+
+		/*
+			Compute the normalized autocorrelation of the window.
+		*/
+		for (integer i = 1; i <= nsamp_window; i ++)
+			windowR [i] = window [i];
+		NUMfft_forward (& fftTable, windowR.get());
+		windowR [1] *= windowR [1];   // DC component
+		for (integer i = 2; i < nsampFFT; i += 2) {
+			windowR [i] = windowR [i] * windowR [i] + windowR [i + 1] * windowR [i + 1];
+			windowR [i + 1] = 0.0;   // power spectrum: square and zero
+		}
+		windowR [nsampFFT] *= windowR [nsampFFT];   // Nyquist frequency
+		NUMfft_backward (& fftTable, windowR.get());   // autocorrelation
+		for (integer i = 2; i <= nsamp_window; i ++)
+			windowR [i] /= windowR [1];   // normalize
+		windowR [1] = 1.0;   // normalize
+	}
+
+	my pitchFloor = pitchFloor;
+	my pitchCeiling = pitchCeiling;
+	my maxnCandidates = maxnCandidates;
+	my method = method;
+	my voicingThreshold = voicingThreshold;
+	my octaveCost = octaveCost;
+	my dt_window = dt_window;
+	my nsamp_window = nsamp_window;
+	my halfnsamp_window = halfnsamp_window;
+	my maximumLag = maximumLag;
+	my nsampFFT = nsampFFT;
+	my nsamp_period = nsamp_period;
+	my halfnsamp_period = halfnsamp_period;
+	my brent_ixmax = Melder_ifloor (nsamp_window * interpolation_depth);
+	my brent_depth = brent_depth;
+	my window = window.get();
+	my windowR = windowR.get();
+	*out_window = window.move();
+	*out_windowR = windowR.move();
+}
+
+/*
+	Parselmouth: the autocorrelation methods analyse the frames of a thread in batches of this many frames,
+	whose windowed channels are transformed in one call of NUMfft_forward, and whose autocorrelations
+	in one call of NUMfft_backward (see NUMfft_forward with a matrix of frames in NUM2.h).
+*/
+static constexpr integer Sound_into_Pitch_framesPerBatch = 8;
+
+/*
+	Parselmouth: copy the analysis settings of 'thee' into 'me', and create the scratch memory for analysing frames.
+*/
+static void Sound_into_Pitch_Args_initBuffers (Sound_into_Pitch_Args me, constSound_into_Pitch_Args thee, integer numberOfChannels) {
+	my pitchFloor = thy pitchFloor;
+	my pitchCeiling = thy pitchCeiling;
+	my maxnCandidates = thy maxnCandidates;
+	my method = thy method;
+	my voicingThreshold = thy voicingThreshold;
+	my octaveCost = thy octaveCost;
+	my dt_window = thy dt_window;
+	my nsamp_window = thy nsamp_window;
+	my halfnsamp_window = thy halfnsamp_window;
+	my maximumLag = thy maximumLag;
+	my nsampFFT = thy nsampFFT;
+	my nsamp_period = thy nsamp_period;
+	my halfnsamp_period = thy halfnsamp_period;
+	my brent_ixmax = thy brent_ixmax;
+	my brent_depth = thy brent_depth;
+	my window = thy window;
+	my windowR = thy windowR;
+	if (my method >= FCC_NORMAL) {   // cross-correlation
+		if (my nsampFFT > 0) {
+			NUMfft_Table_init (& my fftTable, my nsampFFT);
+			my frame = zero_MAT (numberOfChannels, my nsampFFT);
+			my ac = zero_VEC (my nsampFFT);
+			my span = zero_VEC (my nsampFFT);
+		} else {
+			my frame = zero_MAT (numberOfChannels, my nsamp_window);
+		}
+	} else {   // autocorrelation, in batches of frames
+		NUMfft_Table_init (& my fftTable, my nsampFFT);
+		my frame = zero_MAT (Sound_into_Pitch_framesPerBatch * numberOfChannels, my nsampFFT);
+		my ac = zero_VEC (my nsampFFT);
+		my autocorrelations = zero_MAT (Sound_into_Pitch_framesPerBatch, my nsampFFT);
+		my localPeaks = zero_VEC (Sound_into_Pitch_framesPerBatch);
+	}
+	my rbuffer = zero_VEC (2 * my nsamp_window + 1);
+	my r = & my rbuffer [1 + my nsamp_window];
+	my imax = zero_INTVEC (my maxnCandidates);
+	my localMean = zero_VEC (numberOfChannels);
+}
+
+static void Sound_into_Pitch_analyseFrame (Sound_into_Pitch_Args me, Sound sound, constSampled whole, integer sampleOffset, Pitch_Frame pitchFrame, double t) {
+	Sound_into_PitchFrame (sound, whole, sampleOffset, pitchFrame, t,
+		my pitchFloor, my maxnCandidates, my method, my voicingThreshold, my octaveCost,
+		& my fftTable, my dt_window, my nsamp_window, my halfnsamp_window,
+		my maximumLag, my nsampFFT, my nsamp_period, my halfnsamp_period,
+		my brent_ixmax, my brent_depth, my globalPeak,
+		MAT (& my frame [1] [1], sound -> ny, my frame.ncol), my ac.get(), my span.get(), my window, my windowR,
+		my r, my imax.get(), my localMean.get()
+	);
+}
+
+/*
+	Parselmouth: the analysis of the frames firstFrame .. lastFrame (at most Sound_into_Pitch_framesPerBatch)
+	with an autocorrelation method; every frame gets exactly the same candidates as from Sound_into_PitchFrame.
+*/
+static void Sound_into_Pitch_analyseFrames_ac (Sound_into_Pitch_Args me, integer firstFrame, integer lastFrame) {
+	const integer numberOfChannels = my sound -> ny, numberOfFrames = lastFrame - firstFrame + 1;
+	Melder_assert (numberOfFrames <= Sound_into_Pitch_framesPerBatch);
+	for (integer ibatch = 1; ibatch <= numberOfFrames; ibatch ++) {
+		const integer iframe = firstFrame - 1 + ibatch;
+		const MAT frame (& my frame [(ibatch - 1) * numberOfChannels + 1] [1], numberOfChannels, my nsampFFT);
+		my localPeaks [ibatch] = Sound_into_PitchFrame_window (my sound, my whole, my sampleOffset, & my pitch -> frames [iframe],
+				Sampled_indexToX (my pitch, iframe), my method, my nsamp_window, my halfnsamp_window, my nsampFFT,
+				my nsamp_period, my halfnsamp_period, my globalPeak, frame, my window, my localMean.get());
+	}
+	NUMfft_forward (& my fftTable, my frame.horizontalBand (1, numberOfFrames * numberOfChannels));   // complex spectra
+	for (integer ibatch = 1; ibatch <= numberOfFrames; ibatch ++)
+		PitchFrame_powerSpectrum (my frame.horizontalBand ((ibatch - 1) * numberOfChannels + 1, ibatch * numberOfChannels),
+				my autocorrelations.row (ibatch));
+	NUMfft_backward (& my fftTable, my autocorrelations.horizontalBand (1, numberOfFrames));   // autocorrelations
+	for (integer ibatch = 1; ibatch <= numberOfFrames; ibatch ++) {
+		PitchFrame_normalizeAutocorrelation (my autocorrelations.row (ibatch), my windowR, my brent_ixmax, my r);
+		PitchFrame_findCandidates (& my pitch -> frames [firstFrame - 1 + ibatch], my sound -> dx, my localPeaks [ibatch],
+				my pitchFloor, my maxnCandidates, my method, my voicingThreshold, my octaveCost,
+				my maximumLag, my brent_ixmax, my brent_depth, my r, my imax.get());
+	}
+}
+
 static void Sound_into_Pitch (Sound_into_Pitch_Args me)
 {
-	for (integer iframe = my firstFrame; iframe <= my lastFrame; iframe ++) {
-		const Pitch_Frame pitchFrame = & my pitch -> frames [iframe];
-		const double t = Sampled_indexToX (my pitch, iframe);
+	const integer framesPerStep = ( my method < FCC_NORMAL ? Sound_into_Pitch_framesPerBatch : 1 );
+	for (integer iframe = my firstFrame; iframe <= my lastFrame; iframe += framesPerStep) {
 		if (my isMainThread) {
 			try {
-				Melder_progress (0.1 + 0.8 * (iframe - my firstFrame) / (my lastFrame - my firstFrame),
-					U"Sound to Pitch: analysing ", my lastFrame, U" frames");
+				Melder_progress (0.1 + 0.8 * iframe / my pitch -> nx,
+					U"Sound to Pitch: analysing ", my pitch -> nx, U" frames");
 			} catch (MelderError) {
 				*my cancelled = 1;
 				throw;
@@ -296,15 +606,239 @@ static void Sound_into_Pitch (Sound_into_Pitch_Args me)
 		} else if (*my cancelled) {
 			return;
 		}
-		Sound_into_PitchFrame (my sound, pitchFrame, t,
-			my pitchFloor, my maxnCandidates, my method, my voicingThreshold, my octaveCost,
-			& my fftTable, my dt_window, my nsamp_window, my halfnsamp_window,
-			my maximumLag, my nsampFFT, my nsamp_period, my halfnsamp_period,
-			my brent_ixmax, my brent_depth, my globalPeak,
-			my frame.get(), my ac.get(), my window, my windowR,
-			my r, my imax.get(), my localMean.get()
-		);
+		if (my method < FCC_NORMAL)
+			Sound_into_Pitch_analyseFrames_ac (me, iframe, std::min (iframe + framesPerStep - 1, my lastFrame));
+		else
+			Sound_into_Pitch_analyseFrame (me, my sound, my whole, my sampleOffset, & my pitch -> frames [iframe], Sampled_indexToX (my pitch, iframe));
+	}
+}
+
+/*
+	Parselmouth: the sums of the channels of a LongSound, which PAIRWISE_SUM accumulates lane by lane,
+	such that every channel is summed in exactly the same order as NUMmean sums a row of a Sound.
+	The lanes beyond the last channel stay zero.
+*/
+template <integer numberOfLanes>
+struct LongSound_ChannelSums {
+	longdouble lanes [numberOfLanes];
+	LongSound_ChannelSums (double value = 0.0) {
+		for (integer ilane = 0; ilane < numberOfLanes; ilane ++)
+			lanes [ilane] = value;
+	}
+	void setNumberOfChannels (integer /* numberOfChannels */) { }
+	LongSound_ChannelSums& operator+= (LongSound_ChannelSums const& other) {
+		for (integer ilane = 0; ilane < numberOfLanes; ilane ++)
+			lanes [ilane] += other.lanes [ilane];
+		return *this;
+	}
+};
+
+/*
+	For files with more than 64 channels, as many lanes as there are channels, on the heap;
+	a sum without lanes is zero.
+*/
+template <>
+struct LongSound_ChannelSums <0> {
+	std::vector <longdouble> lanes;
+	LongSound_ChannelSums (double value = 0.0) {
+		Melder_assert (value == 0.0);
+	}
+	void setNumberOfChannels (integer numberOfChannels) {
+		lanes. resize (uinteger (numberOfChannels));
+	}
+	LongSound_ChannelSums& operator+= (LongSound_ChannelSums const& other) {
+		if (lanes. empty ())
+			lanes = other.lanes;
+		else
+			for (uinteger ilane = 0; ilane < other.lanes. size (); ilane ++)
+				lanes [ilane] += other.lanes [ilane];
+		return *this;
+	}
+};
+
+/*
+	Parselmouth: the means and extrema of all channels of a LongSound,
+	in one pass over the file, which is read in blocks of all channels.
+*/
+template <integer numberOfLanes>
+static void LongSound_getMeansAndExtrema (LongSound me, double blockDuration, VEC const& means, VEC const& minima, VEC const& maxima) {
+	Melder_assert (numberOfLanes == 0 || numberOfLanes >= my numberOfChannels);
+	const integer samplesPerBlock = Melder_clipped (1_integer, Melder_ifloor (blockDuration / my dx), my nx);
+	autoMAT block;
+	integer firstSampleInBlock = 1, lastSampleInBlock = 0;
+	auto getSamples = [&] (const integer isample) {
+		if (isample > lastSampleInBlock) {
+			firstSampleInBlock = isample;
+			lastSampleInBlock = std::min (isample + samplesPerBlock - 1, my nx);
+			if (block.ncol != lastSampleInBlock - firstSampleInBlock + 1)
+				block = raw_MAT (my numberOfChannels, lastSampleInBlock - firstSampleInBlock + 1);   // the first or the last block
+			LongSound_readAudioToFloat (me, block.get(), firstSampleInBlock);
+		}
+		LongSound_ChannelSums <numberOfLanes> samples;
+		samples.setNumberOfChannels (my numberOfChannels);
+		for (integer ichan = 1; ichan <= my numberOfChannels; ichan ++) {
+			const double value = block [ichan] [isample - firstSampleInBlock + 1];
+			Melder_clipRight (& minima [ichan], value);
+			Melder_clipLeft (value, & maxima [ichan]);
+			samples.lanes [ichan - 1] = value;
+		}
+		return samples;
+	};
+	PAIRWISE_SUM (
+		LongSound_ChannelSums <numberOfLanes>, sums,
+		integer, my nx,
+		integer isample = 1,
+		getSamples (isample),
+		isample += 1
+	)
+	for (integer ichan = 1; ichan <= my numberOfChannels; ichan ++)
+		means [ichan] = double (sums.lanes [ichan - 1] / my nx);   // as in NUMmean
+}
+
+/*
+	Parselmouth: the global absolute peak for the determination of the silence threshold,
+	i.e. the largest absolute deviation of a sample from the mean of its channel.
+	For a LongSound, the means and extrema of all channels are computed in a single pass over the file;
+	since rounding is monotonic, the largest rounded deviation from the mean is that of one of the extrema.
+*/
+static double SampledXY_getPeakForPitch (SampledXY me, double blockDuration) {
+	double globalPeak = 0.0;
+	if (Thing_isa (me, classLongSound)) {
+		const LongSound longSound = static_cast <LongSound> (me);
+		autoVEC means = raw_VEC (my ny), minima = raw_VEC (my ny), maxima = raw_VEC (my ny);
+		minima.all()  <<=  std::numeric_limits <double>::infinity();
+		maxima.all()  <<=  - std::numeric_limits <double>::infinity();
+		if (my ny == 1)
+			LongSound_getMeansAndExtrema <1> (longSound, blockDuration, means.get(), minima.get(), maxima.get());
+		else if (my ny == 2)
+			LongSound_getMeansAndExtrema <2> (longSound, blockDuration, means.get(), minima.get(), maxima.get());
+		else if (my ny <= 4)
+			LongSound_getMeansAndExtrema <4> (longSound, blockDuration, means.get(), minima.get(), maxima.get());
+		else if (my ny <= 8)
+			LongSound_getMeansAndExtrema <8> (longSound, blockDuration, means.get(), minima.get(), maxima.get());
+		else if (my ny <= 16)
+			LongSound_getMeansAndExtrema <16> (longSound, blockDuration, means.get(), minima.get(), maxima.get());
+		else if (my ny <= 64)
+			LongSound_getMeansAndExtrema <64> (longSound, blockDuration, means.get(), minima.get(), maxima.get());
+		else
+			LongSound_getMeansAndExtrema <0> (longSound, blockDuration, means.get(), minima.get(), maxima.get());
+		for (integer ichan = 1; ichan <= my ny; ichan ++)
+			globalPeak = std::max ({ globalPeak, maxima [ichan] - means [ichan], means [ichan] - minima [ichan] });
+	} else {
+		Sound sound = static_cast <Sound> (me);
+		for (integer ichan = 1; ichan <= my ny; ichan ++) {
+			const double mean = NUMmean (sound -> z.row (ichan));
+			for (integer i = 1; i <= my nx; i ++) {
+				double value = fabs (sound -> z [ichan] [i] - mean);
+				if (value > globalPeak)
+					globalPeak = value;
+			}
+		}
+	}
+	return globalPeak;
+}
+
+/*
+	Parselmouth: Sound_to_Pitch_any for a Sound, or for a LongSound, whose frames are analysed in blocks of samples
+	read from the file (see LongSound_analyseInBlocks).
+*/
+static autoPitch SampledXY_to_Pitch_any (SampledXY me,
+	int method, double periodsPerWindow,
+	double dt, double pitchFloor, double pitchCeiling,
+	integer maxnCandidates,
+	double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double blockDuration)
+{
+	double t1;
+	integer numberOfFrames;
+
+	if (dt <= 0.0)
+		dt = periodsPerWindow / pitchFloor / 4.0;   // e.g. 3 periods, 75 Hz: 10 milliseconds
+
+	volatile const double duration = my dx * my nx;   // volatile, because we need to truncate to 64 bits
+	autoSound_into_Pitch_Args analysis = Thing_new (Sound_into_Pitch_Args);
+	autoVEC window, windowR;
+	Sound_into_Pitch_Args_initAnalysis (analysis.get(), my dx, duration, method, periodsPerWindow,
+			pitchFloor, pitchCeiling, maxnCandidates, voicingThreshold, octaveCost, & window, & windowR);
+	pitchCeiling = analysis -> pitchCeiling;
+	maxnCandidates = analysis -> maxnCandidates;
+
+	/*
+	 * Determine the number of frames.
+	 * Fit as many frames as possible symmetrically in the total duration.
+	 * We do this even for the forward cross-correlation method,
+	 * because that allows us to compare the two methods.
+	 */
+	try {
+		Sampled_shortTermAnalysis (me, method >= FCC_NORMAL ? 1.0 / pitchFloor + analysis -> dt_window : analysis -> dt_window, dt, & numberOfFrames, & t1);
+	} catch (MelderError) {
+		Melder_throw (U"The pitch analysis would give zero pitch frames.");
+	}
+
+	/*
+		Create the resulting pitch contour.
+	*/
+	autoPitch thee = Pitch_create (my xmin, my xmax, numberOfFrames, dt, t1, pitchCeiling, maxnCandidates);
+
+	/*
+		Create (too much) space for candidates.
+	*/
+	for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
+		const Pitch_Frame pitchFrame = & thy frames [iframe];
+		Pitch_Frame_init (pitchFrame, maxnCandidates);
+	}
+
+	/*
+		Compute the global absolute peak for determination of silence threshold.
+	*/
+	const double globalPeak = SampledXY_getPeakForPitch (me, blockDuration);
+	if (globalPeak == 0.0)
+		return thee;
+
+	autoMelderProgress progress (U"Sound to Pitch...");
+
+	/*
+		Parselmouth: the frames are distributed over the threads of the work-stealing pool in adaptively sized chunks;
+		every thread gets its own arguments and scratch memory, which it reuses for all of its chunks (and blocks).
+	*/
+	const integer maximumNumberOfThreads = MelderThread_getNumberOfThreadsForItems (numberOfFrames, 20);
+	trace (maximumNumberOfThreads, U" threads");
+
+	std::vector <autoSound_into_Pitch_Args> args (integer_to_uinteger (maximumNumberOfThreads));
+	volatile int cancelled = 0;
+	for (integer ithread = 1; ithread <= maximumNumberOfThreads; ithread ++) {
+		autoSound_into_Pitch_Args arg = Thing_new (Sound_into_Pitch_Args);
+		Sound_into_Pitch_Args_initBuffers (arg.get(), analysis.get(), my ny);
+		arg -> whole = me;
+		arg -> pitch = thee.get();
+		arg -> globalPeak = globalPeak;
+		arg -> isMainThread = ( ithread == 1 );   // the calling thread is always participant 1
+		arg -> cancelled = & cancelled;
+		args [integer_to_uinteger (ithread - 1)] = std::move (arg);
 	}
+	const double margin = analysis -> dt_window + 1.0 / pitchFloor;   // more than any frame needs on either side
+	Sampled_analyseSoundInBlocks (me, thee.get(), margin, blockDuration,
+		[&] (Sound block, integer sampleOffset, integer firstFrameOfBlock, integer lastFrameOfBlock) {
+			const integer numberOfThreads = std::min (maximumNumberOfThreads,
+					MelderThread_getNumberOfThreadsForItems (lastFrameOfBlock - firstFrameOfBlock + 1, 20));
+			MelderThread_runChunks (lastFrameOfBlock - firstFrameOfBlock + 1, numberOfThreads,
+				[&] (integer firstItem, integer lastItem, integer ithread) {
+					Sound_into_Pitch_Args arg = args [integer_to_uinteger (ithread - 1)].get();
+					arg -> sound = block;
+					arg -> sampleOffset = sampleOffset;
+					arg -> firstFrame = firstFrameOfBlock - 1 + firstItem;
+					arg -> lastFrame = firstFrameOfBlock - 1 + lastItem;
+					Sound_into_Pitch (arg);
+				}
+			);
+		}
+	);
+
+	Melder_progress (0.95, U"Sound to Pitch: path finder");
+	Pitch_pathFinder (thee.get(), silenceThreshold, voicingThreshold,
+			octaveCost, octaveJumpCost, voicedUnvoicedCost, pitchCeiling, Melder_debug == 31 ? true : false);
+
+	return thee;
 }
 
 autoPitch Sound_to_Pitch_any (Sound me,
@@ -315,236 +849,307 @@ autoPitch Sound_to_Pitch_any (Sound me,
 	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost)
 {
 	try {
-		autoNUMfft_Table fftTable;
-		double t1;
-		integer numberOfFrames;
-		integer nsampFFT;
-		double interpolation_depth;
-		integer brent_ixmax, brent_depth;
-		double globalPeak;
-
-		Melder_assert (maxnCandidates >= 2);
-		Melder_assert (method >= AC_HANNING && method <= FCC_ACCURATE);
-
-		if (maxnCandidates < pitchCeiling / pitchFloor)
-			maxnCandidates = Melder_ifloor (pitchCeiling / pitchFloor);
-
-		if (dt <= 0.0)
-			dt = periodsPerWindow / pitchFloor / 4.0;   // e.g. 3 periods, 75 Hz: 10 milliseconds
-
-		switch (method) {
-			case AC_HANNING:
-				brent_depth = NUM_PEAK_INTERPOLATE_SINC70;
-				interpolation_depth = 0.5;
-				break;
-			case AC_GAUSS:
-				periodsPerWindow *= 2;   // because Gaussian window is twice as long
-				brent_depth = NUM_PEAK_INTERPOLATE_SINC700;
-				interpolation_depth = 0.25;   // because Gaussian window is twice as long
-				break;
-			case FCC_NORMAL:
-				brent_depth = NUM_PEAK_INTERPOLATE_SINC70;
-				interpolation_depth = 1.0;
-				break;
-			case FCC_ACCURATE:
-				brent_depth = NUM_PEAK_INTERPOLATE_SINC700;
-				interpolation_depth = 1.0;
-				break;
-		}
-		volatile const double duration = my dx * my nx;   // volatile, because we need to truncate to 64 bits
-		if (pitchFloor < periodsPerWindow / duration)
-			Melder_throw (U"To analyse this Sound, “pitch floor” must not be less than ", periodsPerWindow / duration, U" Hz.");
+		return SampledXY_to_Pitch_any (me, method, periodsPerWindow, dt, pitchFloor, pitchCeiling, maxnCandidates,
+				silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, 0.0);
+	} catch (MelderError) {
+		Melder_throw (me, U": pitch analysis not performed.");
+	}
+}
 
-		/*
-			Determine the number of samples in the longest period.
-			We need this to compute the local mean of the sound (looking one period in both directions),
-			and to compute the local peak of the sound (looking half a period in both directions).
-		*/
-		const integer nsamp_period = Melder_ifloor (1.0 / my dx / pitchFloor);
-		const integer halfnsamp_period = nsamp_period / 2 + 1;
+autoPitch LongSound_to_Pitch_any (LongSound me,
+	int method, double periodsPerWindow,
+	double dt, double pitchFloor, double pitchCeiling,
+	integer maxnCandidates,
+	double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double blockDuration)
+{
+	try {
+		return SampledXY_to_Pitch_any (me, method, periodsPerWindow, dt, pitchFloor, pitchCeiling, maxnCandidates,
+				silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, blockDuration);
+	} catch (MelderError) {
+		Melder_throw (me, U": pitch analysis not performed.");
+	}
+}
+
+Thing_implement (PitchTracker, Thing, 0);
+
+/*
+	Sample number i of the stream (1-based) is at time (i - 0.5) * samplingPeriod.
+*/
+static integer PitchTracker_xToLowIndex (constPitchTracker me, double t) {
+	return Melder_ifloor (t / my samplingPeriod - 0.5) + 1;
+}
+
+static double PitchTracker_frameTime (constPitchTracker me, integer iframe) {
+	return my t1 + (iframe - 1) * my timeStep;
+}
+
+/*
+	The first and last sample that Sound_into_PitchFrame reads for a frame at time t,
+	with a margin of one sample against rounding differences between stream and buffer times.
+*/
+static integer PitchTracker_firstNeededSample (constPitchTracker me, double t) {
+	const Sound_into_Pitch_Args analysis = my analysis.get();
+	integer firstSample = PitchTracker_xToLowIndex (me, t) + 1 - std::max (analysis -> nsamp_period, analysis -> halfnsamp_window);
+	if (analysis -> method >= FCC_NORMAL) {
+		const double startTime = t - 0.5 * (1.0 / analysis -> pitchFloor + analysis -> dt_window);
+		firstSample = std::min (firstSample, PitchTracker_xToLowIndex (me, startTime));
+	}
+	return firstSample - 1;
+}
 
-		Melder_clipRight (& pitchCeiling, 0.5 / my dx);
+static integer PitchTracker_lastNeededSample (constPitchTracker me, double t) {
+	const Sound_into_Pitch_Args analysis = my analysis.get();
+	integer lastSample = PitchTracker_xToLowIndex (me, t) + std::max (analysis -> nsamp_period, analysis -> halfnsamp_window);
+	if (analysis -> method >= FCC_NORMAL) {
+		const double startTime = t - 0.5 * (1.0 / analysis -> pitchFloor + analysis -> dt_window);
+		lastSample = std::max (lastSample, PitchTracker_xToLowIndex (me, startTime) - 1 + analysis -> maximumLag + analysis -> nsamp_window);
+	}
+	return lastSample + 1;
+}
+
+static integer PitchTracker_ringIndex (constPitchTracker me, integer iframe) {
+	return (iframe - 1) % my frames.size + 1;
+}
+
+static void PitchTracker_reset (PitchTracker me) {
+	my largestAbsoluteSample = 0.0;
+	my numberOfSamples = 0;
+	my buffer. reset();
+	my bufferStart = 1;
+	my numberOfAnalysedFrames = 0;
+	my numberOfFinalFrames = 0;
+}
+
+autoPitchTracker PitchTracker_create (double samplingFrequency, integer numberOfChannels,
+	int method, double periodsPerWindow, double timeStep, double pitchFloor, double pitchCeiling, integer maxnCandidates,
+	double silenceThreshold, double voicingThreshold, double octaveCost, double octaveJumpCost, double voicedUnvoicedCost,
+	integer lookahead, double peak)
+{
+	try {
+		Melder_require (samplingFrequency > 0.0,
+			U"The sampling frequency should be positive.");
+		Melder_require (numberOfChannels >= 1,
+			U"The number of channels should be at least 1.");
+		Melder_require (lookahead >= 0,
+			U"The lookahead should not be negative.");
+		Melder_require (peak >= 0.0,
+			U"The peak should not be negative.");
+		autoPitchTracker me = Thing_new (PitchTracker);
+		my numberOfChannels = numberOfChannels;
+		my samplingPeriod = 1.0 / samplingFrequency;
+		my timeStep = ( timeStep > 0.0 ? timeStep : periodsPerWindow / pitchFloor / 4.0 );
+
+		autoSound_into_Pitch_Args settings = Thing_new (Sound_into_Pitch_Args);
+		Sound_into_Pitch_Args_initAnalysis (settings.get(), my samplingPeriod, 0.0, method, periodsPerWindow,
+				pitchFloor, pitchCeiling, maxnCandidates, voicingThreshold, octaveCost, & my window, & my windowR);
+		my analysis = Thing_new (Sound_into_Pitch_Args);
+		Sound_into_Pitch_Args_initBuffers (my analysis.get(), settings.get(), numberOfChannels);
+
+		my silenceThreshold = silenceThreshold;
+		my voicingThreshold = voicingThreshold;
+		my octaveCost = octaveCost;
+		const double timeStepCorrection = 0.01 / my timeStep;   // as in Pitch_pathFinder
+		my octaveJumpCost = octaveJumpCost * timeStepCorrection;
+		my voicedUnvoicedCost = voicedUnvoicedCost * timeStepCorrection;
+		my peak = peak;
+		my lookahead = lookahead;
 
 		/*
-			Determine window duration in seconds and in samples.
+			Centre the first frame half an analysis window after the start of the stream,
+			later if the rounding of the window to samples requires it.
 		*/
-		const double dt_window = periodsPerWindow / pitchFloor;
-		integer nsamp_window = Melder_ifloor (dt_window / my dx);
-		const integer halfnsamp_window = nsamp_window / 2 - 1;
-		if (halfnsamp_window < 2)
-			Melder_throw (U"Analysis window too short.");
-		nsamp_window = halfnsamp_window * 2;
+		const double analysisWidth = ( method >= FCC_NORMAL ? 1.0 / pitchFloor + my analysis -> dt_window : my analysis -> dt_window );
+		my t1 = 0.5 * analysisWidth;
+		while (PitchTracker_firstNeededSample (me.get(), my t1) < 1)
+			my t1 += my samplingPeriod;
 
-		/*
-		 * Determine the minimum and maximum lags.
-		 */
-		const integer minimumLag = std::max (2_integer, Melder_ifloor (1.0 / my dx / pitchCeiling));
-		const integer maximumLag = std::min (Melder_ifloor (nsamp_window / periodsPerWindow) + 2, nsamp_window);
+		const integer maxn = my analysis -> maxnCandidates;
+		my frames = newvectorzero <structPitch_Frame> (lookahead + 2);
+		for (integer iframe = 1; iframe <= my frames.size; iframe ++)
+			Pitch_Frame_init (& my frames [iframe], maxn);
+		my psi = zero_INTMAT (my frames.size, maxn);
+		my previousDelta = zero_VEC (maxn);
+		my currentDelta = zero_VEC (maxn);
+		PitchTracker_reset (me.get());
+		return me;
+	} catch (MelderError) {
+		Melder_throw (U"PitchTracker not created.");
+	}
+}
 
-		/*
-		 * Determine the number of frames.
-		 * Fit as many frames as possible symmetrically in the total duration.
-		 * We do this even for the forward cross-correlation method,
-		 * because that allows us to compare the two methods.
-		 */
-		try {
-			Sampled_shortTermAnalysis (me, method >= FCC_NORMAL ? 1.0 / pitchFloor + dt_window : dt_window, dt, & numberOfFrames, & t1);
-		} catch (MelderError) {
-			Melder_throw (U"The pitch analysis would give zero pitch frames.");
+/*
+	One step of the path finder of Pitch_pathFinder, for the frame that was just analysed.
+*/
+static void PitchTracker_pathStep (PitchTracker me, integer iframe) {
+	const Pitch_Frame frame = & my frames [PitchTracker_ringIndex (me, iframe)];
+	const double ceiling = my analysis -> pitchCeiling;
+	double unvoicedStrength = ( my silenceThreshold <= 0 ? 0.0 :
+		2.0 - frame -> intensity / (my silenceThreshold / (1.0 + my voicingThreshold)) );
+	unvoicedStrength = my voicingThreshold + std::max (0.0, unvoicedStrength);
+	for (integer icand = 1; icand <= frame -> nCandidates; icand ++) {
+		const Pitch_Candidate candidate = & frame -> candidates [icand];
+		my currentDelta [icand] = ( ! Pitch_util_frequencyIsVoiced (candidate -> frequency, ceiling) ? unvoicedStrength :
+			candidate -> strength - my octaveCost * NUMlog2 (ceiling / candidate -> frequency) );
+	}
+	const INTVEC psi = my psi [PitchTracker_ringIndex (me, iframe)];
+	if (iframe > 1) {
+		const Pitch_Frame previousFrame = & my frames [PitchTracker_ringIndex (me, iframe - 1)];
+		volatile double maximum, value;
+		for (integer icand2 = 1; icand2 <= frame -> nCandidates; icand2 ++) {
+			const double f2 = frame -> candidates [icand2]. frequency;
+			const bool currentVoiceless = ! Pitch_util_frequencyIsVoiced (f2, ceiling);
+			maximum = -1e30;
+			integer place = 0;
+			for (integer icand1 = 1; icand1 <= previousFrame -> nCandidates; icand1 ++) {
+				const double f1 = previousFrame -> candidates [icand1]. frequency;
+				const bool previousVoiceless = ! Pitch_util_frequencyIsVoiced (f1, ceiling);
+				const double transitionCost = ( currentVoiceless != previousVoiceless ? my voicedUnvoicedCost :
+						currentVoiceless ? 0.0 : my octaveJumpCost * fabs (NUMlog2 (f1 / f2)) );
+				value = my previousDelta [icand1] - transitionCost + my currentDelta [icand2];
+				if (value > maximum) {
+					maximum = value;
+					place = icand1;
+				}
+			}
+			my currentDelta [icand2] = maximum;
+			psi [icand2] = place;
 		}
+	}
+	std::swap (my previousDelta, my currentDelta);   // the deltas of the last analysed frame are now in previousDelta
+}
 
+/*
+	Trace the best path back from the last analysed frame, select the candidates on the path
+	of the frames up to and including 'lastFrame', and append copies of these frames to 'frames'.
+*/
+static void PitchTracker_commit (PitchTracker me, integer lastFrame, std::vector <structPitch_Frame> *frames) {
+	const Pitch_Frame newestFrame = & my frames [PitchTracker_ringIndex (me, my numberOfAnalysedFrames)];
+	integer place = 1;
+	double maximum = my previousDelta [place];
+	for (integer icand = 2; icand <= newestFrame -> nCandidates; icand ++) {
+		if (my previousDelta [icand] > maximum) {
+			place = icand;
+			maximum = my previousDelta [place];
+		}
+	}
+	const integer firstFrame = my numberOfFinalFrames + 1;
+	autoINTVEC places = raw_INTVEC (my numberOfAnalysedFrames - firstFrame + 1);
+	for (integer iframe = my numberOfAnalysedFrames; iframe >= firstFrame; iframe --) {
+		places [iframe - firstFrame + 1] = place;
+		place = my psi [PitchTracker_ringIndex (me, iframe)] [place];
+	}
+	for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+		const Pitch_Frame frame = & my frames [PitchTracker_ringIndex (me, iframe)];
+		structPitch_Frame copy;
+		Pitch_Frame_init (& copy, frame -> nCandidates);
+		for (integer icand = 1; icand <= frame -> nCandidates; icand ++)
+			copy. candidates [icand] = frame -> candidates [icand];
+		copy. intensity = frame -> intensity;
 		/*
-			Create the resulting pitch contour.
+			Select the candidate on the path in the copy only: without lookahead, this frame is the previous frame
+			of the next path step, whose candidates have to stay in the order of previousDelta.
 		*/
-		autoPitch thee = Pitch_create (my xmin, my xmax, numberOfFrames, dt, t1, pitchCeiling, maxnCandidates);
+		std::swap (copy. candidates [1], copy. candidates [places [iframe - firstFrame + 1]]);
+		frames -> push_back (std::move (copy));
+	}
+	my numberOfFinalFrames = lastFrame;
+}
+
+static autoPitch PitchTracker_createPitch (PitchTracker me, std::vector <structPitch_Frame> *frames) {
+	const integer numberOfFrames = uinteger_to_integer (frames -> size());
+	if (numberOfFrames == 0)
+		return autoPitch();
+	const integer firstFrame = my numberOfFinalFrames - numberOfFrames + 1;
+	const double t1 = PitchTracker_frameTime (me, firstFrame);
+	autoPitch thee = Pitch_create (t1 - 0.5 * my timeStep, t1 + (numberOfFrames - 0.5) * my timeStep,
+			numberOfFrames, my timeStep, t1, my analysis -> pitchCeiling, my analysis -> maxnCandidates);
+	for (integer iframe = 1; iframe <= numberOfFrames; iframe ++)
+		thy frames [iframe] = std::move ((*frames) [integer_to_uinteger (iframe - 1)]);
+	return thee;
+}
+
+autoPitch PitchTracker_process (PitchTracker me, constMATVU const& samples) {
+	try {
+		Melder_require (samples.nrow == my numberOfChannels,
+			U"The number of channels should be ", my numberOfChannels, U", not ", samples.nrow, U".");
 
 		/*
-			Create (too much) space for candidates.
+			Append the new samples to the ones that are still needed.
 		*/
-		for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
-			const Pitch_Frame pitchFrame = & thy frames [iframe];
-			Pitch_Frame_init (pitchFrame, maxnCandidates);
+		const integer numberOfKeptSamples = ( my buffer ? my buffer -> nx : 0 );
+		const integer bufferSize = numberOfKeptSamples + samples.ncol;
+		if (bufferSize > 0) {
+			autoSound buffer = Sound_create (my numberOfChannels,
+					(my bufferStart - 1) * my samplingPeriod, (my bufferStart - 1 + bufferSize) * my samplingPeriod,
+					bufferSize, my samplingPeriod, (my bufferStart - 0.5) * my samplingPeriod);
+			if (numberOfKeptSamples > 0)
+				buffer -> z.verticalBand (1, numberOfKeptSamples)  <<=  my buffer -> z.all();
+			buffer -> z.verticalBand (numberOfKeptSamples + 1, bufferSize)  <<=  samples;
+			my buffer = buffer.move();
 		}
+		for (integer ichan = 1; ichan <= samples.nrow; ichan ++)
+			for (integer i = 1; i <= samples.ncol; i ++)
+				Melder_clipLeft (fabs (samples [ichan] [i]), & my largestAbsoluteSample);
+		my numberOfSamples += samples.ncol;
 
 		/*
-			Compute the global absolute peak for determination of silence threshold.
+			Analyse all frames whose samples have arrived, and commit the frames that have enough frames after them.
 		*/
-		globalPeak = 0.0;
-		for (integer ichan = 1; ichan <= my ny; ichan ++) {
-			const double mean = NUMmean (my z.row (ichan));
-			for (integer i = 1; i <= my nx; i ++) {
-				double value = fabs (my z [ichan] [i] - mean);
-				if (value > globalPeak)
-					globalPeak = value;
+		std::vector <structPitch_Frame> finalFrames;
+		const double globalPeak = ( my peak > 0.0 ? my peak : my largestAbsoluteSample );
+		while (PitchTracker_lastNeededSample (me, PitchTracker_frameTime (me, my numberOfAnalysedFrames + 1)) <= my numberOfSamples) {
+			const integer iframe = ++ my numberOfAnalysedFrames;
+			const Pitch_Frame frame = & my frames [PitchTracker_ringIndex (me, iframe)];
+			if (globalPeak == 0.0) {   // silence so far: a single unvoiced candidate, as in Pitch_create
+				frame -> candidates. resize (frame -> nCandidates = 1);
+				frame -> candidates [1]. frequency = 0.0;
+				frame -> candidates [1]. strength = 0.0;
+				frame -> intensity = 0.0;
+			} else {
+				my analysis -> globalPeak = globalPeak;
+				Sound_into_Pitch_analyseFrame (my analysis.get(), my buffer.get(), my buffer.get(), 0, frame, PitchTracker_frameTime (me, iframe));
 			}
+			PitchTracker_pathStep (me, iframe);
+			if (iframe - my numberOfFinalFrames > my lookahead)
+				PitchTracker_commit (me, iframe - my lookahead, & finalFrames);
 		}
-		if (globalPeak == 0.0)
-			return thee;
-
-		autoVEC window, windowR;
-		if (method >= FCC_NORMAL) {   // for cross-correlation analysis
-
-			nsampFFT = 0;
-			brent_ixmax = Melder_ifloor (nsamp_window * interpolation_depth);
-
-		} else {   // for autocorrelation analysis
 
-			/*
-				Compute the number of samples needed for doing FFT.
-				To avoid edge effects, we have to append zeroes to the window.
-				The maximum lag considered for maxima is maximumLag.
-				The maximum lag used in interpolation is nsamp_window * interpolation_depth.
-			*/
-			nsampFFT = 1;
-			while (nsampFFT < nsamp_window * (1 + interpolation_depth))
-				nsampFFT *= 2;
-
-			/*
-				Create buffers for autocorrelation analysis.
-			*/
-			windowR. resize (nsampFFT);
-			window. resize (nsamp_window);
-			NUMfft_Table_init (& fftTable, nsampFFT);
-
-			/*
-				A Gaussian or Hanning window is applied against phase effects.
-				The Hanning window is 2 to 5 dB better for 3 periods/window.
-				The Gaussian window is 25 to 29 dB better for 6 periods/window.
-			*/
-			if (method == AC_GAUSS) {   // Gaussian window
-				double imid = 0.5 * (nsamp_window + 1), edge = exp (-12.0);
-				for (integer i = 1; i <= nsamp_window; i ++)
-					window [i] = (exp (-48.0 * (i - imid) * (i - imid) /
-							(nsamp_window + 1) / (nsamp_window + 1)) - edge) / (1.0 - edge);
-			} else {   // Hanning window
-				for (integer i = 1; i <= nsamp_window; i ++)
-					window [i] = 0.5 - 0.5 * cos (i * 2 * NUMpi / (nsamp_window + 1));
-			}
-
-			/*
-				Compute the normalized autocorrelation of the window.
-			*/
-			for (integer i = 1; i <= nsamp_window; i ++)
-				windowR [i] = window [i];
-			NUMfft_forward (& fftTable, windowR.get());
-			windowR [1] *= windowR [1];   // DC component
-			for (integer i = 2; i < nsampFFT; i += 2) {
-				windowR [i] = windowR [i] * windowR [i] + windowR [i + 1] * windowR [i + 1];
-				windowR [i + 1] = 0.0;   // power spectrum: square and zero
-			}
-			windowR [nsampFFT] *= windowR [nsampFFT];   // Nyquist frequency
-			NUMfft_backward (& fftTable, windowR.get());   // autocorrelation
-			for (integer i = 2; i <= nsamp_window; i ++)
-				windowR [i] /= windowR [1];   // normalize
-			windowR [1] = 1.0;   // normalize
-
-			brent_ixmax = Melder_ifloor (nsamp_window * interpolation_depth);
-		}
-
-		autoMelderProgress progress (U"Sound to Pitch...");
-
-		integer numberOfFramesPerThread = 20;
-		integer numberOfThreads = (numberOfFrames - 1) / numberOfFramesPerThread + 1;
-		const integer numberOfProcessors = MelderThread_getNumberOfProcessors ();
-		trace (numberOfProcessors, U" processors");
-		Melder_clipRight (& numberOfThreads, numberOfProcessors);
-		Melder_clip (1_integer, & numberOfThreads, 16_integer);
-		numberOfFramesPerThread = (numberOfFrames - 1) / numberOfThreads + 1;
-
-		autoSound_into_Pitch_Args args [16];
-		integer firstFrame = 1, lastFrame = numberOfFramesPerThread;
-		volatile int cancelled = 0;
-		for (int ithread = 1; ithread <= numberOfThreads; ithread ++) {
-			if (ithread == numberOfThreads)
-				lastFrame = numberOfFrames;
-			autoSound_into_Pitch_Args arg = Thing_new (Sound_into_Pitch_Args);
-			arg -> sound = me;
-			arg -> pitch = thee.get();
-			arg -> firstFrame = firstFrame;
-			arg -> lastFrame = lastFrame;
-			arg -> pitchFloor = pitchFloor;
-			arg -> maxnCandidates = maxnCandidates;
-			arg -> method = method;
-			arg -> voicingThreshold = voicingThreshold;
-			arg -> octaveCost = octaveCost;
-			arg -> dt_window = dt_window;
-			arg -> nsamp_window = nsamp_window;
-			arg -> halfnsamp_window = halfnsamp_window;
-			arg -> maximumLag = maximumLag;
-			arg -> nsampFFT = nsampFFT;
-			arg -> nsamp_period = nsamp_period;
-			arg -> halfnsamp_period = halfnsamp_period;
-			arg -> brent_ixmax = brent_ixmax;
-			arg -> brent_depth = brent_depth;
-			arg -> globalPeak = globalPeak;
-			arg -> window = window.get();
-			arg -> windowR = windowR.get();
-			arg -> isMainThread = ( ithread == numberOfThreads );
-			arg -> cancelled = & cancelled;
-			if (method >= FCC_NORMAL) {   // cross-correlation
-				arg -> frame = zero_MAT (my ny, nsamp_window);
-			} else {   // autocorrelation
-				NUMfft_Table_init (& arg -> fftTable, nsampFFT);
-				arg -> frame = zero_MAT (my ny, nsampFFT);
-				arg -> ac = zero_VEC (nsampFFT);
+		/*
+			Forget the samples that the next frames do not need.
+		*/
+		const integer firstNeededSample = std::min (my numberOfSamples + 1,
+				PitchTracker_firstNeededSample (me, PitchTracker_frameTime (me, my numberOfAnalysedFrames + 1)));
+		if (my buffer && firstNeededSample > my bufferStart) {
+			const integer numberOfSamplesToKeep = my numberOfSamples - firstNeededSample + 1;
+			if (numberOfSamplesToKeep == 0) {
+				my buffer. reset();
+			} else {
+				autoSound buffer = Sound_create (my numberOfChannels,
+						(firstNeededSample - 1) * my samplingPeriod, my numberOfSamples * my samplingPeriod,
+						numberOfSamplesToKeep, my samplingPeriod, (firstNeededSample - 0.5) * my samplingPeriod);
+				buffer -> z.all()  <<=  my buffer -> z.verticalBand (firstNeededSample - my bufferStart + 1, my buffer -> nx);
+				my buffer = buffer.move();
 			}
-			arg -> rbuffer = zero_VEC (2 * nsamp_window + 1);
-			arg -> r = & arg -> rbuffer [1 + nsamp_window];
-			arg -> imax = zero_INTVEC (maxnCandidates);
-			arg -> localMean = zero_VEC (my ny);
-			args [ithread - 1] = std::move (arg);
-			firstFrame = lastFrame + 1;
-			lastFrame += numberOfFramesPerThread;
+			my bufferStart = firstNeededSample;
 		}
-		MelderThread_run (Sound_into_Pitch, args, numberOfThreads);
 
-		Melder_progress (0.95, U"Sound to Pitch: path finder");
-		Pitch_pathFinder (thee.get(), silenceThreshold, voicingThreshold,
-				octaveCost, octaveJumpCost, voicedUnvoicedCost, pitchCeiling, Melder_debug == 31 ? true : false);
+		return PitchTracker_createPitch (me, & finalFrames);
+	} catch (MelderError) {
+		Melder_throw (me, U": samples not processed.");
+	}
+}
 
+autoPitch PitchTracker_flush (PitchTracker me) {
+	try {
+		std::vector <structPitch_Frame> finalFrames;
+		if (my numberOfAnalysedFrames > my numberOfFinalFrames)
+			PitchTracker_commit (me, my numberOfAnalysedFrames, & finalFrames);
+		autoPitch thee = PitchTracker_createPitch (me, & finalFrames);
+		PitchTracker_reset (me);
 		return thee;
 	} catch (MelderError) {
-		Melder_throw (me, U": pitch analysis not performed.");
+		Melder_throw (me, U": not flushed.");
 	}
 }
 
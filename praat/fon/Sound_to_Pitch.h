@@ -18,6 +18,8 @@
 
 #include "Sound.h"
 #include "Pitch.h"
+#include "LongSound.h"
+#include "NUM2.h"
 
 autoPitch Sound_to_Pitch (Sound me, double timeStep,
 	double pitchFloor, double pitchCeiling);
@@ -86,6 +88,19 @@ autoPitch Sound_to_Pitch_any (Sound me,
 		pitches above a certain value "voiceless".
 */
 
+autoPitch LongSound_to_Pitch_any (LongSound me,
+	int method, double periodsPerWindow,
+	double timeStep, double pitchFloor, double pitchCeiling,
+	integer maxnCandidates,
+	double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost,
+	double blockDuration);
+/*
+	Parselmouth: Sound_to_Pitch_any on a LongSound, reading about 'blockDuration' seconds of the file at a time.
+	The candidates of all frames are the same as those of the Sound read from the whole file;
+	only the mean of each channel (for the silence threshold) may differ in its last bits, because it is summed in blocks.
+*/
+
 autoPitch Sound_to_Pitch_filteredAc (Sound me,
 	double timeStep, double pitchFloor, double pitchTop,
 	integer maxnCandidates, bool veryAccurate,
@@ -100,4 +115,86 @@ autoPitch Sound_to_Pitch_filteredCc (Sound me,
 	double silenceThreshold, double voicingThreshold,
 	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost);
 
+/*
+	Parselmouth: the settings and scratch memory for the analysis of pitch frames by Sound_to_Pitch_any,
+	one per thread, and by a PitchTracker.
+*/
+Thing_define (Sound_into_Pitch_Args, Thing) { public:
+	Sound sound;
+	constSampled whole;   // the Sound or LongSound of which 'sound' contains a part
+	integer sampleOffset;   // the number of samples of 'whole' before 'sound'
+	Pitch pitch;
+	integer firstFrame, lastFrame;
+	double pitchFloor, pitchCeiling;
+	int maxnCandidates, method;
+	double voicingThreshold, octaveCost, dt_window;
+	integer nsamp_window, halfnsamp_window, maximumLag, nsampFFT, nsamp_period, halfnsamp_period, brent_ixmax, brent_depth;
+	double globalPeak;
+	VEC window, windowR;
+	bool isMainThread;
+	volatile int *cancelled;
+	autoNUMfft_Table fftTable;
+	autoMAT frame;   // for the autocorrelation methods, the channels of a batch of frames
+	autoVEC ac, span, rbuffer, localMean;
+	autoMAT autocorrelations;   // of a batch of frames
+	autoVEC localPeaks;   // of a batch of frames
+	double *r;
+	autoINTVEC imax;
+};
+
+/*
+	Parselmouth: a streaming version of Sound_to_Pitch_any, for audio that arrives in chunks.
+
+	The candidates of each frame are computed exactly as in Sound_to_Pitch_any, as soon as all samples
+	around the frame have arrived. The path through the candidates is found with the same costs as in
+	Pitch_pathFinder, but a frame is final as soon as 'lookahead' later frames have been analysed:
+	the best path at that moment is traced back to the frame, and the frame's candidate on that path is
+	selected. So only the last lookahead + 2 frames and the samples needed by the next frame are kept.
+
+	Differences with Sound_to_Pitch_any:
+	- the first frame is centred half an analysis window after the start of the stream,
+	  rather than the frames being centred in the whole duration;
+	- the intensity of the frames (and therefore the silence threshold) is relative to 'peak',
+	  or, if 'peak' is zero, to the largest absolute sample value received so far,
+	  rather than to the largest absolute deviation from the mean of the whole Sound;
+	- with a finite lookahead, later frames cannot change the selection of frames that are final.
+*/
+Thing_define (PitchTracker, Thing) { public:
+	autoSound_into_Pitch_Args analysis;
+	autoVEC window, windowR;
+	integer numberOfChannels;
+	double samplingPeriod, timeStep, t1;
+	double silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost;
+	double peak;   // zero: the largest absolute sample value so far
+	double largestAbsoluteSample;
+	integer lookahead;
+	integer numberOfSamples;   // received so far
+	autoSound buffer;   // the samples from bufferStart onwards
+	integer bufferStart;
+	integer numberOfAnalysedFrames, numberOfFinalFrames;
+	autovector <structPitch_Frame> frames;   // the frames after the last final one, in a ring of lookahead + 2
+	autoINTMAT psi;   // the best previous candidates of these frames, in the same ring
+	autoVEC previousDelta, currentDelta;
+};
+
+autoPitchTracker PitchTracker_create (double samplingFrequency, integer numberOfChannels,
+	int method, double periodsPerWindow, double timeStep, double pitchFloor, double pitchCeiling, integer maxnCandidates,
+	double silenceThreshold, double voicingThreshold, double octaveCost, double octaveJumpCost, double voicedUnvoicedCost,
+	integer lookahead, double peak);
+/*
+	'method' and 'periodsPerWindow' as in Sound_to_Pitch_any; 'lookahead' in frames (0 or more).
+*/
+
+autoPitch PitchTracker_process (PitchTracker me, constMATVU const& samples);
+/*
+	Append 'samples' (one row per channel) to the stream, and return the frames that became final,
+	or nullptr if no frame became final.
+*/
+
+autoPitch PitchTracker_flush (PitchTracker me);
+/*
+	Return all remaining frames that can be analysed with the samples received so far, or nullptr if there are none.
+	After this, the tracker is reset to the start of a new stream.
+*/
+
 /* End of file Sound_to_Pitch.h */
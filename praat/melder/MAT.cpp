@@ -18,6 +18,7 @@
 
 #include "melder.h"
 #include "../dwsys/NUM2.h"
+#include "../sys/MelderThread.h"
 //#include "../external/gsl/gsl_blas.h"
 
 #ifdef macintosh
@@ -45,6 +46,143 @@ void doubleCentre_MAT_inout (MATVU const& x) noexcept {
 	centreEachColumn_MAT_inout (x);
 }
 
+/*
+	Parselmouth: a packed, register-blocked matrix multiplication, in the manner of GotoBLAS and BLIS.
+
+	Blocks of KC columns of X and KC rows of Y are packed into contiguous slivers of MR rows (of X) and NR columns (of Y),
+	with zeroes beyond the edges, such that the micro-kernel reads both with unit stride, whatever the strides of X and Y,
+	while it keeps an MR x NR block of the target in registers. An MC x KC block of X stays in the L2 cache,
+	and a KC x NR sliver of Y in the L1 cache.
+
+	The tiles of MC rows and NC columns of the target are distributed over the threads of the pool,
+	every thread packing into its own buffers. Every cell of the target is summed over k in the same order,
+	whatever the number of threads.
+
+	As it allocates its packing buffers and runs on the thread pool, it is only used by the functions
+	that are allowed to allocate (and throw), i.e. _mul_allowAllocation_MAT_out and mtm_allowAllocation_MAT_out,
+	not by the noexcept functions _mul_MAT_out (which sums pairwise), _mul_fast_MAT_out, and mtm_MAT_out.
+
+	The micro-kernel is plain C++ that the compiler vectorizes (SSE2 or NEON);
+	on x86-64 Linux, GCC and Clang also compile AVX2 and AVX-512 versions, one of which is chosen at load time.
+	As no fused multiply-adds are used, all versions give identical results.
+*/
+#if defined (__x86_64__) && defined (__linux__) && (defined (__clang__) ? __clang_major__ >= 14 : defined (__GNUC__) && __GNUC__ >= 6)
+	#define GEMM_TARGET_CLONES  __attribute__ ((target_clones ("avx512f", "avx2", "default")))
+#else
+	#define GEMM_TARGET_CLONES
+#endif
+
+constexpr integer GEMM_MR = 4, GEMM_NR = 8;
+constexpr integer GEMM_MC = 96, GEMM_KC = 256, GEMM_NC = 512;
+
+static void gemm_packX (double *packed, constMATVU const& x, integer firstRow, integer numberOfRows, integer firstK, integer numberOfK) noexcept {
+	for (integer irow = 0; irow < numberOfRows; irow += GEMM_MR) {
+		const integer numberOfRowsInSliver = std::min (GEMM_MR, numberOfRows - irow);
+		for (integer k = 0; k < numberOfK; k ++) {
+			for (integer i = 0; i < numberOfRowsInSliver; i ++)
+				packed [i] = x [firstRow + irow + i] [firstK + k];
+			for (integer i = numberOfRowsInSliver; i < GEMM_MR; i ++)
+				packed [i] = 0.0;
+			packed += GEMM_MR;
+		}
+	}
+}
+
+static void gemm_packY (double *packed, constMATVU const& y, integer firstK, integer numberOfK, integer firstColumn, integer numberOfColumns) noexcept {
+	for (integer icol = 0; icol < numberOfColumns; icol += GEMM_NR) {
+		const integer numberOfColumnsInSliver = std::min (GEMM_NR, numberOfColumns - icol);
+		for (integer k = 0; k < numberOfK; k ++) {
+			for (integer j = 0; j < numberOfColumnsInSliver; j ++)
+				packed [j] = y [firstK + k] [firstColumn + icol + j];
+			for (integer j = numberOfColumnsInSliver; j < GEMM_NR; j ++)
+				packed [j] = 0.0;
+			packed += GEMM_NR;
+		}
+	}
+}
+
+/*
+	target [firstRow .. firstRow + numberOfRows - 1] [firstColumn .. firstColumn + numberOfColumns - 1]
+	(+)= packedX . packedY
+*/
+GEMM_TARGET_CLONES
+static void gemm_macroKernel (MATVU const& target, integer firstRow, integer numberOfRows, integer firstColumn, integer numberOfColumns,
+	integer numberOfK, const double *packedX, const double *packedY, bool accumulate) noexcept
+{
+	for (integer icol = 0; icol < numberOfColumns; icol += GEMM_NR) {
+		const integer numberOfColumnsInSliver = std::min (GEMM_NR, numberOfColumns - icol);
+		const double *sliverY = packedY + icol * numberOfK;
+		for (integer irow = 0; irow < numberOfRows; irow += GEMM_MR) {
+			const integer numberOfRowsInSliver = std::min (GEMM_MR, numberOfRows - irow);
+			const double *sliverX = packedX + irow * numberOfK;
+			double block [GEMM_MR] [GEMM_NR] = { };   // the micro-kernel's registers
+			for (integer k = 0; k < numberOfK; k ++) {
+				const double *xk = sliverX + k * GEMM_MR, *yk = sliverY + k * GEMM_NR;
+				for (integer i = 0; i < GEMM_MR; i ++)
+					for (integer j = 0; j < GEMM_NR; j ++)
+						block [i] [j] += xk [i] * yk [j];
+			}
+			for (integer i = 0; i < numberOfRowsInSliver; i ++) {
+				const VECVU targetRow = target [firstRow + irow + i];
+				for (integer j = 0; j < numberOfColumnsInSliver; j ++) {
+					double& cell = targetRow [firstColumn + icol + j];
+					cell = ( accumulate ? cell + block [i] [j] : block [i] [j] );
+				}
+			}
+		}
+	}
+}
+
+static void _mul_packed_MAT_out (MATVU const& target, constMATVU const& x, constMATVU const& y) {
+	if (x.ncol == 0) {
+		for (integer irow = 1; irow <= target.nrow; irow ++)
+			for (integer icol = 1; icol <= target.ncol; icol ++)
+				target [irow] [icol] = 0.0;
+		return;
+	}
+	const integer numberOfRowTiles = (target.nrow + GEMM_MC - 1) / GEMM_MC;
+	const integer numberOfColumnTiles = (target.ncol + GEMM_NC - 1) / GEMM_NC;
+	const integer numberOfTiles = numberOfRowTiles * numberOfColumnTiles;
+	const double numberOfFlops = 2.0 * double (target.nrow) * double (target.ncol) * double (x.ncol);
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsForItems (
+			Melder_ifloor (numberOfFlops / 1e6) + 1, 1, numberOfTiles);   // at least a megaflop per thread
+	const integer packedXSize = GEMM_MC * std::min (GEMM_KC, x.ncol);
+	const integer packedYSize = std::min (GEMM_KC, x.ncol) * ((std::min (GEMM_NC, target.ncol) + GEMM_NR - 1) / GEMM_NR * GEMM_NR);
+	std::vector <autoVEC> packedXs (integer_to_uinteger (numberOfThreads)), packedYs (integer_to_uinteger (numberOfThreads));
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		packedXs [integer_to_uinteger (ithread - 1)] = raw_VEC (packedXSize);
+		packedYs [integer_to_uinteger (ithread - 1)] = raw_VEC (packedYSize);
+	}
+	MelderThread_runChunks (numberOfTiles, numberOfThreads,
+		[&] (integer firstTile, integer lastTile, integer ithread) {
+			double *packedX = & packedXs [integer_to_uinteger (ithread - 1)] [1];
+			double *packedY = & packedYs [integer_to_uinteger (ithread - 1)] [1];
+			for (integer itile = firstTile; itile <= lastTile; itile ++) {
+				const integer firstColumn = 1 + (itile - 1) / numberOfRowTiles * GEMM_NC;
+				const integer firstRow = 1 + (itile - 1) % numberOfRowTiles * GEMM_MC;
+				const integer numberOfColumns = std::min (GEMM_NC, target.ncol - firstColumn + 1);
+				const integer numberOfRows = std::min (GEMM_MC, target.nrow - firstRow + 1);
+				for (integer firstK = 1; firstK <= x.ncol; firstK += GEMM_KC) {
+					const integer numberOfK = std::min (GEMM_KC, x.ncol - firstK + 1);
+					gemm_packY (packedY, y, firstK, numberOfK, firstColumn, numberOfColumns);
+					gemm_packX (packedX, x, firstRow, numberOfRows, firstK, numberOfK);
+					gemm_macroKernel (target, firstRow, numberOfRows, firstColumn, numberOfColumns,
+							numberOfK, packedX, packedY, firstK > 1);
+				}
+			}
+		}
+	);
+}
+
+/*
+	Parselmouth: the number of flops above which the packed multiplication is faster than the simple loops.
+*/
+constexpr double minimumNumberOfFlopsForPackedMultiplication = 1e5;
+
+static inline bool shouldUsePackedMultiplication (MATVU const& target, constMATVU const& x) noexcept {
+	return double (target.nrow) * double (target.ncol) * double (x.ncol) > minimumNumberOfFlopsForPackedMultiplication;
+}
+
 void mtm_MAT_out (MATVU const& target, constMATVU const& x) noexcept {
 	Melder_assert (target.nrow == x.ncol);
 	Melder_assert (target.ncol == x.ncol);
@@ -83,6 +221,20 @@ void mtm_MAT_out (MATVU const& target, constMATVU const& x) noexcept {
 	#endif
 }
 
+void mtm_allowAllocation_MAT_out (MATVU const& target, constMATVU const& x) {
+	Melder_assert (target.nrow == x.ncol);
+	Melder_assert (target.ncol == x.ncol);
+	if (shouldUsePackedMultiplication (target, x.transpose())) {
+		/*
+			X'.X is symmetric also when computed by the packed multiplication,
+			because the products x [k] [i] * x [k] [j] and x [k] [j] * x [k] [i] are identical and summed in the same order.
+		*/
+		_mul_packed_MAT_out (target, x.transpose(), x);
+	} else {
+		mtm_MAT_out (target, x);
+	}
+}
+
 void _mul_MAT_out (MATVU const& target, constMATVU const& x, constMATVU const& y) noexcept {
 	/*
 		Precise matrix multiplication, using pairwise summation.
@@ -237,7 +389,16 @@ void _mul_allowAllocation_MAT_out (MATVU const& target, constMATVU x, constMATVU
 		For the X'.Y' case, where X and Y are packed row-major matrices,
 		the speed is 0.084, 0.553, 1.18, 1.63, 2.31, 2.12, 2.12, 2.25, 2.16, 1.90, 1.79, 1.50 Gflop/s
 		for size =       1,     3,   10,   20,   50,  100,  200,  500, 1000, 2000, 3000, 5000.
+
+		Parselmouth: from the same size on at which the above would allocate transposed copies,
+		the packed multiplication is used instead, which packs blocks of X and Y anyway.
+		On one thread (AVX-512), the speed for X.Y is 11.1, 11.6, 18.2, 15.1, 13.0, 12.5 Gflop/s
+		for size =                                      50,  100,  200,  500, 1000, 2000.
 	*/
+	if (shouldUsePackedMultiplication (target, x)) {
+		_mul_packed_MAT_out (target, x, y);
+		return;
+	}
 	if (x.colStride == 1) {
 		if (y.rowStride == 1) {
 			for (integer irow = 1; irow <= target.nrow; irow ++) {
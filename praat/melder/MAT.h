@@ -332,9 +332,14 @@ extern void centreEachRow_MAT_inout (MATVU const& x) noexcept;
 extern void doubleCentre_MAT_inout (MATVU const& x) noexcept;
 
 extern void mtm_MAT_out (MATVU const& target, constMATVU const& x) noexcept;
+/*
+	Parselmouth: as mtm_MAT_out, but for larger matrices the packed, register-blocked and multithreaded
+	multiplication is used, which allocates its buffers.
+*/
+extern void mtm_allowAllocation_MAT_out (MATVU const& target, constMATVU const& x);
 inline autoMAT mtm_MAT (constMATVU const& x) {
 	autoMAT result = raw_MAT (x.ncol, x.ncol);
-	mtm_MAT_out (result.get(), x);
+	mtm_allowAllocation_MAT_out (result.get(), x);
 	return result;
 }
 
@@ -374,6 +379,8 @@ inline autoMAT newMATmul_forceAllocation (constMATVU const& x, constMATVU const&
 /*
 	The faster of mul_forceAllocation_MAT_out and mul_MAT_out.
 	Because of the use of malloc, this function may not be thread-safe.
+	Parselmouth: above 100,000 multiply-adds, the packed, register-blocked and multithreaded multiplication is used,
+	which sums in double precision.
 */
 extern void _mul_allowAllocation_MAT_out (MATVU const& target, constMATVU x, constMATVU y);
 inline void mul_allowAllocation_MAT_out  (MATVU const& target, constMATVU x, constMATVU y) {
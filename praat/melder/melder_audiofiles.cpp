@@ -688,21 +688,29 @@ static void Melder_checkNistFile (FILE *f, integer *numberOfChannels, int *encod
 	}
 }
 
-static void Melder_checkFlacFile (MelderFile file, integer *numberOfChannels, int *encoding,
+static void Melder_checkFlacFile (FILE *f, integer *numberOfChannels, int *encoding,
 	double *sampleRate, integer *startOfData, integer *numberOfSamples)
 {
-	FLAC__StreamMetadata metadata;
-	FLAC__StreamMetadata_StreamInfo *info;
-	if (! FLAC__metadata_get_streaminfo (Melder_peek32to8_fileSystem (Melder_fileToPath (file)), & metadata))   // FIXME: not Unicode-compatible on Windows.
+	/*
+		Parselmouth: read the STREAMINFO block (which the FLAC format requires to be the first metadata block)
+		from the open stream, instead of having libFLAC reopen the file by its path,
+		so that FLAC data can also be read from streams that have no path, such as memory.
+	*/
+	uint8 header [4 + 4 + 34];
+	if (fread (header, 1, sizeof header, f) != sizeof header || ! strnequ ((const char *) header, "fLaC", 4) ||
+			(header [4] & 0x7F) != 0)   // the first metadata block should be STREAMINFO
 		Melder_throw (U"Invalid FLAC file");
-	info = & metadata. data. stream_info;
-	*numberOfChannels = info -> channels;
+	const uint8 *info = & header [8];
+	*numberOfChannels = ((info [12] >> 1) & 0x07) + 1;
 	*encoding = Melder_FLAC_COMPRESSION_16;
-	*sampleRate = (double) info -> sample_rate;
+	*sampleRate = (double) (((uint32) info [10] << 12) | ((uint32) info [11] << 4) | ((uint32) info [12] >> 4));
 	*startOfData = 0;   // meaningless: libFLAC does the I/O
-	*numberOfSamples = info -> total_samples;   // BUG: loses bits above INT32_MAX
-	if ((FLAC__uint64) *numberOfSamples != info -> total_samples)
+	const uint64 totalSamples = ((uint64) (info [13] & 0x0F) << 32) | ((uint64) info [14] << 24) |
+			((uint64) info [15] << 16) | ((uint64) info [16] << 8) | (uint64) info [17];
+	*numberOfSamples = (integer) totalSamples;   // BUG: loses bits above INT32_MAX
+	if ((uint64) *numberOfSamples != totalSamples)
 		Melder_throw (U"FLAC file too long.");
+	rewind (f);
 }
 
 static void Melder_checkMp3File (FILE *f, integer *numberOfChannels, int *encoding,
@@ -752,7 +760,7 @@ int MelderFile_checkSoundFile (MelderFile file, integer *numberOfChannels, int *
 		return Melder_NIST;
 	}
 	if (strnequ (data, "fLaC", 4)) {
-		Melder_checkFlacFile (file, numberOfChannels, encoding, sampleRate, startOfData, numberOfSamples);
+		Melder_checkFlacFile (f, numberOfChannels, encoding, sampleRate, startOfData, numberOfSamples);
 		return Melder_FLAC;
 	}
 	if (mp3_recognize (16, data)) {
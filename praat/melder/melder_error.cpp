@@ -40,7 +40,7 @@ void Melder_setCrashProc (void (*p_crashProc) (conststring32)) {
 }
 
 constexpr integer BUFFER_LENGTH = 2000;
-static char32 theErrorBuffer [BUFFER_LENGTH];   // safe in low-memory situations
+static thread_local char32 theErrorBuffer [BUFFER_LENGTH];   // safe in low-memory situations; Parselmouth: thread-local, so that analyses can run concurrently without the GIL
 
 void MelderError::_append (conststring32 message) {
 	if (! message)
@@ -106,7 +106,7 @@ void Melder_flushError () {
 			and some operating systems may force an immediate redraw event as soon as
 			the message dialog is closed. We want "errors" to be empty when redrawing!
 		*/
-		static char32 temp [BUFFER_LENGTH];
+		static thread_local char32 temp [BUFFER_LENGTH];   // Parselmouth: thread-local, like theErrorBuffer
 		str32cpy (temp, theErrorBuffer);
 		theErrorBuffer [0] = U'\0';
 		(*p_theErrorProc) (temp);
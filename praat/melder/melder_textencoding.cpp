@@ -200,8 +200,8 @@ int64 Melder_length_utf16 (conststring32 string, bool nativizeNewlines) {
 conststring32 Melder_peek8to32 (conststring8 textA) {
 	if (! textA)
 		return nullptr;
-	static MelderString buffers [19];
-	static int ibuffer = 0;
+	static thread_local MelderString buffers [19];   // Parselmouth: thread-local, for concurrent analyses
+	static thread_local int ibuffer = 0;
 	if (++ ibuffer == 11)
 		ibuffer = 0;
 	MelderString_empty (& buffers [ibuffer]);
@@ -434,8 +434,8 @@ autostring32 Melder_8to32 (const char *string) {
 conststring32 Melder_peek16to32 (conststring16 text) {
 	if (! text)
 		return nullptr;
-	static MelderString buffers [19];
-	static int bufferNumber = 0;
+	static thread_local MelderString buffers [19];   // Parselmouth: thread-local, for concurrent analyses
+	static thread_local int bufferNumber = 0;
 	if (++ bufferNumber == 19)
 		bufferNumber = 0;
 	MelderString_empty (& buffers [bufferNumber]);
@@ -18,7 +18,7 @@
 
 #include "melder.h"
 
-int MelderWarning::_depth = 0;
+thread_local int MelderWarning::_depth = 0;
 
 void MelderWarning::_defaultProc (conststring32 message) {
 	MelderConsole::write (U"Warning: ", true);
@@ -28,7 +28,7 @@ void MelderWarning::_defaultProc (conststring32 message) {
 
 MelderWarning::Proc MelderWarning::_p_currentProc = & MelderWarning::_defaultProc;
 
-MelderString MelderWarning::_buffer;
+thread_local MelderString MelderWarning::_buffer;
 
 void Melder_warningOff () { MelderWarning::_depth --; }
 void Melder_warningOn () { MelderWarning::_depth ++; }
@@ -28,8 +28,8 @@
 */
 
 namespace MelderWarning {
-	extern int _depth;
-	extern MelderString _buffer;
+	extern thread_local int _depth;   // Parselmouth: warning state is per thread
+	extern thread_local MelderString _buffer;
 	using Proc = void (*) (conststring32 message);
 	void _defaultProc (conststring32 message);
 	extern Proc _p_currentProc;
@@ -2030,24 +2030,20 @@ static void assignToStringArrayElement (Interpreter me, char32 *& p, const char3
 	var -> stringArrayValue [indexValue] = value. move();
 }
 
-void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
+/*
+	Parselmouth: splitting the text into lines, finding the labels, and connecting the continuation lines
+	has been separated from running the lines, such that a script can be compiled once and run many times.
+*/
+void Interpreter_compile (Interpreter me, char32 *text) {
 	autovector <mutablestring32> lines;   // not autostringvector, because the elements are reference copies
 	integer lineNumber = 0;
-	bool assertionFailed = false;
 	try {
-		static MelderString valueString;   // to divert the info
-		static MelderString assertErrorString;
 		char32 *command = text;
 		autoMelderString command2;
-		autoMelderString buffer;
-		integer numberOfLines = 0, assertErrorLineNumber = 0, callStack [1 + Interpreter_MAX_CALL_DEPTH];
-		bool atLastLine = false, fromif = false, fromendfor = false;
-		int callDepth = 0, chopped = 0, ipar;
-		my callDepth = 0;
-		/*
-			Start.
-		*/
-		my running = true;
+		integer numberOfLines = 0;
+		bool atLastLine = false;
+		int chopped = 0;
+		my numberOfLabels = 0;
 		/*
 			Count lines and set the newlines to zero.
 		*/
@@ -2108,6 +2104,79 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 				lines [lineNumber] = emptyLine;
 			}
 		}
+		my compiledLines = lines.move();
+	} catch (MelderError) {
+		my numberOfLabels = 0;
+		if (lineNumber > 0 && lineNumber <= lines.size)
+			Melder_appendError (U"Script line ", lineNumber, U" not performed or completed:\n« ", lines [lineNumber], U" »");
+		throw;
+	}
+}
+
+static bool lineStartsWithKeyword (conststring32 line, conststring32 keyword) {
+	const integer length = Melder_length (keyword);
+	return str32nequ (line, keyword, length) && (! Melder_staysWithinInk (line [length]) || line [length] == U';');
+}
+
+void Interpreter_checkCompiledBlocks (Interpreter me) {
+	constexpr conststring32 blockEnds [] = { U"endif", U"endfor", U"endwhile", U"until", U"endproc" };
+	std::vector <std::pair <int, integer>> openBlocks;   // the kind of block (index into blockEnds) and its first line
+	auto closeBlock = [&] (int kind, integer lineNumber) {
+		if (openBlocks.empty () || openBlocks.back ().first != kind)
+			Melder_throw (U"Unmatched '", blockEnds [kind], U"' in script line ", lineNumber, U":\n« ", my compiledLines [lineNumber], U" »");
+		openBlocks.pop_back ();
+	};
+	for (integer lineNumber = 1; lineNumber <= my compiledLines.size; lineNumber ++) {
+		conststring32 line = my compiledLines [lineNumber];
+		if (line [0] == U'i' && line [1] == U'f' && Melder_isHorizontalSpace (line [2]))
+			openBlocks.emplace_back (0, lineNumber);
+		else if (str32nequ (line, U"for ", 4))
+			openBlocks.emplace_back (1, lineNumber);
+		else if (str32nequ (line, U"while ", 6))
+			openBlocks.emplace_back (2, lineNumber);
+		else if (lineStartsWithKeyword (line, U"repeat"))
+			openBlocks.emplace_back (3, lineNumber);
+		else if (str32nequ (line, U"procedure ", 10))
+			openBlocks.emplace_back (4, lineNumber);
+		else if (lineStartsWithKeyword (line, U"endif"))
+			closeBlock (0, lineNumber);
+		else if (lineStartsWithKeyword (line, U"endfor"))
+			closeBlock (1, lineNumber);
+		else if (lineStartsWithKeyword (line, U"endwhile"))
+			closeBlock (2, lineNumber);
+		else if (str32nequ (line, U"until ", 6))
+			closeBlock (3, lineNumber);
+		else if (lineStartsWithKeyword (line, U"endproc"))
+			closeBlock (4, lineNumber);
+		else if (lineStartsWithKeyword (line, U"else") || str32nequ (line, U"elsif ", 6) || str32nequ (line, U"elif ", 5)) {
+			if (openBlocks.empty () || openBlocks.back ().first != 0)
+				Melder_throw (U"'else' or 'elsif' outside 'if' in script line ", lineNumber, U":\n« ", line, U" »");
+		}
+	}
+	if (! openBlocks.empty ()) {
+		const auto [kind, lineNumber] = openBlocks.back ();
+		Melder_throw (U"Unmatched block (matching '", blockEnds [kind], U"' not found) in script line ", lineNumber, U":\n« ", my compiledLines [lineNumber], U" »");
+	}
+}
+
+void Interpreter_runCompiled (Interpreter me, const bool reuseVariables) {
+	autovector <mutablestring32>& lines = my compiledLines;
+	const integer numberOfLines = lines.size;
+	integer lineNumber = 0;
+	bool assertionFailed = false;
+	try {
+		static MelderString valueString;   // to divert the info
+		static MelderString assertErrorString;
+		autoMelderString command2;
+		autoMelderString buffer;
+		integer assertErrorLineNumber = 0, callStack [1 + Interpreter_MAX_CALL_DEPTH];
+		bool fromif = false, fromendfor = false;
+		int callDepth = 0, ipar;
+		my callDepth = 0;
+		/*
+			Start.
+		*/
+		my running = true;
 		/*
 			Copy the parameter names and argument values into the array of variables.
 		*/
@@ -3443,7 +3512,6 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 				}
 			}
 		} // endfor lineNumber
-		my numberOfLabels = 0;
 		my running = false;
 		my stopped = false;
 	} catch (MelderError) {
@@ -3457,7 +3525,6 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 				Melder_appendError (U"Script line ", lineNumber, U" not performed or completed:\n« ", lines [lineNumber], U" »");
 			}
 		}
-		my numberOfLabels = 0;
 		my running = false;
 		my stopped = false;
 		if (Melder_hasCrash ()) {
@@ -3470,6 +3537,11 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 	}
 }
 
+void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
+	Interpreter_compile (me, text);
+	Interpreter_runCompiled (me, reuseVariables);
+}
+
 void Interpreter_stop (Interpreter me) {
 //Melder_casual (U"Interpreter_stop in: ", Melder_pointer (me));
 	my stopped = true;
@@ -160,6 +160,7 @@ Thing_define (Interpreter, Thing) {
 	autostring32 dialogTitle;
 	char32 procedureNames [1+Interpreter_MAX_CALL_DEPTH] [100];
 	std::unordered_map <std::u32string, autoInterpreterVariable> variablesMap;
+	autovector <mutablestring32> compiledLines;   // Parselmouth: the lines of the script text, as split by Interpreter_compile
 	bool running, stopped;
 
 	kInterpreter_ReturnType returnType;   // automatically initialized as kInterpreter_ReturnType::VOID_
@@ -192,6 +193,15 @@ void Interpreter_getArgumentsFromString (Interpreter me, conststring32 arguments
 void Interpreter_getArgumentsFromArgs (Interpreter me, integer nargs, Stackel args);
 void Interpreter_getArgumentsFromCommandLine (Interpreter me, integer argc, char **argv);
 void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables);   // destroys 'text'
+/*
+	Parselmouth: Interpreter_run is Interpreter_compile followed by Interpreter_runCompiled.
+	The compiled lines point into 'text', which has to outlive every run of the compiled script;
+	Interpreter_checkCompiledBlocks checks that the compiled lines' blocks (if, for, while, repeat, procedure) are closed;
+	this is stricter than Interpreter_run, which only complains about the blocks of the lines that it runs or skips over.
+*/
+void Interpreter_compile (Interpreter me, char32 *text);   // destroys 'text'
+void Interpreter_checkCompiledBlocks (Interpreter me);
+void Interpreter_runCompiled (Interpreter me, const bool reuseVariables);
 void Interpreter_stop (Interpreter me);   // can be called from any procedure called deep-down by the interpreter; will stop before next line
 
 void Interpreter_voidExpression (Interpreter me, conststring32 expression);
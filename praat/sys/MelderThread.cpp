@@ -0,0 +1,293 @@
+/* MelderThread.cpp
+ *
+ * Copyright (C) 2026 Yannick Jadoul
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MelderThread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+/*
+	The state shared by all threads working on one call to MelderThread_runChunks.
+	Helper tasks can still be in the queue after the call has returned, so they keep the batch alive through a shared_ptr;
+	they will then find no more items to take and will not touch 'work'.
+*/
+struct ChunkBatch {
+	ChunkBatch (integer numberOfItems, integer numberOfThreads, std::function <void (integer, integer, integer)> const& work, integer maximumChunkSize) :
+		numberOfItems (numberOfItems), numberOfThreads (numberOfThreads), maximumChunkSize (maximumChunkSize), work (& work),
+		ranges (std::make_unique <Range []> (integer_to_uinteger (numberOfThreads)))
+	{
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			ranges [ithread - 1]. next = 1 + (ithread - 1) * numberOfItems / numberOfThreads;
+			ranges [ithread - 1]. end = 1 + ithread * numberOfItems / numberOfThreads;
+		}
+	}
+
+	const integer numberOfItems, numberOfThreads, maximumChunkSize;
+	std::function <void (integer, integer, integer)> const *work;
+
+	struct Range {
+		std::mutex mutex;
+		integer next = 1, end = 1;   // the items still to be done are next .. end - 1
+	};
+	std::unique_ptr <Range []> ranges;
+
+	std::atomic <integer> nextHelper { 2 };   // participant 1 is the calling thread
+	std::atomic <integer> numberOfFinishedItems { 0 };
+	std::atomic <bool> failed { false };
+
+	std::mutex mutex;
+	std::condition_variable allItemsFinished;
+	std::exception_ptr error;
+	autostring32 errorMessage;   // the Melder error buffer is thread-local, so the message has to travel along
+
+	bool takeChunk (integer ithread, integer *out_first, integer *out_last) {
+		Range& own = ranges [ithread - 1];
+		std::lock_guard <std::mutex> lock (own. mutex);
+		const integer remaining = own. end - own. next;
+		if (remaining <= 0)
+			return false;
+		integer chunkSize = Melder_clippedLeft (1_integer, remaining / 4);   // guided: large chunks first, small ones near the end
+		if (maximumChunkSize > 0)
+			Melder_clipRight (& chunkSize, maximumChunkSize);
+		*out_first = own. next;
+		*out_last = own. next + chunkSize - 1;
+		own. next += chunkSize;
+		return true;
+	}
+
+	bool steal (integer ithread) {
+		for (;;) {
+			integer victim = 0, largestRemaining = 0;
+			for (integer jthread = 1; jthread <= numberOfThreads; jthread ++) {
+				if (jthread == ithread)
+					continue;
+				Range& other = ranges [jthread - 1];
+				std::lock_guard <std::mutex> lock (other. mutex);
+				if (other. end - other. next > largestRemaining) {
+					largestRemaining = other. end - other. next;
+					victim = jthread;
+				}
+			}
+			if (victim == 0)
+				return false;
+			integer first, end;
+			{
+				Range& other = ranges [victim - 1];
+				std::lock_guard <std::mutex> lock (other. mutex);
+				const integer remaining = other. end - other. next;
+				if (remaining <= 0)
+					continue;   // someone else got there first; look again
+				end = other. end;
+				first = other. end - (remaining + 1) / 2;
+				other. end = first;
+			}
+			Range& own = ranges [ithread - 1];
+			std::lock_guard <std::mutex> lock (own. mutex);
+			own. next = first;
+			own. end = end;
+			return true;
+		}
+	}
+
+	void participate (integer ithread) {
+		do {
+			integer first, last;
+			while (takeChunk (ithread, & first, & last)) {
+				if (! failed) {
+					try {
+						(*work) (first, last, ithread);
+					} catch (MelderError) {
+						std::lock_guard <std::mutex> lock (mutex);
+						if (! error) {
+							errorMessage = Melder_dup (Melder_getError ());
+							error = std::current_exception ();
+						}
+						if (! Melder_hasCrash ())
+							Melder_clearError ();
+						failed = true;
+					} catch (...) {
+						std::lock_guard <std::mutex> lock (mutex);
+						if (! error)
+							error = std::current_exception ();
+						failed = true;
+					}
+				}
+				if ((numberOfFinishedItems += last - first + 1) == numberOfItems) {
+					std::lock_guard <std::mutex> lock (mutex);
+					allItemsFinished. notify_all ();
+				}
+			}
+		} while (steal (ithread));
+	}
+
+	void help () {
+		const integer ithread = nextHelper ++;
+		if (ithread <= numberOfThreads)
+			participate (ithread);
+	}
+
+	void wait () {
+		std::unique_lock <std::mutex> lock (mutex);
+		allItemsFinished. wait (lock, [this] () { return numberOfFinishedItems == numberOfItems; });
+	}
+};
+
+class ThreadPool {
+public:
+	ThreadPool () : numberOfThreads (defaultNumberOfThreads ()) { }
+
+	~ThreadPool () {
+		{
+			std::lock_guard <std::mutex> lock (mutex);
+			stopping = true;
+		}
+		taskAvailable. notify_all ();
+		for (std::thread& worker : workers)
+			worker. join ();
+	}
+
+	integer getNumberOfThreads () {
+		std::lock_guard <std::mutex> lock (mutex);
+		return numberOfThreads;
+	}
+
+	void setNumberOfThreads (integer newNumberOfThreads) {
+		std::lock_guard <std::mutex> lock (mutex);
+		numberOfThreads = ( newNumberOfThreads > 0 ? newNumberOfThreads : defaultNumberOfThreads () );
+	}
+
+	void submit (std::shared_ptr <ChunkBatch> const& batch, integer numberOfHelpers) {
+		{
+			std::lock_guard <std::mutex> lock (mutex);
+			while (integer (workers. size ()) < numberOfHelpers)
+				workers. emplace_back ([this] () { work (); });   // workers are started lazily, and stay alive until the end of the process
+			for (integer ihelper = 1; ihelper <= numberOfHelpers; ihelper ++)
+				tasks. push_back (batch);
+		}
+		if (numberOfHelpers == 1)
+			taskAvailable. notify_one ();
+		else
+			taskAvailable. notify_all ();
+	}
+
+private:
+	static integer defaultNumberOfThreads () {
+		return Melder_clippedLeft (1_integer, MelderThread_getNumberOfProcessors ());
+	}
+
+	void work () {
+		for (;;) {
+			std::shared_ptr <ChunkBatch> batch;
+			{
+				std::unique_lock <std::mutex> lock (mutex);
+				taskAvailable. wait (lock, [this] () { return stopping || ! tasks. empty (); });
+				if (stopping)
+					return;
+				batch = std::move (tasks. front ());
+				tasks. pop_front ();
+			}
+			batch -> help ();
+		}
+	}
+
+	std::mutex mutex;
+	std::condition_variable taskAvailable;
+	std::deque <std::shared_ptr <ChunkBatch>> tasks;
+	std::vector <std::thread> workers;
+	integer numberOfThreads;
+	bool stopping = false;
+};
+
+ThreadPool& thePool () {
+	static ThreadPool pool;
+	return pool;
+}
+
+} // namespace
+
+static thread_local integer theMaximumNumberOfThreadsForThisThread = 0;
+
+autoMelderThreadLimit :: autoMelderThreadLimit (integer maximumNumberOfThreads) :
+	_previousMaximumNumberOfThreads (theMaximumNumberOfThreadsForThisThread)
+{
+	theMaximumNumberOfThreadsForThisThread = maximumNumberOfThreads;
+}
+
+autoMelderThreadLimit :: ~autoMelderThreadLimit () {
+	theMaximumNumberOfThreadsForThisThread = _previousMaximumNumberOfThreads;
+}
+
+integer MelderThread_getNumberOfThreads () {
+	return thePool (). getNumberOfThreads ();
+}
+
+void MelderThread_setNumberOfThreads (integer numberOfThreads) {
+	thePool (). setNumberOfThreads (numberOfThreads);
+}
+
+integer MelderThread_getNumberOfThreadsForItems (integer numberOfItems, integer minimumNumberOfItemsPerThread, integer maximumNumberOfThreads) {
+	integer numberOfThreads = MelderThread_getNumberOfThreads ();
+	if (maximumNumberOfThreads > 0)
+		Melder_clipRight (& numberOfThreads, maximumNumberOfThreads);
+	if (theMaximumNumberOfThreadsForThisThread > 0)
+		Melder_clipRight (& numberOfThreads, theMaximumNumberOfThreadsForThisThread);
+	if (minimumNumberOfItemsPerThread > 0)
+		Melder_clipRight (& numberOfThreads, numberOfItems / minimumNumberOfItemsPerThread);
+	else
+		Melder_clipRight (& numberOfThreads, numberOfItems);
+	return Melder_clippedLeft (1_integer, numberOfThreads);
+}
+
+void MelderThread_runChunks (integer numberOfItems, integer numberOfThreads,
+	std::function <void (integer, integer, integer)> const& work, integer maximumChunkSize)
+{
+	if (numberOfItems <= 0)
+		return;
+	Melder_clip (1_integer, & numberOfThreads, numberOfItems);
+	if (numberOfThreads == 1) {
+		work (1, numberOfItems, 1);
+		return;
+	}
+	auto batch = std::make_shared <ChunkBatch> (numberOfItems, numberOfThreads, work, maximumChunkSize);
+	thePool (). submit (batch, numberOfThreads - 1);
+	batch -> participate (1);
+	batch -> wait ();
+	if (batch -> error) {
+		if (batch -> errorMessage)
+			MelderError::_append (batch -> errorMessage.get());
+		std::rethrow_exception (batch -> error);
+	}
+}
+
+void MelderThread_runJobs (integer numberOfJobs, std::function <void (integer)> const& job, integer maximumNumberOfThreads) {
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsForItems (numberOfJobs, 1, maximumNumberOfThreads);
+	MelderThread_runChunks (numberOfJobs, numberOfThreads,
+		[&] (integer firstJob, integer lastJob, integer /* ithread */) {
+			for (integer ijob = firstJob; ijob <= lastJob; ijob ++)
+				job (ijob);
+		}, 1
+	);
+}
+
+/* End of file MelderThread.cpp */
@@ -2,7 +2,7 @@
 #define _MelderThread_h_
 /* MelderThread.h
  *
- * Copyright (C) 2014-2018,2020 Paul Boersma
+ * Copyright (C) 2014-2018,2020 Paul Boersma, 2026 Yannick Jadoul
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -18,6 +18,7 @@
  * along with this work. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <functional>
 #include <vector>
 #include "Thing.h"
 #include <thread>
@@ -26,25 +27,55 @@ inline integer MelderThread_getNumberOfProcessors () {
 	return uinteger_to_integer (std::thread::hardware_concurrency ());
 }
 
+/*
+	Parselmouth: all threading goes through one persistent, process-wide, work-stealing pool of worker threads,
+	rather than creating and joining fresh std::threads on every call.
+
+	MelderThread_runChunks (numberOfItems, numberOfThreads, work, maximumChunkSize)
+		processes the items 1 .. numberOfItems by calling work (firstItem, lastItem, ithread) on consecutive chunks,
+		with ithread (1 .. numberOfThreads) identifying the participating thread, so that 'work' can use
+		per-thread scratch memory that is allocated once and reused for all chunks that thread processes.
+		The items are initially divided evenly over the participants; each participant takes ever smaller chunks
+		from the front of its own range (guided scheduling, limited by 'maximumChunkSize' if positive), and steals
+		the back half of the largest remaining range once its own range is exhausted.
+		The calling thread is participant 1 and can do all the work itself, so nested calls (e.g. from inside
+		a chunk) cannot deadlock, even when all workers are busy.
+		If 'work' throws, the remaining chunks are skipped and the first exception (including its Melder error
+		message, since the error buffer is thread-local) is rethrown in the calling thread.
+
+	MelderThread_runJobs (numberOfJobs, job, maximumNumberOfThreads)
+		calls job (ijob) for ijob = 1 .. numberOfJobs, one job at a time per thread.
+		A 'maximumNumberOfThreads' of 0 or less means "as many threads as the pool has".
+*/
+void MelderThread_runChunks (integer numberOfItems, integer numberOfThreads,
+	std::function <void (integer firstItem, integer lastItem, integer ithread)> const& work, integer maximumChunkSize = 0);
+
+void MelderThread_runJobs (integer numberOfJobs, std::function <void (integer ijob)> const& job, integer maximumNumberOfThreads = 0);
+
+integer MelderThread_getNumberOfThreads ();
+	/* The number of threads (including the calling thread) the pool uses at most; defaults to the number of processors. */
+void MelderThread_setNumberOfThreads (integer numberOfThreads);
+	/* 0 or less: back to the number of processors. */
+
+integer MelderThread_getNumberOfThreadsForItems (integer numberOfItems, integer minimumNumberOfItemsPerThread, integer maximumNumberOfThreads = 0);
+	/* How many threads are worth starting for 'numberOfItems' items: at least 1, at most the pool size (and 'maximumNumberOfThreads', if positive). */
+
+/*
+	Parselmouth: while an autoMelderThreadLimit exists, MelderThread_getNumberOfThreadsForItems returns at most
+	'maximumNumberOfThreads' (if positive) in the thread that created it, such that a single analysis can be
+	restricted to fewer threads than the pool has.
+*/
+class autoMelderThreadLimit {
+	integer _previousMaximumNumberOfThreads;
+public:
+	explicit autoMelderThreadLimit (integer maximumNumberOfThreads);
+	~autoMelderThreadLimit ();
+	autoMelderThreadLimit (const autoMelderThreadLimit&) = delete;
+	autoMelderThreadLimit& operator= (const autoMelderThreadLimit&) = delete;
+};
+
 template <class T> void MelderThread_run (void (*func) (T *), autoSomeThing <T> *args, integer numberOfThreads) {
-	uinteger unsignedNumberOfThreads = integer_to_uinteger (numberOfThreads);
-	if (unsignedNumberOfThreads == 1) {
-		func (args [0].get());
-	} else {
-		std::vector <std::thread> thread (unsignedNumberOfThreads);
-		try {
-			for (uinteger ithread = 1; ithread < unsignedNumberOfThreads; ithread ++)
-				thread [ithread - 1] = std::thread (func, args [ithread - 1].get());
-			func (args [unsignedNumberOfThreads - 1].get());
-		} catch (MelderError) {
-			for (uinteger ithread = 1; ithread < unsignedNumberOfThreads; ithread ++)
-				if (thread [ithread - 1]. joinable ())
-					thread [ithread - 1]. join ();
-			throw;
-		}
-		for (uinteger ithread = 1; ithread < unsignedNumberOfThreads; ithread ++)
-			thread [ithread - 1]. join ();
-	}
+	MelderThread_runJobs (numberOfThreads, [&] (integer ithread) { func (args [ithread - 1].get()); }, numberOfThreads);
 }
 
 /* End of file MelderThread.h */
@@ -136,6 +136,7 @@ Praat_Command praat_doMenuCommand (conststring32 command, conststring32 argument
 Praat_Command praat_doMenuCommand (conststring32 command, integer narg, Stackel args, Interpreter interpreter);   // nullptr = not found
 integer praat_getNumberOfMenuCommands ();
 Praat_Command praat_getMenuCommand (integer i);
+integer praat_getMenuCommandsGeneration ();   // Parselmouth: changes whenever menu commands are added, sorted, hidden, or shown
 
 /* Communication with praat_actions.cpp: */
 void praat_actions_show ();
@@ -148,6 +149,7 @@ Praat_Command praat_doAction (conststring32 command, conststring32 arguments, In
 Praat_Command praat_doAction (conststring32 command, integer narg, Stackel args, Interpreter interpreter);   // nullptr = not found
 integer praat_getNumberOfActions ();   // for ButtonEditor
 Praat_Command praat_getAction (integer i);   // for ButtonEditor
+integer praat_getActionsGeneration ();   // Parselmouth: changes whenever actions are added, removed, sorted, hidden, or shown
 
 /* Communication with praat_statistics.cpp: */
 void praat_statistics_prefs ();   // at init time
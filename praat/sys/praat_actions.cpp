@@ -23,6 +23,9 @@
 #include "machine.h"
 #include "GuiP.h"
 
+#include <unordered_map>
+#include <vector>
+
 #define BUTTON_LEFT  -240
 #define BUTTON_RIGHT -5
 
@@ -33,6 +36,42 @@ static GuiMenuItem praat_writeMenuSeparator;
 static GuiForm praat_form;
 static bool actionsInvisible = false;
 
+/*
+	Parselmouth: an index of the actions by title, so that praat_doAction does not have to compare
+	the title of every action; it is emptied whenever theActions change, and rebuilt on the next look-up.
+	Every change (including hiding or showing an action) also increments theActionsGeneration, so that callers
+	that keep a Praat_Command (e.g. Parselmouth's prepared commands) can tell that it may have been removed or hidden.
+*/
+static std::unordered_map <std::u32string, std::vector <Praat_Command>> theActionsByTitle;
+
+static integer theActionsGeneration = 0;
+
+static void actionsChanged () {
+	theActionsByTitle.clear ();
+	theActionsGeneration += 1;
+}
+
+integer praat_getActionsGeneration () {
+	return theActionsGeneration;
+}
+
+static Praat_Command findExecutableActionByTitle (conststring32 title) {
+	if (theActionsByTitle.empty ()) {
+		for (integer i = 1; i <= theActions.size; i ++) {
+			Praat_Command action = theActions.at [i];
+			if (action -> title)
+				theActionsByTitle [action -> title.get()]. push_back (action);
+		}
+	}
+	const auto found = theActionsByTitle.find (title);
+	if (found == theActionsByTitle.end ())
+		return nullptr;
+	for (const Praat_Command action : found -> second)
+		if (action -> executable)
+			return action;
+	return nullptr;
+}
+
 static void fixSelectionSpecification (ClassInfo *class1, integer *n1, ClassInfo *class2, integer *n2, ClassInfo *class3, integer *n3) {
 /*
 	Function:
@@ -182,6 +221,7 @@ static void praat_addAction4__ (ClassInfo class1, integer n1, ClassInfo class2,
 			Insert new command.
 		*/
 		theActions. addItemAtPosition_move (action.move(), position);
+		actionsChanged ();   // Parselmouth
 	} catch (MelderError) {
 		Melder_flushError ();
 	}
@@ -294,8 +334,10 @@ void praat_addActionScript (conststring32 className1, integer n1, conststring32
 		*/
 		{// scope
 			integer found = lookUpMatchingAction (class1, class2, class3, nullptr, title);
-			if (found)
+			if (found) {
 				theActions. removeItem (found);
+				actionsChanged ();   // Parselmouth
+			}
 		}
 
 		/*
@@ -345,6 +387,7 @@ void praat_addActionScript (conststring32 className1, integer n1, conststring32
 			Insert new command.
 		*/
 		theActions. addItemAtPosition_move (action.move(), position);
+		actionsChanged ();   // Parselmouth
 		updateDynamicMenu ();
 	} catch (MelderError) {
 		Melder_throw (U"Praat: script action not added.");
@@ -364,6 +407,7 @@ void praat_removeAction (ClassInfo class1, ClassInfo class2, ClassInfo class3, c
 			);
 		}
 		theActions. removeItem (found);
+		actionsChanged ();   // Parselmouth
 	} catch (MelderError) {
 		Melder_throw (U"Praat: action not removed.");
 	}
@@ -405,6 +449,7 @@ void praat_hideAction (ClassInfo class1, ClassInfo class2, ClassInfo class3, con
 			action -> hidden = true;
 			if (praatP.phase >= praat_READING_BUTTONS)
 				action -> toggled = ! action -> toggled;
+			actionsChanged ();   // Parselmouth
 			updateDynamicMenu ();
 		}
 	} catch (MelderError) {
@@ -447,6 +492,7 @@ void praat_showAction (ClassInfo class1, ClassInfo class2, ClassInfo class3, con
 			action -> hidden = false;
 			if (praatP.phase >= praat_READING_BUTTONS)
 				action -> toggled = ! action -> toggled;
+			actionsChanged ();   // Parselmouth
 			updateDynamicMenu ();
 		}
 	} catch (MelderError) {
@@ -501,6 +547,7 @@ void praat_sortActions () {
 			return my sortingTail < thy sortingTail;
 		}
 	);
+	actionsChanged ();   // Parselmouth
 }
 
 static conststring32 numberString (integer number) {
@@ -792,14 +839,7 @@ void praat_saveToggledActions (MelderString *buffer) {
 }
 
 Praat_Command praat_doAction (conststring32 title, conststring32 arguments, Interpreter interpreter) {
-	Praat_Command actionFound = nullptr;
-	for (integer i = 1; i <= theActions.size; i ++) {
-		Praat_Command action = theActions.at [i];
-		if (action -> executable && str32equ (action -> title.get(), title)) {
-			actionFound = action;
-			break;
-		}
-	}
+	Praat_Command actionFound = findExecutableActionByTitle (title);   // Parselmouth: was a linear search through theActions
 	if (! actionFound)
 		return nullptr;
 	if (actionFound -> callback == DO_RunTheScriptFromAnyAddedMenuCommand) {
@@ -822,14 +862,7 @@ Praat_Command praat_doAction (conststring32 title, conststring32 arguments, Inte
 }
 
 Praat_Command praat_doAction (conststring32 title, integer narg, Stackel args, Interpreter interpreter) {
-	Praat_Command actionFound = nullptr;
-	for (integer i = 1; i <= theActions.size; i ++) {
-		Praat_Command action = theActions.at [i];
-		if (action -> executable && str32equ (action -> title.get(), title)) {
-			actionFound = action;
-			break;
-		}
-	}
+	Praat_Command actionFound = findExecutableActionByTitle (title);   // Parselmouth: was a linear search through theActions
 	if (! actionFound)
 		return nullptr;
 	if (actionFound -> callback == DO_RunTheScriptFromAnyAddedMenuCommand) {
@@ -21,9 +21,48 @@
 #include "praat_version.h"
 #include "GuiP.h"
 
+#include <unordered_map>
+#include <vector>
+
 static OrderedOf <structPraat_Command> theCommands;
 void praat_menuCommands_exit_optimizeByLeaking () { theCommands. _ownItems = false; }
 
+/*
+	Parselmouth: an index of the Objects and Picture window commands by title, so that praat_doMenuCommand does not
+	have to compare the title of every command; it is emptied whenever theCommands change, and rebuilt on the next look-up.
+	Every change (including hiding or showing a command) also increments theMenuCommandsGeneration, so that callers
+	that keep a Praat_Command (e.g. Parselmouth's prepared commands) can tell that it may have been removed or hidden.
+*/
+static std::unordered_map <std::u32string, std::vector <Praat_Command>> theObjectsAndPictureCommandsByTitle;
+
+static integer theMenuCommandsGeneration = 0;
+
+static void menuCommandsChanged () {
+	theObjectsAndPictureCommandsByTitle.clear ();
+	theMenuCommandsGeneration += 1;
+}
+
+integer praat_getMenuCommandsGeneration () {
+	return theMenuCommandsGeneration;
+}
+
+static Praat_Command findExecutableObjectsOrPictureCommandByTitle (conststring32 title) {
+	if (theObjectsAndPictureCommandsByTitle.empty ()) {
+		for (integer i = 1; i <= theCommands.size; i ++) {
+			Praat_Command command = theCommands.at [i];
+			if (command -> title && (str32equ (command -> window.get(), U"Objects") || str32equ (command -> window.get(), U"Picture")))
+				theObjectsAndPictureCommandsByTitle [command -> title.get()]. push_back (command);
+		}
+	}
+	const auto found = theObjectsAndPictureCommandsByTitle.find (title);
+	if (found == theObjectsAndPictureCommandsByTitle.end ())
+		return nullptr;
+	for (const Praat_Command command : found -> second)
+		if (command -> executable)
+			return command;
+	return nullptr;
+}
+
 void praat_sortMenuCommands () {
 	for (integer i = 1; i <= theCommands.size; i ++) {
 		Praat_Command command = theCommands.at [i];
@@ -50,6 +89,7 @@ void praat_sortMenuCommands () {
 			return my sortingTail < thy sortingTail;
 		}
 	);
+	menuCommandsChanged ();   // Parselmouth
 }
 
 static integer lookUpMatchingMenuCommand_0 (conststring32 window, conststring32 menu, conststring32 title) {
@@ -231,6 +271,7 @@ static GuiMenuItem praat_addMenuCommand__ (conststring32 window, conststring32 m
 	}
 	Thing_cast (GuiMenuItem, button_as_GuiMenuItem, command -> button);
 	theCommands. addItemAtPosition_move (command.move(), position);
+	menuCommandsChanged ();   // Parselmouth
 	return button_as_GuiMenuItem;
 }
 GuiMenuItem praat_addMenuCommand_ (conststring32 window, conststring32 menu, conststring32 title /* cattable */,
@@ -351,6 +392,7 @@ void praat_addMenuCommandScript (conststring32 window, conststring32 menu, const
 			}
 		}
 		theCommands. addItemAtPosition_move (command.move(), position);
+		menuCommandsChanged ();   // Parselmouth
 
 		if (praatP.phase >= praat_HANDLING_EVENTS)
 			praat_sortMenuCommands ();
@@ -370,6 +412,7 @@ void praat_hideMenuCommand (conststring32 window, conststring32 menu, conststrin
 		command -> hidden = true;
 		if (praatP.phase >= praat_READING_BUTTONS)
 			command -> toggled = ! command -> toggled;
+		menuCommandsChanged ();   // Parselmouth
 		if (command -> button)
 			GuiThing_hide (command -> button);
 	}
@@ -386,6 +429,7 @@ void praat_showMenuCommand (conststring32 window, conststring32 menu, conststrin
 		command -> hidden = false;
 		if (praatP.phase >= praat_READING_BUTTONS)
 			command -> toggled = ! command -> toggled;
+		menuCommandsChanged ();   // Parselmouth
 		if (command -> button)
 			GuiThing_show (command -> button);
 	}
@@ -443,6 +487,7 @@ void praat_addFixedButtonCommand_ (GuiForm parent, conststring32 title, UiCallba
 	}
 	my executable = false;
 	theCommands. addItemAtPosition_move (me.move(), 0);
+	menuCommandsChanged ();   // Parselmouth
 }
 
 void praat_sensitivizeFixedButtonCommand (conststring32 title, bool sensitive) {
@@ -462,17 +507,7 @@ void praat_sensitivizeFixedButtonCommand (conststring32 title, bool sensitive) {
 }
 
 Praat_Command praat_doMenuCommand (conststring32 title, conststring32 arguments, Interpreter interpreter) {
-	Praat_Command commandFound = nullptr;
-	integer i;
-	for (i = 1; i <= theCommands.size; i ++) {
-		Praat_Command command = theCommands.at [i];
-		if (command -> executable && str32equ (command -> title.get(), title) &&
-			(str32equ (command -> window.get(), U"Objects") || str32equ (command -> window.get(), U"Picture")))
-		{
-			commandFound = command;
-			break;
-		}
-	}
+	Praat_Command commandFound = findExecutableObjectsOrPictureCommandByTitle (title);   // Parselmouth: was a linear search through theCommands
 	if (! commandFound)
 		return nullptr;
 	if (commandFound -> callback == DO_RunTheScriptFromAnyAddedMenuCommand) {
@@ -495,17 +530,7 @@ Praat_Command praat_doMenuCommand (conststring32 title, conststring32 arguments,
 }
 
 Praat_Command praat_doMenuCommand (conststring32 title, integer narg, Stackel args, Interpreter interpreter) {
-	Praat_Command commandFound = nullptr;
-	integer i;
-	for (i = 1; i <= theCommands.size; i ++) {
-		Praat_Command command = theCommands.at [i];
-		if (command -> executable && str32equ (command -> title.get(), title) &&
-			(str32equ (command -> window.get(), U"Objects") || str32equ (command -> window.get(), U"Picture")))
-		{
-			commandFound = command;
-			break;
-		}
-	}
+	Praat_Command commandFound = findExecutableObjectsOrPictureCommandByTitle (title);   // Parselmouth: was a linear search through theCommands
 	if (! commandFound)
 		return nullptr;
 	if (commandFound -> callback == DO_RunTheScriptFromAnyAddedMenuCommand) {
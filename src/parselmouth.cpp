@@ -20,9 +20,12 @@
 #include "parselmouth/Parselmouth.h"
 #include "version.h"
 
+#include <praat/sys/MelderThread.h>
 #include <praat/sys/praat.h>
 #include <praat/sys/praat_version.h>
 
+#include <pybind11/stl.h>
+
 #define XSTR(s) STR(s)
 #define STR(s) #s
 
@@ -37,9 +40,12 @@ Thing_declare(Function);
 Thing_declare(Harmonicity);
 Thing_declare(Harmonicity);
 Thing_declare(Intensity);
+Thing_declare(LongSound);
+Thing_declare(LPC);
 Thing_declare(Matrix);
 Thing_declare(MFCC);
 Thing_declare(Pitch);
+Thing_declare(PitchTracker);
 Thing_declare(Sampled);
 Thing_declare(SampledXY);
 Thing_declare(TextGrid);
@@ -56,6 +62,7 @@ struct TimeFunction;
 struct TimeFrameSampled;
 
 class PraatModule;
+class BatchModule;
 using PraatError = MelderError;
 class PraatWarning {};
 class PraatFatal {};
@@ -80,6 +87,7 @@ PRAAT_EXCEPTION_BINDING(PraatError, PyExc_RuntimeError) {
 PRAAT_EXCEPTION_BINDING(PraatWarning, PyExc_UserWarning) {
 	static auto warning = *this;
 	Melder_setWarningProc([](const char32 *message) {
+		py::gil_scoped_acquire gil; // Analyses can run with the GIL released, so warnings may come from any thread
 		if (PyErr_WarnEx(warning.ptr(), Melder_peek32to8(message), 1) < 0)
 			throw py::error_already_set();
 	});
@@ -88,6 +96,7 @@ PRAAT_EXCEPTION_BINDING(PraatWarning, PyExc_UserWarning) {
 PRAAT_EXCEPTION_BINDING(PraatFatal, PyExc_BaseException) {
 	static auto fatal = *this;
 	Melder_setCrashProc([](const char32 *message) {
+		py::gil_scoped_acquire gil;
 		auto extraMessage = "Parselmouth intercepted a crash in Praat:\n\n"s +
 		                    Melder_peek32to8(message) + "\n"s +
 		                    "To ensure correctness of Praat's calculations, it is advisable to NOT ignore this error\n"s
@@ -99,6 +108,7 @@ PRAAT_EXCEPTION_BINDING(PraatFatal, PyExc_BaseException) {
 
 void redirectMelderInfo() {
 	Melder_setInformationProc([](const char32 *message, size_t i) {
+		py::gil_scoped_acquire gil;
 		auto sys = py::module_::import("sys");
 		auto sys_stdout = sys.attr("stdout");
 		sys_stdout.attr("write")(&message[i]);
@@ -108,6 +118,7 @@ void redirectMelderInfo() {
 
 void redirectMelderError() {
 	Melder_setErrorProc([](const char32 *message) {
+		py::gil_scoped_acquire gil;
 		auto sys = py::module_::import("sys");
 		auto sys_stderr = sys.attr("stderr");
 		sys_stderr.attr("write")(message);
@@ -136,16 +147,20 @@ using PraatBindings = Bindings<PraatError,
                                Matrix,
                                Vector,
                                Sound,
+                               LongSound,
                                Spectrum,
                                Spectrogram,
                                Pitch,
+                               PitchTracker,
                                Intensity,
                                Harmonicity,
                                Formant,
                                CC,
                                MFCC,
+                               LPC,
                                TextGrid,
-                               PraatModule>;
+                               PraatModule,
+                               BatchModule>;
 
 } // namespace parselmouth
 
@@ -202,6 +217,22 @@ PYBIND11_MODULE(parselmouth, m) {
 
 	m.attr("read") = bindings.get<Data>().get().attr("read");
 
+	m.def("set_num_threads",
+	      [](std::optional<int> nThreads) {
+		      if (nThreads && *nThreads <= 0)
+			      throw py::value_error("The number of threads should be positive");
+		      MelderThread_setNumberOfThreads(nThreads.value_or(0));
+	      },
+	      "n_threads"_a = std::nullopt,
+	      "Set the maximum number of threads used by Parselmouth's analyses.\n\n"
+	      "All multithreaded analyses share one persistent pool of worker\n"
+	      "threads. Passing ``None`` resets the number of threads to the number\n"
+	      "of processors.");
+
+	m.def("get_num_threads",
+	      &MelderThread_getNumberOfThreads,
+	      "Get the maximum number of threads used by Parselmouth's analyses.");
+
 	// TODO Remove/deprecate?
 	m.attr("Interpolation") = bindings.get<parselmouth::ValueInterpolation>().get();
 }
@@ -22,8 +22,24 @@
 #include "utils/praat/MelderUtils.h"
 #include "utils/pybind11/ImplicitStringToEnumConversion.h"
 
+#include <praat/fon/Cochleagram.h>
+#include <praat/fon/Excitation.h>
+#include <praat/fon/Harmonicity.h>
+#include <praat/fon/Intensity.h>
+#include <praat/fon/Ltas.h>
+#include <praat/fon/Matrix.h>
+#include <praat/fon/Sound.h>
+#include <praat/fon/Spectrogram.h>
 #include <praat/sys/Data.h>
 
+#include <pybind11/numpy.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <tuple>
+
 namespace py = pybind11;
 using namespace py::literals;
 
@@ -50,6 +66,120 @@ using Data = Daata;
 using autoData = autoDaata;
 using Data_Parent = Daata_Parent;
 
+namespace {
+
+// Pickling uses Praat's own binary format, written to and read from memory through a stream over that memory,
+// or through an anonymous temporary file on platforms without open_memstream and fmemopen.
+// The written memory is handed to Python as a NumPy array that owns it, such that it is not copied once more.
+py::array_t<uint8_t> Data_writeBinaryToArray(Data data) {
+	char *bufferPointer = nullptr;
+	size_t size = 0;
+	{
+		py::gil_scoped_release release;
+#ifdef _WIN32
+		autofile f = tmpfile();
+		if (!f)
+			Melder_throw(U"Cannot open a temporary stream.");
+		Data_writeBinary(data, f);
+		size = static_cast<size_t>(ftell(f));
+		rewind(f);
+		bufferPointer = static_cast<char *>(malloc(size > 0 ? size : 1));
+		if (!bufferPointer || fread(bufferPointer, 1, size, f) != size) {
+			free(bufferPointer);
+			Melder_throw(U"Cannot read back the temporary stream.");
+		}
+#else
+		FILE *f = open_memstream(&bufferPointer, &size);
+		if (!f)
+			Melder_throw(U"Cannot open a memory stream.");
+		try {
+			Data_writeBinary(data, f);
+		} catch (MelderError) {
+			fclose(f);
+			free(bufferPointer);
+			throw;
+		}
+		fclose(f); // Only now, the buffer and size are final
+#endif
+	}
+	auto capsule = py::capsule(bufferPointer, [](void *p) { free(p); });
+	return py::array_t<uint8_t>(static_cast<py::ssize_t>(size), reinterpret_cast<uint8_t *>(bufferPointer), capsule);
+}
+
+autoData Data_readBinaryFromMemory(const std::string &className, const char *bytes, size_t size) {
+	py::gil_scoped_release release;
+	int formatVersion;
+	autoThing thing = Thing_newFromClassName(Melder_peek8to32(className.c_str()), &formatVersion);
+	if (!Thing_isa(thing.get(), classDaata) || size == 0)
+		Melder_throw(U"Cannot unpickle a ", Melder_peek8to32(className.c_str()), U" from ", size, U" bytes.");
+	autoData result = thing.static_cast_move<structData>();
+#ifdef _WIN32
+	autofile f = tmpfile();
+	if (f && (fwrite(bytes, 1, size, f) != size || fseek(f, 0, SEEK_SET) != 0))
+		f = nullptr;
+#else
+	autofile f = fmemopen(const_cast<char *>(bytes), size, "rb");
+#endif
+	if (!f)
+		Melder_throw(U"Cannot open the pickled data as a stream.");
+	Data_readBinary(result.get(), f, formatVersion);
+	return result;
+}
+
+// Objects that consist of nothing more than a Matrix (e.g., Sound, Spectrogram, or Intensity) are pickled as their
+// domain and sampling, plus their matrix of values, such that pickle protocol 5 can pass the values out-of-band,
+// straight from the object's own memory. These classes are listed explicitly, since any other subclass of Matrix
+// may store more than its matrix, now or in a future version of Praat.
+bool Data_isPlainMatrix(Data data) {
+	static const ClassInfo plainMatrixClasses[] = {classMatrix, classSound, classSpectrogram, classIntensity, classHarmonicity, classCochleagram, classLtas, classExcitation};
+	return std::find(std::begin(plainMatrixClasses), std::end(plainMatrixClasses), data->classInfo) != std::end(plainMatrixClasses);
+}
+
+std::string nativeByteOrder() {
+	return py::module_::import("sys").attr("byteorder").cast<std::string>();
+}
+
+py::tuple Matrix_getPickleHeader(Matrix matrix) {
+	return py::make_tuple(matrix->xmin, matrix->xmax, matrix->nx, matrix->dx, matrix->x1, matrix->ymin, matrix->ymax, matrix->ny, matrix->dy, matrix->y1, nativeByteOrder());
+}
+
+autoData Matrix_createFromPickle(const std::string &className, const py::tuple &header, const py::buffer &values) {
+	if (header.size() != 11)
+		Melder_throw(U"Cannot unpickle a ", Melder_peek8to32(className.c_str()), U" from a header of ", header.size(), U" values.");
+	auto nx = header[2].cast<integer>(), ny = header[7].cast<integer>();
+	auto byteSwapped = header[10].cast<std::string>() != nativeByteOrder();
+	auto buffer = values.request();
+	auto isContiguous = true;
+	for (py::ssize_t i = buffer.ndim - 1, stride = buffer.itemsize; i >= 0; stride *= buffer.shape[i], --i)
+		isContiguous = isContiguous && (buffer.shape[i] <= 1 || buffer.strides[i] == stride);
+	if (nx < 0 || ny < 0 || !isContiguous || buffer.size * buffer.itemsize != static_cast<py::ssize_t>(nx * ny * sizeof(double)))
+		Melder_throw(U"Cannot unpickle a ", Melder_peek8to32(className.c_str()), U" of ", ny, U" by ", nx, U" values from ", buffer.size * buffer.itemsize, U" bytes.");
+
+	int formatVersion;
+	autoThing thing = Thing_newFromClassName(Melder_peek8to32(className.c_str()), &formatVersion);
+	if (!Thing_isa(thing.get(), classDaata) || !Data_isPlainMatrix(static_cast<Data>(thing.get())))
+		Melder_throw(U"Cannot unpickle a ", Melder_peek8to32(className.c_str()), U" as a matrix.");
+	autoMatrix result = thing.static_cast_move<structMatrix>();
+	std::tie(result->xmin, result->xmax, result->nx, result->dx, result->x1) = std::tuple(header[0].cast<double>(), header[1].cast<double>(), nx, header[3].cast<double>(), header[4].cast<double>());
+	std::tie(result->ymin, result->ymax, result->ny, result->dy, result->y1) = std::tuple(header[5].cast<double>(), header[6].cast<double>(), ny, header[8].cast<double>(), header[9].cast<double>());
+	result->z = raw_MAT(ny, nx);
+	if (nx * ny > 0) {
+		py::gil_scoped_release release;
+		auto source = static_cast<const unsigned char *>(buffer.ptr);
+		auto target = reinterpret_cast<unsigned char *>(result->z.cells);
+		if (byteSwapped) {
+			for (integer i = 0; i < nx * ny; i++)
+				std::reverse_copy(source + i * sizeof(double), source + (i + 1) * sizeof(double), target + i * sizeof(double));
+		}
+		else {
+			std::copy(source, source + nx * ny * sizeof(double), target);
+		}
+	}
+	return result.static_cast_move<structData>();
+}
+
+} // namespace
+
 PRAAT_CLASS_BINDING(Data) {
 	NESTED_BINDINGS(FileFormat)
 
@@ -128,7 +258,52 @@ See also
 	    [](Data self, py::dict) { return Data_copy<structData>(self); },
 	    "memo"_a);
 
-	// TODO Pickling?
+	// Pickled as Type._unpickle(className, ...), with a class method that pickle can refer to as getattr(Type, "_unpickle")
+	def("__reduce_ex__",
+	    [](py::object self, int protocol) {
+		    auto data = py::cast<Data>(self);
+		    if (!Data_canWriteBinary(data))
+			    throw py::type_error("cannot pickle '" + std::string(Melder_peek32to8(Thing_className(data))) + "' object");
+		    auto classInfo = data->classInfo;
+		    auto className = std::string(Melder_peek32to8(classInfo->version > 0 ? Melder_cat(classInfo->className, U" ", classInfo->version) : classInfo->className));
+		    auto unpickle = py::type::of(self).attr("_unpickle");
+
+		    if (Data_isPlainMatrix(data)) {
+			    // A read-only view on the values, which keeps the object alive, and which protocol 5 lets pass out-of-band without copying it into the pickle stream
+			    auto matrix = static_cast<Matrix>(data);
+			    py::object values = py::array_t<double, py::array::c_style>({static_cast<size_t>(matrix->ny), static_cast<size_t>(matrix->nx)}, matrix->z.cells, self);
+			    values.attr("setflags")("write"_a = false);
+			    if (protocol >= 5)
+				    values = py::module_::import("pickle").attr("PickleBuffer")(values);
+			    return py::make_tuple(unpickle, py::make_tuple(className, Matrix_getPickleHeader(matrix), values));
+		    }
+
+		    auto bytes = Data_writeBinaryToArray(data);
+		    if (protocol >= 5) // Lets pickle protocol 5 pass the binary representation out-of-band, without copying it into the pickle stream
+			    return py::make_tuple(unpickle, py::make_tuple(className, py::module_::import("pickle").attr("PickleBuffer")(bytes)));
+		    return py::make_tuple(unpickle, py::make_tuple(className, py::bytes(reinterpret_cast<const char *>(bytes.data()), static_cast<size_t>(bytes.size()))));
+	    },
+	    "protocol"_a);
+
+	// A class method, such that the unpickled object can be checked to be an instance of the class it was pickled as
+	attr("_unpickle") = py::reinterpret_steal<py::object>(PyClassMethod_New(py::cpp_function(
+	    [](py::object cls, const std::string &className, py::object state, py::object values) {
+		    autoData result;
+		    if (!values.is_none()) {
+			    result = Matrix_createFromPickle(className, state.cast<py::tuple>(), values.cast<py::buffer>());
+		    }
+		    else {
+			    auto buffer = state.cast<py::buffer>().request();
+			    result = Data_readBinaryFromMemory(className, static_cast<const char *>(buffer.ptr), static_cast<size_t>(buffer.size * buffer.itemsize));
+		    }
+
+		    auto resultClassName = std::string(Melder_peek32to8(Thing_className(result.get())));
+		    auto object = py::cast(std::move(result));
+		    if (!PyObject_IsSubclass(cls.ptr(), reinterpret_cast<PyObject *>(Py_TYPE(object.ptr()))))
+			    throw py::type_error("cannot unpickle a " + resultClassName + " object as a " + cls.attr("__name__").cast<std::string>() + " object");
+		    return object;
+	    },
+	    py::name("_unpickle"), "cls"_a, "class_name"_a, "state"_a, "values"_a = py::none()).release().ptr()));
 
 	def("__eq__",
 	    &Data_equal,
@@ -26,6 +26,8 @@
 
 #include <praat/fon/Formant.h>
 
+#include <pybind11/numpy.h>
+
 namespace py = pybind11;
 using namespace py::literals;
 
@@ -50,6 +52,18 @@ PRAAT_CLASS_BINDING(Formant) {
 	def("get_bandwidth_at_time",
 	    args_cast<_, Positive<_>, _, _>(Formant_getBandwidthAtTime),
 	    "formant_number"_a, "time"_a, "unit"_a = kFormant_unit::HERTZ);
+
+	def("get_value_at_time",
+	    py::vectorize([](Formant self, integer formantNumber, double time, kFormant_unit unit) {
+		    return Formant_getValueAtTime(self, Positive<integer>(formantNumber), time, unit);
+	    }),
+	    "formant_number"_a, "time"_a, "unit"_a = kFormant_unit::HERTZ);
+
+	def("get_bandwidth_at_time",
+	    py::vectorize([](Formant self, integer formantNumber, double time, kFormant_unit unit) {
+		    return Formant_getBandwidthAtTime(self, Positive<integer>(formantNumber), time, unit);
+	    }),
+	    "formant_number"_a, "time"_a, "unit"_a = kFormant_unit::HERTZ);
 }
 
 } // namespace parselmouth
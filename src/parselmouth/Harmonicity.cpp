@@ -23,6 +23,8 @@
 
 #include <praat/fon/Harmonicity.h>
 
+#include <pybind11/numpy.h>
+
 namespace py = pybind11;
 using namespace py::literals;
 
@@ -35,8 +37,14 @@ PRAAT_CLASS_BINDING(Harmonicity) {
 
 	// TODO Mixins (or something else?) for TimeFrameSampled, TimeFunction, and TimeVector functionality
 
+	auto getValue = [](Harmonicity self, double time, kVector_valueInterpolation interpolation) { return Vector_getValueAtX(self, time, 1, interpolation); };
+
 	def("get_value", // TODO Should be part of Vector class
-	    [](Harmonicity self, double time, kVector_valueInterpolation interpolation) { return Vector_getValueAtX(self, time, 1, interpolation); },
+	    getValue,
+	    "time"_a, "interpolation"_a = kVector_valueInterpolation::CUBIC);
+
+	def("get_value",
+	    py::vectorize(getValue),
 	    "time"_a, "interpolation"_a = kVector_valueInterpolation::CUBIC);
 }
 
@@ -25,6 +25,7 @@
 
 #include <praat/fon/Intensity.h>
 
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 namespace py = pybind11;
@@ -57,8 +58,14 @@ PRAAT_CLASS_BINDING(Intensity) {
 
 	// TODO Mixins (or something else?) for TimeFrameSampled, TimeFunction, and TimeVector functionality
 
+	auto getValue = [](Intensity self, double time, kVector_valueInterpolation interpolation) { return Vector_getValueAtX(self, time, 1, interpolation); };
+
 	def("get_value", // TODO Should be part of Vector class
-	    [](Intensity self, double time, kVector_valueInterpolation interpolation) { return Vector_getValueAtX(self, time, 1, interpolation); },
+	    getValue,
+	    "time"_a, "interpolation"_a = kVector_valueInterpolation::CUBIC);
+
+	def("get_value",
+	    py::vectorize(getValue),
 	    "time"_a, "interpolation"_a = kVector_valueInterpolation::CUBIC);
 
 	// TODO 'Get mean' should probably also be added to Sampled once units get figured out?
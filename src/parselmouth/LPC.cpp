@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026  Yannick Jadoul
+ *
+ * This file is part of Parselmouth.
+ *
+ * Parselmouth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Parselmouth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Parselmouth.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Parselmouth.h"
+
+#include "TimeClassAspects.h"
+
+#include "utils/pybind11/NumericPredicates.h"
+
+#include <pybind11/numpy.h>
+
+#include <praat/LPC/LPC.h>
+#include <praat/LPC/LPC_and_Formant.h>
+
+namespace py = pybind11;
+using namespace py::literals;
+
+namespace parselmouth {
+
+PRAAT_STRUCT_BINDING(Frame, LPC_Frame) {
+	def_readwrite("gain", &structLPC_Frame::gain);
+
+	// The coefficients are not copied, so changing the array changes the LPC frame
+	def_property_readonly("a", [](LPC_Frame self) { return py::array(self->nCoefficients, &self->a[1], py::cast(self)); });
+
+	def("__getitem__",
+	    [](LPC_Frame self, long i) {
+		    if (i < 0) i += self->nCoefficients; // Python-style negative indexing
+		    if (i < 0 || i >= self->nCoefficients) throw py::index_error("LPC Frame index out of range");
+		    return self->a[i + 1];
+	    },
+	    "i"_a);
+
+	def("__setitem__",
+	    [](LPC_Frame self, long i, double value) {
+		    if (i < 0) i += self->nCoefficients; // Python-style negative indexing
+		    if (i < 0 || i >= self->nCoefficients) throw py::index_error("LPC Frame index out of range");
+		    self->a[i + 1] = value;
+	    },
+	    "i"_a, "value"_a);
+
+	def("__len__",
+	    [](LPC_Frame self) { return self->nCoefficients; });
+}
+
+PRAAT_CLASS_BINDING(LPC) {
+	addTimeFrameSampledMixin(*this);
+
+	NESTED_BINDINGS(LPC_Frame)
+
+	def_readonly("sampling_period", &structLPC::samplingPeriod);
+
+	def_readonly("max_n_coefficients", &structLPC::maxnCoefficients);
+
+	def("get_frame",
+	    [](LPC self, Positive<integer> frameNumber) {
+		    if (frameNumber > self->nx) Melder_throw(U"Frame number out of range");
+		    return &self->d_frames[frameNumber];
+	    },
+	    "frame_number"_a, py::return_value_policy::reference_internal);
+
+	def("__getitem__",
+	    [](LPC self, long i) {
+		    if (i < 0) i += self->nx; // Python-style negative indexing
+		    if (i < 0 || i >= self->nx) throw py::index_error("LPC index out of range");
+		    return &self->d_frames[i + 1];
+	    },
+	    "i"_a, py::return_value_policy::reference_internal);
+
+	def("__iter__",
+	    [](LPC self) { return py::make_iterator(&self->d_frames[1], &self->d_frames[self->nx + 1]); },
+	    py::keep_alive<0, 1>());
+
+	def("to_array",
+	    [](LPC self) {
+		    py::array_t<double> array({static_cast<size_t>(self->maxnCoefficients), static_cast<size_t>(self->nx)});
+
+		    auto unchecked = array.mutable_unchecked<2>();
+		    for (integer i = 0; i < self->nx; ++i) {
+			    auto &frame = self->d_frames[i + 1];
+			    for (integer j = 0; j < self->maxnCoefficients; ++j) {
+				    unchecked(j, i) = (j < frame.nCoefficients) ? frame.a[j + 1] : 0.0;
+			    }
+		    }
+
+		    return array;
+	    });
+
+	def("get_gains",
+	    [](LPC self) {
+		    py::array_t<double> array(static_cast<size_t>(self->nx));
+		    auto unchecked = array.mutable_unchecked<1>();
+		    for (integer i = 0; i < self->nx; ++i)
+			    unchecked(i) = self->d_frames[i + 1].gain;
+		    return array;
+	    });
+
+	def("to_formant",
+	    [](LPC self, double margin) { return LPC_to_Formant(self, margin); },
+	    "margin"_a = 50.0, ReleaseGIL());
+}
+
+} // namespace parselmouth
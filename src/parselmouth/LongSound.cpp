@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2017-2026  Yannick Jadoul
+ *
+ * This file is part of Parselmouth.
+ *
+ * Parselmouth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Parselmouth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Parselmouth.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "LongSound_docstrings.h"
+
+#include "Parselmouth.h"
+#include "TimeClassAspects.h"
+
+#include "utils/praat/MelderUtils.h"
+#include "utils/pybind11/NumericPredicates.h"
+
+#include <praat/dwtools/Sound_to_MFCC.h>
+#include <praat/fon/LongSound.h>
+#include <praat/fon/Sound_and_Spectrogram.h>
+#include <praat/fon/Sound_to_Formant.h>
+#include <praat/fon/Sound_to_Intensity.h>
+#include <praat/fon/Sound_to_Pitch.h>
+
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace py::literals;
+
+namespace parselmouth {
+
+PRAAT_CLASS_BINDING(LongSound, LONGSOUND_DOCSTRING) {
+	addTimeFrameSampledMixin(*this);
+
+	def(py::init([](const std::u32string &filePath) {
+		    auto file = pathToMelderFile(filePath);
+		    return LongSound_open(&file);
+	    }),
+	    "file_path"_a,
+	    LONGSOUND_INIT_DOCSTRING);
+
+	def_readonly("n_channels", &structLongSound::numberOfChannels);
+
+	def_readonly("n_samples", &structLongSound::nx);
+
+	def_readonly("sampling_frequency", &structLongSound::sampleRate);
+
+	def("extract_part",
+	    [](LongSound self, std::optional<double> fromTime, std::optional<double> toTime, bool preserveTimes) { return LongSound_extractPart(self, fromTime.value_or(self->xmin), toTime.value_or(self->xmax), preserveTimes); },
+	    "from_time"_a = std::nullopt, "to_time"_a = std::nullopt, "preserve_times"_a = false,
+	    LONGSOUND_EXTRACT_PART_DOCSTRING);
+
+	def("to_pitch_ac",
+	    [](LongSound self, std::optional<Positive<double>> timeStep, Positive<double> pitchFloor, Positive<int> maxNumberOfCandidates, bool veryAccurate, double silenceThreshold, double voicingThreshold, double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, Positive<double> pitchCeiling, Positive<double> blockDuration) {
+		    if (maxNumberOfCandidates <= 1) Melder_throw(U"Your maximum number of candidates should be greater than 1.");
+		    return LongSound_to_Pitch_any(self, (int) veryAccurate, 3.0, timeStep ? static_cast<double>(*timeStep) : 0.0, pitchFloor, pitchCeiling, maxNumberOfCandidates, silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, blockDuration);
+	    },
+	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "max_number_of_candidates"_a = 15, "very_accurate"_a = false, "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "pitch_ceiling"_a = 600.0, "block_duration"_a = 60.0, ReleaseGIL(),
+	    LONGSOUND_TO_PITCH_AC_DOCSTRING);
+
+	def("to_pitch_cc",
+	    [](LongSound self, std::optional<Positive<double>> timeStep, Positive<double> pitchFloor, Positive<int> maxNumberOfCandidates, bool veryAccurate, double silenceThreshold, double voicingThreshold, double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, Positive<double> pitchCeiling, Positive<double> blockDuration) {
+		    if (maxNumberOfCandidates <= 1) Melder_throw(U"Your maximum number of candidates should be greater than 1.");
+		    return LongSound_to_Pitch_any(self, 2 + (int) veryAccurate, 1.0, timeStep ? static_cast<double>(*timeStep) : 0.0, pitchFloor, pitchCeiling, maxNumberOfCandidates, silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, blockDuration);
+	    },
+	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "max_number_of_candidates"_a = 15, "very_accurate"_a = false, "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "pitch_ceiling"_a = 600.0, "block_duration"_a = 60.0, ReleaseGIL(),
+	    LONGSOUND_TO_PITCH_CC_DOCSTRING);
+
+	def("to_intensity",
+	    [](LongSound self, Positive<double> minimumPitch, std::optional<Positive<double>> timeStep, bool subtractMean, Positive<double> blockDuration) { return LongSound_to_Intensity(self, minimumPitch, timeStep ? static_cast<double>(*timeStep) : 0.0, subtractMean, blockDuration); },
+	    "minimum_pitch"_a = 100.0, "time_step"_a = std::nullopt, "subtract_mean"_a = true, "block_duration"_a = 60.0, ReleaseGIL(),
+	    LONGSOUND_TO_INTENSITY_DOCSTRING);
+
+	def("to_formant_burg",
+	    [](LongSound self, std::optional<Positive<double>> timeStep, Positive<double> maxNumberOfFormants, double maximumFormant, Positive<double> windowLength, Positive<double> preEmphasisFrom, Positive<double> blockDuration) {
+		    return LongSound_to_Formant_burg(self, timeStep ? static_cast<double>(*timeStep) : 0.0, maxNumberOfFormants, maximumFormant, windowLength, preEmphasisFrom, blockDuration);
+	    },
+	    "time_step"_a = std::nullopt, "max_number_of_formants"_a = 5.0, "maximum_formant"_a = 5500.0, "window_length"_a = 0.025, "pre_emphasis_from"_a = 50.0, "block_duration"_a = 60.0, ReleaseGIL(),
+	    LONGSOUND_TO_FORMANT_BURG_DOCSTRING);
+
+	def("to_spectrogram",
+	    [](LongSound self, Positive<double> windowLength, Positive<double> maximumFrequency, Positive<double> timeStep, Positive<double> frequencyStep, kSound_to_Spectrogram_windowShape windowShape, Positive<double> blockDuration) { return LongSound_to_Spectrogram(self, windowLength, maximumFrequency, timeStep, frequencyStep, windowShape, 8.0, 8.0, blockDuration); },
+	    "window_length"_a = 0.005, "maximum_frequency"_a = 5000.0, "time_step"_a = 0.002, "frequency_step"_a = 20.0, "window_shape"_a = kSound_to_Spectrogram_windowShape::GAUSSIAN, "block_duration"_a = 60.0, ReleaseGIL(),
+	    LONGSOUND_TO_SPECTROGRAM_DOCSTRING);
+
+	def("to_mfcc",
+	    [](LongSound self, Positive<long> numberOfCoefficients, Positive<double> windowLength, Positive<double> timeStep, Positive<double> firstFilterFrequency, Positive<double> distanceBetweenFilters, std::optional<Positive<double>> maximumFrequency, Positive<double> blockDuration) {
+		    return LongSound_to_MFCC(self, numberOfCoefficients, windowLength, timeStep, firstFilterFrequency, maximumFrequency ? static_cast<double>(*maximumFrequency) : 0.0, distanceBetweenFilters, blockDuration);
+	    },
+	    "number_of_coefficients"_a = 12, "window_length"_a = 0.015, "time_step"_a = 0.005, "firstFilterFrequency"_a = 100.0, "distance_between_filters"_a = 100.0, "maximum_frequency"_a = std::nullopt, "block_duration"_a = 60.0, ReleaseGIL(),
+	    LONGSOUND_TO_MFCC_DOCSTRING);
+}
+
+} // namespace parselmouth
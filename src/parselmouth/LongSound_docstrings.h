@@ -0,0 +1,209 @@
+/*
+* Copyright (C) 2023-2026  Yannick Jadoul
+*
+* This file is part of Parselmouth.
+*
+* Parselmouth is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Parselmouth is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with Parselmouth.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#ifndef INC_PARSELMOUTH_LONGSOUND_DOCSTRINGS_H
+#define INC_PARSELMOUTH_LONGSOUND_DOCSTRINGS_H
+
+namespace parselmouth {
+
+auto constexpr LONGSOUND_DOCSTRING =
+R"(An audio file on disk that is read on demand, rather than loaded into
+memory as a whole.
+
+Opening a `LongSound` only reads the header of the audio file. Samples
+are decoded only when parts of the file are extracted, such that parts
+of very long recordings can be analysed without reading the complete
+file.
+
+Corresponds to a :praat:`LongSound` object.
+
+See Also
+--------
+:praat:`LongSound`, :praat:`Sound files 3. Files that Praat can read`
+)";
+
+auto constexpr LONGSOUND_INIT_DOCSTRING =
+R"(Open an audio file on disk as a `LongSound` object.
+
+Only the header of the file is read; the file is kept open for as long
+as the `LongSound` object exists.
+
+Parameters
+----------
+file_path : str
+    The file path of an audio file to open.
+)";
+
+auto constexpr LONGSOUND_EXTRACT_PART_DOCSTRING =
+R"(Read a part of the audio file into a new `Sound` object.
+
+Only the samples in the requested time range are read from disk and
+converted.
+
+Parameters
+----------
+from_time : float, optional
+    The start time of the part to extract (default: `~Function.xmin`).
+to_time : float, optional
+    The end time of the part to extract (default: `~Function.xmax`).
+preserve_times : bool, optional
+    Whether the extracted `Sound` keeps the times of the original file,
+    or starts at time 0 (default: `False`).
+
+See Also
+--------
+:praat:`LongSound: Extract part...`
+)";
+
+auto constexpr LONGSOUND_TO_PITCH_AC_DOCSTRING =
+R"(Compute the pitch of the file with the autocorrelation method.
+
+The analysis is the same as `Sound.to_pitch_ac`, but the samples are
+read from the file in overlapping blocks; the result is identical
+to that of analysing the whole file as a `Sound`.
+
+Parameters
+----------
+The same as `Sound.to_pitch_ac`, and
+
+block_duration : float, optional
+    The duration of the frames analysed per block, in seconds (default:
+    60). Only the samples of one block (plus a margin on either side)
+    are read into memory at a time.
+
+See Also
+--------
+:praat:`Sound: To Pitch (raw autocorrelation)...`
+)";
+
+auto constexpr LONGSOUND_TO_PITCH_CC_DOCSTRING =
+R"(Compute the pitch of the file with the cross-correlation method.
+
+The analysis is the same as `Sound.to_pitch_cc`, but the samples are
+read from the file in overlapping blocks; the result is identical
+to that of analysing the whole file as a `Sound`.
+
+Parameters
+----------
+The same as `Sound.to_pitch_cc`, and
+
+block_duration : float, optional
+    The duration of the frames analysed per block, in seconds (default:
+    60). Only the samples of one block (plus a margin on either side)
+    are read into memory at a time.
+
+See Also
+--------
+:praat:`Sound: To Pitch (raw cross-correlation)...`
+)";
+
+auto constexpr LONGSOUND_TO_INTENSITY_DOCSTRING =
+R"(Compute the intensity contour of the file.
+
+The analysis is the same as `Sound.to_intensity`, but the samples are
+read from the file in overlapping blocks; the result is identical
+to that of analysing the whole file as a `Sound`.
+
+Parameters
+----------
+The same as `Sound.to_intensity`, and
+
+block_duration : float, optional
+    The duration of the frames analysed per block, in seconds (default:
+    60). Only the samples of one block (plus a margin on either side)
+    are read into memory at a time.
+
+See Also
+--------
+:praat:`Sound: To Intensity...`
+)";
+
+auto constexpr LONGSOUND_TO_FORMANT_BURG_DOCSTRING =
+R"(Compute the formants of the file with the Burg method.
+
+The analysis is the same as `Sound.to_formant_burg`, but the samples are
+read from the file in overlapping blocks. If `maximum_formant` is
+half the sampling frequency, the result is identical to that of
+analysing the whole file as a `Sound`. Otherwise, each block is
+resampled on its own, with a margin of one second on either side;
+since resampling filters the whole sound at once, the formants then
+differ slightly from those of the whole file: most of them by less
+than 0.1 percent, but more in frames where two candidate formants lie
+close together.
+
+Parameters
+----------
+The same as `Sound.to_formant_burg`, and
+
+block_duration : float, optional
+    The duration of the frames analysed per block, in seconds (default:
+    60). Only the samples of one block (plus a margin on either side)
+    are read into memory at a time.
+
+See Also
+--------
+:praat:`Sound: To Formant (burg)...`
+)";
+
+auto constexpr LONGSOUND_TO_SPECTROGRAM_DOCSTRING =
+R"(Compute the spectrogram of the file.
+
+The analysis is the same as `Sound.to_spectrogram`, but the samples are
+read from the file in overlapping blocks; the result is identical
+to that of analysing the whole file as a `Sound`.
+
+Parameters
+----------
+The same as `Sound.to_spectrogram`, and
+
+block_duration : float, optional
+    The duration of the frames analysed per block, in seconds (default:
+    60). Only the samples of one block (plus a margin on either side)
+    are read into memory at a time.
+
+See Also
+--------
+:praat:`Sound: To Spectrogram...`
+)";
+
+auto constexpr LONGSOUND_TO_MFCC_DOCSTRING =
+R"(Compute the mel-frequency cepstral coefficients of the file.
+
+The analysis is the same as `Sound.to_mfcc`, but the samples are
+read from the file in overlapping blocks; the result is identical
+to that of analysing the whole file as a `Sound`.
+
+Parameters
+----------
+The same as `Sound.to_mfcc`, and
+
+block_duration : float, optional
+    The duration of the frames analysed per block, in seconds (default:
+    60). Only the samples of one block (plus a margin on either side)
+    are read into memory at a time.
+
+See Also
+--------
+:praat:`Sound: To MFCC...`
+)";
+
+} // namespace parselmouth
+
+#endif // INC_PARSELMOUTH_LONGSOUND_DOCSTRINGS_H
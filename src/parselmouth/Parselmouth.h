@@ -101,6 +101,9 @@ using SpectralAnalysisWindowShape = kSound_to_Spectrogram_windowShape;
 using FormantUnit = kFormant_unit;
 using PitchUnit = kPitch_unit;
 
+// Praat's error and progress state is thread-local, so heavy analyses can run without holding the GIL
+using ReleaseGIL = pybind11::call_guard<pybind11::gil_scoped_release>;
+
 } // namespace parselmouth
 
 #endif // INC_PARSELMOUTH_PARSELMOUTH_H
@@ -150,13 +150,19 @@ PRAAT_CLASS_BINDING(Pitch) {
 	def("count_voiced_frames",
 	    &Pitch_countVoicedFrames);
 
+	auto getValueAtTime = [](Pitch self, double time, kPitch_unit unit, kVector_valueInterpolation interpolation) {
+		if (interpolation != kVector_valueInterpolation::NEAREST && interpolation != kVector_valueInterpolation::LINEAR)
+			Melder_throw(U"Pitch values can only be queried using NEAREST or LINEAR interpolation");
+		auto value = Sampled_getValueAtX(self, time, Pitch_LEVEL_FREQUENCY, static_cast<int>(unit), interpolation == kVector_valueInterpolation::LINEAR);
+		return Function_convertToNonlogarithmic(self, value, Pitch_LEVEL_FREQUENCY, static_cast<int>(unit));
+	};
+
 	def("get_value_at_time",
-	    [](Pitch self, double time, kPitch_unit unit, kVector_valueInterpolation interpolation) {
-		    if (interpolation != kVector_valueInterpolation::NEAREST && interpolation != kVector_valueInterpolation::LINEAR)
-			    Melder_throw(U"Pitch values can only be queried using NEAREST or LINEAR interpolation");
-		    auto value = Sampled_getValueAtX(self, time, Pitch_LEVEL_FREQUENCY, static_cast<int>(unit), interpolation == kVector_valueInterpolation::LINEAR);
-		    return Function_convertToNonlogarithmic(self, value, Pitch_LEVEL_FREQUENCY, static_cast<int>(unit));
-	    },
+	    getValueAtTime,
+	    "time"_a, "unit"_a = kPitch_unit::HERTZ, "interpolation"_a = kVector_valueInterpolation::LINEAR);
+
+	def("get_value_at_time",
+	    py::vectorize(getValueAtTime),
 	    "time"_a, "unit"_a = kPitch_unit::HERTZ, "interpolation"_a = kVector_valueInterpolation::LINEAR);
 
 	// TODO get_strength_at_time ? -> Pitch strength unit enum
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026  Yannick Jadoul
+ *
+ * This file is part of Parselmouth.
+ *
+ * Parselmouth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Parselmouth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Parselmouth.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "PitchTracker_docstrings.h"
+
+#include "Parselmouth.h"
+
+#include "utils/pybind11/NumericPredicates.h"
+
+#include <praat/fon/Sound_to_Pitch.h>
+
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <cmath>
+
+namespace py = pybind11;
+using namespace py::literals;
+
+namespace parselmouth {
+
+PRAAT_CLASS_BINDING(PitchTracker, PITCHTRACKER_DOCSTRING) {
+	def(py::init([](Positive<double> samplingFrequency, Positive<integer> numberOfChannels, std::optional<Positive<double>> timeStep, Positive<double> pitchFloor, Positive<int> maxNumberOfCandidates, bool veryAccurate, double silenceThreshold, double voicingThreshold, double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, Positive<double> pitchCeiling, NonNegative<double> lookahead, std::optional<Positive<double>> peak) {
+		    if (maxNumberOfCandidates <= 1) Melder_throw(U"Your maximum number of candidates should be greater than 1.");
+		    auto periodsPerWindow = 3.0;
+		    auto dt = timeStep ? static_cast<double>(*timeStep) : periodsPerWindow / pitchFloor / 4.0;
+		    auto lookaheadFrames = static_cast<integer>(std::ceil(lookahead / dt - 1e-9));
+		    return PitchTracker_create(samplingFrequency, numberOfChannels, veryAccurate, periodsPerWindow, dt, pitchFloor, pitchCeiling, maxNumberOfCandidates, silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, lookaheadFrames, peak ? static_cast<double>(*peak) : 0.0);
+	    }),
+	    "sampling_frequency"_a, "n_channels"_a = 1, "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "max_number_of_candidates"_a = 15, "very_accurate"_a = false, "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "pitch_ceiling"_a = 600.0, "lookahead"_a = 0.1, "peak"_a = std::nullopt,
+	    PITCHTRACKER_INIT_DOCSTRING);
+
+	def_property_readonly("sampling_frequency", [](PitchTracker self) { return 1.0 / self->samplingPeriod; });
+
+	def_readonly("n_channels", &structPitchTracker::numberOfChannels);
+
+	def_readonly("time_step", &structPitchTracker::timeStep);
+
+	def_property_readonly("lookahead", [](PitchTracker self) { return self->lookahead * self->timeStep; });
+
+	// Not releasing the GIL: the tracker keeps state between calls, and should not be used by two threads at once
+	def("process",
+	    [](PitchTracker self, py::array_t<double, py::array::c_style | py::array::forcecast> samples) {
+		    auto ndim = samples.ndim();
+		    if (ndim == 0 || ndim > 2)
+			    throw py::value_error("Samples should be a 1- or 2-dimensional array");
+
+		    auto nx = samples.shape(ndim - 1);
+		    auto ny = ndim == 2 ? samples.shape(0) : 1;
+		    return PitchTracker_process(self, constMATVU(samples.data(), ny, nx, nx, 1));
+	    },
+	    "samples"_a,
+	    PITCHTRACKER_PROCESS_DOCSTRING);
+
+	def("flush",
+	    [](PitchTracker self) { return PitchTracker_flush(self); },
+	    PITCHTRACKER_FLUSH_DOCSTRING);
+}
+
+} // namespace parselmouth
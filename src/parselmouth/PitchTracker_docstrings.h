@@ -0,0 +1,99 @@
+/*
+* Copyright (C) 2026  Yannick Jadoul
+*
+* This file is part of Parselmouth.
+*
+* Parselmouth is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Parselmouth is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with Parselmouth.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#pragma once
+#ifndef INC_PARSELMOUTH_PITCHTRACKER_DOCSTRINGS_H
+#define INC_PARSELMOUTH_PITCHTRACKER_DOCSTRINGS_H
+
+namespace parselmouth {
+
+auto constexpr PITCHTRACKER_DOCSTRING =
+R"(A streaming version of `Sound.to_pitch_ac`, for audio that arrives in
+chunks of arbitrary size.
+
+The pitch candidates of each frame are computed exactly as in
+`Sound.to_pitch_ac`, as soon as all samples around the frame have
+arrived. The best path through the candidates is found with the same
+costs, but a frame is final as soon as `lookahead` seconds of later
+frames have been analysed. So the latency of the tracker is bounded, and
+its memory does not grow with the length of the stream.
+
+The results can differ slightly from `Sound.to_pitch_ac` on the whole
+sound: the first frame is centred half an analysis window after the
+start of the stream, the intensity of the frames is relative to `peak`
+(or to the largest absolute sample value received so far), and later
+frames cannot change the path through frames that are already final.
+)";
+
+auto constexpr PITCHTRACKER_INIT_DOCSTRING =
+R"(Create a `PitchTracker` for a stream of samples.
+
+Parameters
+----------
+sampling_frequency : float
+    The sampling frequency of the stream, in Hertz.
+n_channels : int
+    The number of channels of the stream.
+time_step : float, optional
+    The time between two pitch frames, in seconds. By default, a quarter
+    of the analysis window, i.e., ``0.75 / pitch_floor``.
+lookahead : float
+    The duration of the frames after a frame that are taken into account
+    before the frame is final, in seconds.
+peak : float, optional
+    The absolute amplitude relative to which the silence threshold is
+    applied. By default, the largest absolute sample value received so
+    far.
+
+The other parameters are those of `Sound.to_pitch_ac`.
+)";
+
+auto constexpr PITCHTRACKER_PROCESS_DOCSTRING =
+R"(Append samples to the stream, and return the frames that became final.
+
+Parameters
+----------
+samples : numpy.ndarray
+    The new samples, either as a 1-dimensional array (for a single
+    channel), or as a 2-dimensional array of shape ``(n_channels,
+    n_samples)``.
+
+Returns
+-------
+Pitch or None
+    The frames that became final, in a `Pitch` object whose time domain
+    covers just these frames, or `None` if no frame became final.
+)";
+
+auto constexpr PITCHTRACKER_FLUSH_DOCSTRING =
+R"(End the stream, and return its remaining frames.
+
+All frames that could be analysed with the samples received so far and
+that were not returned yet are made final, with the best path through
+them. Afterwards, the tracker can be used for a new stream.
+
+Returns
+-------
+Pitch or None
+    The remaining frames, or `None` if there are none.
+)";
+
+} // namespace parselmouth
+
+#endif // INC_PARSELMOUTH_PITCHTRACKER_DOCSTRINGS_H
@@ -27,6 +27,8 @@
 #include "utils/pybind11/ImplicitStringToEnumConversion.h"
 #include "utils/pybind11/NumericPredicates.h"
 
+#include <praat/LPC/Sound_and_LPC.h>
+#include <praat/LPC/Sound_to_Formant_mt.h>
 #include <praat/dwtools/Sound_extensions.h>
 #include <praat/dwtools/Sound_to_MFCC.h>
 #include <praat/dwtools/Sound_to_Pitch2.h>
@@ -37,6 +39,7 @@
 #include <praat/fon/Sound_to_Harmonicity.h>
 #include <praat/fon/Sound_to_Intensity.h>
 #include <praat/fon/Sound_to_Pitch.h>
+#include <praat/sys/MelderThread.h>
 
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
@@ -56,6 +59,72 @@ PraatCollection referencesToPraatCollection(const Container &container) { // TOD
 	return collection;
 }
 
+// A Sound whose samples are not allocated by Praat, but live in a buffer owned by a Python object (e.g., a NumPy array).
+// Praat only ever reads and writes the samples of an existing Sound in place, so it suffices to keep the owner alive and
+// to hand the borrowed cells back instead of freeing them. To Praat, this is just a Sound (e.g., copies are normal Sounds).
+Thing_define(BufferSound, Sound) {
+	py::object owner;
+	double *borrowedCells = nullptr;
+
+	void v9_destroy() noexcept override {
+		if (z.cells && z.cells == borrowedCells)
+			z.releaseToAmbiguousOwner();
+		if (owner) {
+			py::gil_scoped_acquire gil;
+			owner = py::object();
+		}
+		BufferSound_Parent::v9_destroy();
+	}
+};
+
+Thing_implement(BufferSound, Sound, 2);
+
+autoSound Sound_createFromBuffer(py::array values, integer numberOfChannels, integer numberOfSamples, double samplingFrequency, double startTime) {
+	autoBufferSound result = Thing_new(BufferSound);
+	result->classInfo = classSound;
+	Matrix_init(result.get(), startTime, startTime + numberOfSamples / samplingFrequency, 0, 1.0 / samplingFrequency, startTime + 0.5 / samplingFrequency, 1, numberOfChannels, numberOfChannels, 1, 1);
+	result->nx = numberOfSamples;
+	result->borrowedCells = static_cast<double *>(values.mutable_data());
+	result->z.adoptFromAmbiguousOwner(MAT(result->borrowedCells, numberOfChannels, numberOfSamples));
+	result->owner = std::move(values);
+	return result.static_cast_move<structSound>();
+}
+
+// Reads an audio file (WAV, AIFF, FLAC, MP3, NIST, ...) that is already in memory, through a stream over that memory,
+// or through an anonymous temporary file on platforms without fmemopen.
+autoSound Sound_readFromMemory(const char *data, size_t size) {
+	if (size == 0)
+		Melder_throw(U"Cannot read a Sound from empty audio data.");
+#ifdef _WIN32
+	autofile stream = tmpfile();
+	if (stream && (fwrite(data, 1, size, stream) != size || fseek(stream, 0, SEEK_SET) != 0))
+		stream = nullptr;
+#else
+	autofile stream = fmemopen(const_cast<char *>(data), size, "rb");
+#endif
+	if (!stream)
+		Melder_throw(U"Cannot open the audio data as a stream.");
+	structMelderFile file{};
+	Melder_pathToFile(U"<bytes>", &file);
+	file.filePointer = stream;
+	file.openForReading = true;
+	auto result = Sound_readFromSoundFileStream(&file);
+	file.filePointer = nullptr;
+	return result;
+}
+
+template <typename T>
+void convertSamples(const py::array &values, MAT const &z, double scale) {
+	auto data = static_cast<const char *>(values.data());
+	auto rowStride = values.ndim() == 2 ? values.strides(0) : 0;
+	auto columnStride = values.strides(values.ndim() - 1);
+	for (integer irow = 1; irow <= z.nrow; ++irow) {
+		auto row = data + (irow - 1) * rowStride;
+		for (integer icol = 1; icol <= z.ncol; ++icol)
+			z[irow][icol] = scale * static_cast<double>(*reinterpret_cast<const T *>(row + (icol - 1) * columnStride));
+	}
+}
+
 } // namespace
 
 enum class SoundFileFormat { // TODO Nest within Sound?
@@ -92,6 +161,11 @@ enum class ToHarmonicityMethod {
 	GNE
 };
 
+enum class ResampleMethod {
+	SINC,
+	POLYPHASE
+};
+
 
 // TODO Export befóre using default values for them
 // TODO Can be nested within Sound? Valid documentation (i.e. parselmouth.Sound.WindowShape instead of parselmouth.WindowShape)?
@@ -180,11 +254,19 @@ PRAAT_ENUM_BINDING(ToHarmonicityMethod) {
 	make_implicitly_convertible_from_string(*this);
 }
 
+PRAAT_ENUM_BINDING(ResampleMethod) {
+	value("SINC", ResampleMethod::SINC);
+	value("POLYPHASE", ResampleMethod::POLYPHASE);
+
+	make_implicitly_convertible_from_string(*this);
+}
+
 PRAAT_CLASS_BINDING(Sound, SOUND_DOCSTRING) {
 	addTimeFrameSampledMixin(*this);
 
 	NESTED_BINDINGS(ToPitchMethod,
-	                ToHarmonicityMethod)
+	                ToHarmonicityMethod,
+	                ResampleMethod)
 
 	using signature_cast_placeholder::_;
 
@@ -212,6 +294,71 @@ PRAAT_CLASS_BINDING(Sound, SOUND_DOCSTRING) {
 	    }),
 	    "values"_a, "sampling_frequency"_a = 44100.0, "start_time"_a = 0.0);
 
+	def_static("from_buffer",
+	           [](py::object buffer, Positive<double> samplingFrequency, double startTime, bool copy) {
+		           auto values = py::array::ensure(buffer);
+		           if (!values)
+			           throw py::type_error("Cannot create Sound from an object that does not support the buffer protocol");
+
+		           auto ndim = values.ndim();
+		           if (ndim == 0)
+			           throw py::value_error("Cannot create Sound from a single 0-dimensional number");
+		           if (ndim > 2)
+			           throw py::value_error("Cannot create Sound from an array with more than 2 dimensions");
+
+		           auto nx = values.shape(ndim - 1);
+		           auto ny = ndim == 2 ? values.shape(0) : 1;
+		           if (ndim == 2 && ny > nx)
+			           PyErr_WarnEx(PyExc_RuntimeWarning, ("Number of channels (" + std::to_string(ny) + ") is greater than number of samples (" + std::to_string(nx) + "); note that the shape of the `values` array is interpreted as (n_channels, n_samples).").c_str(), 1);
+
+		           if (!copy) {
+			           if (!py::isinstance<py::array_t<double>>(values) || !(values.flags() & py::array::c_style))
+				           throw py::value_error("Cannot share memory with an array that is not a C-contiguous array of float64 values; use copy=True");
+			           if (!values.writeable())
+				           throw py::value_error("Cannot share memory with a read-only buffer; use copy=True");
+			           return Sound_createFromBuffer(std::move(values), ny, nx, samplingFrequency, startTime);
+		           }
+
+		           auto result = Sound_create(ny, startTime, startTime + nx / samplingFrequency, nx, 1.0 / samplingFrequency, startTime + 0.5 / samplingFrequency);
+		           if (py::isinstance<py::array_t<double>>(values))
+			           convertSamples<double>(values, result->z.get(), 1.0);
+		           else if (py::isinstance<py::array_t<float>>(values))
+			           convertSamples<float>(values, result->z.get(), 1.0);
+		           else if (py::isinstance<py::array_t<int16_t>>(values))
+			           convertSamples<int16_t>(values, result->z.get(), 1.0 / 32768.0);
+		           else if (py::isinstance<py::array_t<int32_t>>(values))
+			           convertSamples<int32_t>(values, result->z.get(), 1.0 / 2147483648.0);
+		           else
+			           throw py::type_error("Cannot create Sound from an array of " + py::str(values.dtype()).cast<std::string>() + " values; supported types are float64, float32, int16, and int32");
+		           return result;
+	           },
+	           "values"_a, "sampling_frequency"_a = 44100.0, "start_time"_a = 0.0, "copy"_a = true,
+	           SOUND_FROM_BUFFER_DOCSTRING);
+
+	def_static("from_bytes",
+	           [](py::buffer data) {
+		           auto info = data.request();
+		           if (info.ndim != 1 || info.strides[0] != info.itemsize)
+			           throw py::value_error("Cannot read a Sound from a non-contiguous buffer");
+		           py::gil_scoped_release release;
+		           return Sound_readFromMemory(static_cast<const char *>(info.ptr), static_cast<size_t>(info.size * info.itemsize));
+	           },
+	           "data"_a,
+	           SOUND_FROM_BYTES_DOCSTRING);
+
+	def_static("from_file_object",
+	           [](py::object file) {
+		           py::bytes data = file.attr("read")();
+		           char *buffer;
+		           py::ssize_t size;
+		           if (PYBIND11_BYTES_AS_STRING_AND_SIZE(data.ptr(), &buffer, &size))
+			           throw py::error_already_set();
+		           py::gil_scoped_release release;
+		           return Sound_readFromMemory(buffer, static_cast<size_t>(size));
+	           },
+	           "file"_a,
+	           SOUND_FROM_FILE_OBJECT_DOCSTRING);
+
 	def(py::init([](const std::u32string &filePath) {
 		    auto file = pathToMelderFile(filePath);
 		    return Sound_readFromSoundFile(&file);
@@ -220,9 +367,7 @@ PRAAT_CLASS_BINDING(Sound, SOUND_DOCSTRING) {
 	    SOUND_INIT_DOCSTRING);
 
 	// TODO Constructor from few special file formats that are not detectable by header
-	// TODO Constructor from file or io.IOBase?
 	// TODO Constructor from Praat-format file?
-	// TODO Constructor from py::buffer?
 	// TODO Empty constructor?
 
 	def("save",
@@ -448,8 +593,12 @@ PRAAT_CLASS_BINDING(Sound, SOUND_DOCSTRING) {
 	    "from_time"_a = std::nullopt, "to_time"_a = std::nullopt, "overlap"_a);
 
 	def("resample",
-	    &Sound_resample,
-	    "new_frequency"_a, "precision"_a = 50);
+	    [](Sound self, Positive<double> newFrequency, integer precision, ResampleMethod method) {
+		    if (method == ResampleMethod::POLYPHASE)
+			    return Sound_resample_polyphase(self, newFrequency, precision);
+		    return Sound_resample(self, newFrequency, precision);
+	    },
+	    "new_frequency"_a, "precision"_a = 50, "method"_a = ResampleMethod::SINC, ReleaseGIL());
 
 	def("lengthen", // TODO Lengthen (Overlap-add) ?
 	    [](Sound self, Positive<double> minimumPitch, Positive<double> maximumPitch, Positive<double> factor) {
@@ -457,16 +606,16 @@ PRAAT_CLASS_BINDING(Sound, SOUND_DOCSTRING) {
 			    Melder_throw(U"Maximum pitch should be greater than minimum pitch.");
 		    return Sound_lengthen_overlapAdd(self, minimumPitch, maximumPitch, factor);
 	    },
-	    "minimum_pitch"_a = 75.0, "maximum_pitch"_a = 600.0, "factor"_a);
+	    "minimum_pitch"_a = 75.0, "maximum_pitch"_a = 600.0, "factor"_a, ReleaseGIL());
 
 	def("deepen_band_modulation",
 	    args_cast<_, Positive<_>, Positive<_>, Positive<_>, Positive<_>, Positive<_>, Positive<_>>(Sound_deepenBandModulation),
-	    "enhancement"_a = 20.0, "from_frequency"_a = 300.0, "to_frequency"_a = 8000.0, "slow_modulation"_a = 3.0, "fast_modulation"_a = 30.0, "band_smoothing"_a = 100.0);
+	    "enhancement"_a = 20.0, "from_frequency"_a = 300.0, "to_frequency"_a = 8000.0, "slow_modulation"_a = 3.0, "fast_modulation"_a = 30.0, "band_smoothing"_a = 100.0, ReleaseGIL());
 
 	// TODO Args cast for std::optional and std::optional ranges!
 	def("to_pitch",
 	    [](Sound self, std::optional<Positive<double>> timeStep, Positive<double> pitchFloor, Positive<double> pitchCeiling) { return Sound_to_Pitch(self, timeStep ? static_cast<double>(*timeStep) : 0.0, pitchFloor, pitchCeiling); },
-	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "pitch_ceiling"_a = 600.0);
+	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "pitch_ceiling"_a = 600.0, ReleaseGIL());
 
 	def("to_pitch",
 	    [](Sound self, ToPitchMethod method, py::args args, py::kwargs kwargs) -> py::object {
@@ -491,7 +640,7 @@ PRAAT_CLASS_BINDING(Sound, SOUND_DOCSTRING) {
 		    if (maxNumberOfCandidates <= 1) Melder_throw(U"Your maximum number of candidates should be greater than 1.");
 			return Sound_to_Pitch_rawAc(self, timeStep ? static_cast<double>(*timeStep) : 0.0, pitchFloor, pitchCeiling, maxNumberOfCandidates, veryAccurate, silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost);
 	    },
-	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "max_number_of_candidates"_a = 15, "very_accurate"_a = false, "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "pitch_ceiling"_a = 600.0);
+	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "max_number_of_candidates"_a = 15, "very_accurate"_a = false, "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "pitch_ceiling"_a = 600.0, ReleaseGIL());
 
 	// TODO 0.5: New Praat filtered vs. raw
 	def("to_pitch_cc",
@@ -499,14 +648,14 @@ PRAAT_CLASS_BINDING(Sound, SOUND_DOCSTRING) {
 		    if (maxNumberOfCandidates <= 1) Melder_throw(U"Your maximum number of candidates should be greater than 1.");
 		    return Sound_to_Pitch_rawCc(self, timeStep ? static_cast<double>(*timeStep) : 0.0, pitchFloor, pitchCeiling, maxNumberOfCandidates, veryAccurate, silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost);
 	    },
-	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "max_number_of_candidates"_a = 15, "very_accurate"_a = false, "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "pitch_ceiling"_a = 600.0);
+	    "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "max_number_of_candidates"_a = 15, "very_accurate"_a = false, "silence_threshold"_a = 0.03, "voicing_threshold"_a = 0.45, "octave_cost"_a = 0.01, "octave_jump_cost"_a = 0.35, "voiced_unvoiced_cost"_a = 0.14, "pitch_ceiling"_a = 600.0, ReleaseGIL());
 
 	def("to_pitch_spinet",
 	    [](Sound self, Positive<double> timeStep, Positive<double> windowLength, Positive<double> minimumFilterFrequency, Positive<double> maximumFilterFrequency, Positive<long> numberOfFilters, Positive<double> ceiling, Positive<int> maxNumberOfCandidates) {
 		    if (minimumFilterFrequency >= maximumFilterFrequency) Melder_throw(U"Maximum frequency must be larger than minimum frequency.");
 		    return Sound_to_Pitch_SPINET(self, timeStep, windowLength, minimumFilterFrequency, maximumFilterFrequency, numberOfFilters, ceiling, maxNumberOfCandidates);
 	    },
-	    "time_step"_a = 0.005, "window_length"_a = 0.04, "minimum_filter_frequency"_a = 70.0, "maximum_filter_frequency"_a = 5000.0, "number_of_filters"_a = 250, "ceiling"_a = 500.0, "max_number_of_candidates"_a = 15);
+	    "time_step"_a = 0.005, "window_length"_a = 0.04, "minimum_filter_frequency"_a = 70.0, "maximum_filter_frequency"_a = 5000.0, "number_of_filters"_a = 250, "ceiling"_a = 500.0, "max_number_of_candidates"_a = 15, ReleaseGIL());
 
 	def("to_pitch_shs",
 	    [](Sound self, Positive<double> timeStep, Positive<double> minimumPitch, Positive<long> maxNumberOfCandidates, Positive<double> maximumFrequencyComponent, Positive<long> maxNumberOfSubharmonics, Positive<double> compressionFactor, Positive<double> ceiling, Positive<long> numberOfPointsPerOctave) {
@@ -514,7 +663,7 @@ PRAAT_CLASS_BINDING(Sound, SOUND_DOCSTRING) {
 		    if (ceiling > maximumFrequencyComponent) Melder_throw(U"Maximum frequency must be greater than or equal to ceiling.");
 		    return Sound_to_Pitch_shs(self, timeStep, minimumPitch, maximumFrequencyComponent, ceiling, maxNumberOfSubharmonics, maxNumberOfCandidates, compressionFactor, numberOfPointsPerOctave);
 	    },
-	    "time_step"_a = 0.01, "minimum_pitch"_a = 50.0, "max_number_of_candidates"_a = 15, "maximum_frequency_component"_a = 1250.0, "max_number_of_subharmonics"_a = 15, "compression_factor"_a = 0.84, "ceiling"_a = 600.0, "number_of_points_per_octave"_a = 48);
+	    "time_step"_a = 0.01, "minimum_pitch"_a = 50.0, "max_number_of_candidates"_a = 15, "maximum_frequency_component"_a = 1250.0, "max_number_of_subharmonics"_a = 15, "compression_factor"_a = 0.84, "ceiling"_a = 600.0, "number_of_points_per_octave"_a = 48, ReleaseGIL());
 
 	def("to_harmonicity",
 	    [](Sound self, ToHarmonicityMethod method, py::args args, py::kwargs kwargs) -> py::object {
@@ -533,36 +682,75 @@ PRAAT_CLASS_BINDING(Sound, SOUND_DOCSTRING) {
 
 	def("to_harmonicity_cc",
 	    args_cast<_, Positive<_>, Positive<_>, _, Positive<_>>(Sound_to_Harmonicity_cc),
-	    "time_step"_a = 0.01, "minimum_pitch"_a = 75.0, "silence_threshold"_a = 0.1, "periods_per_window"_a = 1.0);
+	    "time_step"_a = 0.01, "minimum_pitch"_a = 75.0, "silence_threshold"_a = 0.1, "periods_per_window"_a = 1.0, ReleaseGIL());
 
 	def("to_harmonicity_ac",
 	    args_cast<_, Positive<_>, Positive<_>, _, Positive<_>>(Sound_to_Harmonicity_ac),
-	    "time_step"_a = 0.01, "minimum_pitch"_a = 75.0, "silence_threshold"_a = 0.1, "periods_per_window"_a = 1.0);
+	    "time_step"_a = 0.01, "minimum_pitch"_a = 75.0, "silence_threshold"_a = 0.1, "periods_per_window"_a = 1.0, ReleaseGIL());
 
 	def("to_harmonicity_gne",
 	    args_cast<_, Positive<_>, Positive<_>, Positive<_>, Positive<_>>(Sound_to_Harmonicity_GNE),
-	    "minimum_frequency"_a = 500.0, "maximum_frequency"_a = 4500.0, "bandwidth"_a = 1000.0, "step"_a = 80.0);
+	    "minimum_frequency"_a = 500.0, "maximum_frequency"_a = 4500.0, "bandwidth"_a = 1000.0, "step"_a = 80.0, ReleaseGIL());
 
 	def("autocorrelate",
 	    &Sound_autoCorrelate,
-	    "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO);
+	    "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO, ReleaseGIL());
 
 	def("to_spectrum",
 	    &Sound_to_Spectrum,
-	    "fast"_a = true);
+	    "fast"_a = true, ReleaseGIL());
 
 	def("to_spectrogram",
 	    [](Sound self, Positive<double> windowLength, Positive<double> maximumFrequency, Positive<double> timeStep, Positive<double> frequencyStep, kSound_to_Spectrogram_windowShape windowShape) { return Sound_to_Spectrogram(self, windowLength, maximumFrequency, timeStep, frequencyStep, windowShape, 8.0, 8.0); },
-	    "window_length"_a = 0.005, "maximum_frequency"_a = 5000.0, "time_step"_a = 0.002, "frequency_step"_a = 20.0, "window_shape"_a = kSound_to_Spectrogram_windowShape::GAUSSIAN);
+	    "window_length"_a = 0.005, "maximum_frequency"_a = 5000.0, "time_step"_a = 0.002, "frequency_step"_a = 20.0, "window_shape"_a = kSound_to_Spectrogram_windowShape::GAUSSIAN, ReleaseGIL());
 
 	def("to_formant_burg", // TODO Praat has Max. number of formants as REAL? What the hell? "Pi formants for me, please."? (I know, I know; see Praat documentation)
-	    [](Sound self, std::optional<Positive<double>> timeStep, Positive<double> maxNumberOfFormants, double maximumFormant, Positive<double> windowLength, Positive<double> preEmphasisFrom) { return Sound_to_Formant_burg(self, timeStep ? static_cast<double>(*timeStep) : 0.0, maxNumberOfFormants, maximumFormant, windowLength, preEmphasisFrom); },
-	    "time_step"_a = std::nullopt, "max_number_of_formants"_a = 5.0, "maximum_formant"_a = 5500.0, "window_length"_a = 0.025, "pre_emphasis_from"_a = 50.0);
+	    [](Sound self, std::optional<Positive<double>> timeStep, Positive<double> maxNumberOfFormants, double maximumFormant, Positive<double> windowLength, Positive<double> preEmphasisFrom, std::optional<Positive<int>> nThreads) {
+		    autoMelderThreadLimit threadLimit(nThreads ? static_cast<int>(*nThreads) : 0);
+		    return Sound_to_Formant_burg(self, timeStep ? static_cast<double>(*timeStep) : 0.0, maxNumberOfFormants, maximumFormant, windowLength, preEmphasisFrom);
+	    },
+	    "time_step"_a = std::nullopt, "max_number_of_formants"_a = 5.0, "maximum_formant"_a = 5500.0, "window_length"_a = 0.025, "pre_emphasis_from"_a = 50.0, "n_threads"_a = std::nullopt, ReleaseGIL());
+
+	def("to_formant_robust",
+	    [](Sound self, std::optional<Positive<double>> timeStep, Positive<double> maxNumberOfFormants, double maximumFormant, Positive<double> windowLength, Positive<double> preEmphasisFrom, Positive<double> numberOfStandardDeviations, Positive<integer> maximumNumberOfIterations, double tolerance, double margin, std::optional<Positive<int>> nThreads) {
+		    autoMelderThreadLimit threadLimit(nThreads ? static_cast<int>(*nThreads) : 0);
+		    // As in Praat's "To Formant (robust)...", the location of the residuals is estimated from the data, rather than fixed
+		    return Sound_to_Formant_robust_mt(self, timeStep ? static_cast<double>(*timeStep) : 0.0, maxNumberOfFormants, maximumFormant, windowLength, preEmphasisFrom, margin, numberOfStandardDeviations, maximumNumberOfIterations, tolerance, 0.0, true);
+	    },
+	    "time_step"_a = std::nullopt, "max_number_of_formants"_a = 5.0, "maximum_formant"_a = 5500.0, "window_length"_a = 0.025, "pre_emphasis_from"_a = 50.0, "number_of_std_dev"_a = 1.5, "maximum_number_of_iterations"_a = 5, "tolerance"_a = 0.000001, "margin"_a = 50.0, "n_threads"_a = std::nullopt, ReleaseGIL());
 	// TODO To Formant...
 
+	def("to_lpc_autocorrelation",
+	    [](Sound self, Positive<int> predictionOrder, Positive<double> windowLength, Positive<double> timeStep, double preEmphasisFrequency, std::optional<Positive<int>> nThreads) {
+		    autoMelderThreadLimit threadLimit(nThreads ? static_cast<int>(*nThreads) : 0);
+		    return Sound_to_LPC_autocorrelation(self, predictionOrder, windowLength, timeStep, std::max(preEmphasisFrequency, 0.0));
+	    },
+	    "prediction_order"_a = 16, "window_length"_a = 0.025, "time_step"_a = 0.005, "pre_emphasis_frequency"_a = 50.0, "n_threads"_a = std::nullopt, ReleaseGIL());
+
+	def("to_lpc_covariance",
+	    [](Sound self, Positive<int> predictionOrder, Positive<double> windowLength, Positive<double> timeStep, double preEmphasisFrequency, std::optional<Positive<int>> nThreads) {
+		    autoMelderThreadLimit threadLimit(nThreads ? static_cast<int>(*nThreads) : 0);
+		    return Sound_to_LPC_covariance(self, predictionOrder, windowLength, timeStep, std::max(preEmphasisFrequency, 0.0));
+	    },
+	    "prediction_order"_a = 16, "window_length"_a = 0.025, "time_step"_a = 0.005, "pre_emphasis_frequency"_a = 50.0, "n_threads"_a = std::nullopt, ReleaseGIL());
+
+	def("to_lpc_burg",
+	    [](Sound self, Positive<int> predictionOrder, Positive<double> windowLength, Positive<double> timeStep, double preEmphasisFrequency, std::optional<Positive<int>> nThreads) {
+		    autoMelderThreadLimit threadLimit(nThreads ? static_cast<int>(*nThreads) : 0);
+		    return Sound_to_LPC_burg(self, predictionOrder, windowLength, timeStep, std::max(preEmphasisFrequency, 0.0));
+	    },
+	    "prediction_order"_a = 16, "window_length"_a = 0.025, "time_step"_a = 0.005, "pre_emphasis_frequency"_a = 50.0, "n_threads"_a = std::nullopt, ReleaseGIL());
+
+	def("to_lpc_marple",
+	    [](Sound self, Positive<int> predictionOrder, Positive<double> windowLength, Positive<double> timeStep, double preEmphasisFrequency, Positive<double> tolerance1, Positive<double> tolerance2, std::optional<Positive<int>> nThreads) {
+		    autoMelderThreadLimit threadLimit(nThreads ? static_cast<int>(*nThreads) : 0);
+		    return Sound_to_LPC_marple(self, predictionOrder, windowLength, timeStep, std::max(preEmphasisFrequency, 0.0), tolerance1, tolerance2);
+	    },
+	    "prediction_order"_a = 16, "window_length"_a = 0.025, "time_step"_a = 0.005, "pre_emphasis_frequency"_a = 50.0, "tolerance1"_a = 1e-6, "tolerance2"_a = 1e-6, "n_threads"_a = std::nullopt, ReleaseGIL());
+
 	def("to_intensity",
 	    [](Sound self, Positive<double> minimumPitch, std::optional<Positive<double>> timeStep, bool subtractMean) { return Sound_to_Intensity(self, minimumPitch, timeStep ? static_cast<double>(*timeStep) : 0.0, subtractMean); },
-	    "minimum_pitch"_a = 100.0, "time_step"_a = std::nullopt, "subtract_mean"_a = true);
+	    "minimum_pitch"_a = 100.0, "time_step"_a = std::nullopt, "subtract_mean"_a = true, ReleaseGIL());
 
 	// TODO Filters
 	// TODO Group different filters into enum/class/...?
@@ -585,11 +773,11 @@ PRAAT_CLASS_BINDING(Sound, SOUND_DOCSTRING) {
 
 	def("convolve",
 	    &Sounds_convolve,
-	    "other"_a.none(false), "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO);
+	    "other"_a.none(false), "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO, ReleaseGIL());
 
 	def("cross_correlate",
 	    &Sounds_crossCorrelate,
-	    "other"_a.none(false), "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO);
+	    "other"_a.none(false), "scaling"_a = kSounds_convolve_scaling::PEAK_099, "signal_outside_time_domain"_a = kSounds_convolve_signalOutsideTimeDomain::ZERO, ReleaseGIL());
 	// TODO Cross-correlate (short)?
 
 	def("to_mfcc", // Watch out for different order of arguments in interface than in Sound_to_MFCC // TODO REQUIRE (numberOfCoefficients < 25, U"The number of coefficients should be less than 25.")
@@ -597,7 +785,7 @@ PRAAT_CLASS_BINDING(Sound, SOUND_DOCSTRING) {
 		    // if (numberOfCoefficients >= 25) Melder_throw(U"The number of coefficients should be less than 25."); // Might be wrong, but I see no reason to enforce this, in the actual code
 		    return Sound_to_MFCC(self, numberOfCoefficients, windowLength, timeStep, firstFilterFrequency, maximumFrequency ? static_cast<double>(*maximumFrequency) : 0.0, distanceBetweenFilters);
 	    },
-	    "number_of_coefficients"_a = 12, "window_length"_a = 0.015, "time_step"_a = 0.005, "firstFilterFrequency"_a = 100.0, "distance_between_filters"_a = 100.0, "maximum_frequency"_a = std::nullopt);
+	    "number_of_coefficients"_a = 12, "window_length"_a = 0.015, "time_step"_a = 0.005, "firstFilterFrequency"_a = 100.0, "distance_between_filters"_a = 100.0, "maximum_frequency"_a = std::nullopt, ReleaseGIL());
 
 	// TODO For some reason praat_David_init.cpp also still contains Sound functionality
 	// TODO Still a bunch of Sound in praat_LPC_init.cpp
@@ -65,6 +65,63 @@ See Also
 :praat:`Sound files 3. Files that Praat can read`
 )";
 
+auto constexpr SOUND_FROM_BUFFER_DOCSTRING =
+R"(Create a new `Sound` object from an array or another object supporting
+the buffer protocol, optionally sharing its memory.
+
+Parameters
+----------
+values : buffer_like
+    The samples of the new `Sound` object, with shape ``(n_samples,)``
+    or ``(n_channels, n_samples)``. Arrays of 16-bit or 32-bit integers
+    are interpreted as linear PCM and scaled to values between -1 and 1.
+sampling_frequency : float, optional
+    The sampling frequency of the new `Sound` object (default: 44100).
+start_time : float, optional
+    The start time (`~Function.xmin`) of the new `Sound` object
+    (default: 0).
+copy : bool, optional
+    Whether to copy the samples (default: True). If False, `values`
+    needs to be a writeable, C-contiguous array of float64 values, which
+    the new `Sound` object uses as its storage: changes to the `Sound`
+    are visible in `values` and vice versa, and `values` is kept alive
+    as long as the `Sound` object exists.
+)";
+
+auto constexpr SOUND_FROM_BYTES_DOCSTRING =
+R"(Read a `Sound` object from the contents of an audio file in memory.
+
+The same audio file formats as in the `Sound` constructor are detected
+and decoded (e.g., WAV, AIFF, FLAC, MP3, or NIST), but without the need
+to write the data to a file on disk first.
+
+Parameters
+----------
+data : bytes_like
+    The contents of an audio file, e.g. as `bytes`, `bytearray`, or
+    `memoryview`.
+
+See Also
+--------
+:praat:`Sound files 3. Files that Praat can read`
+)";
+
+auto constexpr SOUND_FROM_FILE_OBJECT_DOCSTRING =
+R"(Read a `Sound` object from a binary file-like object.
+
+The remaining contents of the file-like object are read by calling its
+``read()`` method, and decoded as in `Sound.from_bytes`.
+
+Parameters
+----------
+file : io.BufferedIOBase
+    A binary file-like object, e.g. an opened file or an `io.BytesIO`.
+
+See Also
+--------
+:praat:`Sound files 3. Files that Praat can read`
+)";
+
 auto constexpr SOUND_SAVE_DOCSTRING =
 R"(Save a `Sound` object to an audio file on disk.
 
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026  Yannick Jadoul
+ *
+ * This file is part of Parselmouth.
+ *
+ * Parselmouth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Parselmouth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Parselmouth.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "batch_docstrings.h"
+
+#include "parselmouth/Parselmouth.h"
+
+#include "utils/pybind11/NumericPredicates.h"
+
+#include <praat/dwtools/Sound_to_MFCC.h>
+#include <praat/fon/Sound_and_Spectrogram.h>
+#include <praat/fon/Sound_to_Formant.h>
+#include <praat/fon/Sound_to_Harmonicity.h>
+#include <praat/fon/Sound_to_Intensity.h>
+#include <praat/fon/Sound_to_Pitch.h>
+#include <praat/sys/MelderThread.h>
+
+#include <pybind11/stl.h>
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace py = pybind11;
+using namespace py::literals;
+
+namespace parselmouth {
+
+namespace {
+
+using SoundReferences = std::vector<std::reference_wrapper<structSound>>;
+
+template <typename Analysis>
+auto analyseAll(const SoundReferences &sounds, std::optional<Positive<int>> nThreads, Analysis analysis) {
+	std::vector<decltype(analysis(std::declval<Sound>()))> results(sounds.size());
+	{
+		py::gil_scoped_release release;
+		MelderThread_runJobs(static_cast<integer>(sounds.size()), [&](integer i) { results[i - 1] = analysis(&sounds[i - 1].get()); }, nThreads ? static_cast<int>(*nThreads) : 0);
+	}
+	return results;
+}
+
+} // namespace
+
+class BatchModule;
+
+PRAAT_MODULE_BINDING(batch, BatchModule, BATCH_MODULE_DOCSTRING) {
+	def("to_pitch",
+	    [](const SoundReferences &sounds, std::optional<Positive<double>> timeStep, Positive<double> pitchFloor, Positive<double> pitchCeiling, std::optional<Positive<int>> nThreads) {
+		    return analyseAll(sounds, nThreads, [&](Sound sound) { return Sound_to_Pitch(sound, timeStep ? static_cast<double>(*timeStep) : 0.0, pitchFloor, pitchCeiling); });
+	    },
+	    "sounds"_a, "time_step"_a = std::nullopt, "pitch_floor"_a = 75.0, "pitch_ceiling"_a = 600.0, "n_threads"_a = std::nullopt);
+
+	def("to_intensity",
+	    [](const SoundReferences &sounds, Positive<double> minimumPitch, std::optional<Positive<double>> timeStep, bool subtractMean, std::optional<Positive<int>> nThreads) {
+		    return analyseAll(sounds, nThreads, [&](Sound sound) { return Sound_to_Intensity(sound, minimumPitch, timeStep ? static_cast<double>(*timeStep) : 0.0, subtractMean); });
+	    },
+	    "sounds"_a, "minimum_pitch"_a = 100.0, "time_step"_a = std::nullopt, "subtract_mean"_a = true, "n_threads"_a = std::nullopt);
+
+	def("to_formant_burg",
+	    [](const SoundReferences &sounds, std::optional<Positive<double>> timeStep, Positive<double> maxNumberOfFormants, double maximumFormant, Positive<double> windowLength, Positive<double> preEmphasisFrom, std::optional<Positive<int>> nThreads) {
+		    return analyseAll(sounds, nThreads, [&](Sound sound) { return Sound_to_Formant_burg(sound, timeStep ? static_cast<double>(*timeStep) : 0.0, maxNumberOfFormants, maximumFormant, windowLength, preEmphasisFrom); });
+	    },
+	    "sounds"_a, "time_step"_a = std::nullopt, "max_number_of_formants"_a = 5.0, "maximum_formant"_a = 5500.0, "window_length"_a = 0.025, "pre_emphasis_from"_a = 50.0, "n_threads"_a = std::nullopt);
+
+	def("to_spectrogram",
+	    [](const SoundReferences &sounds, Positive<double> windowLength, Positive<double> maximumFrequency, Positive<double> timeStep, Positive<double> frequencyStep, kSound_to_Spectrogram_windowShape windowShape, std::optional<Positive<int>> nThreads) {
+		    return analyseAll(sounds, nThreads, [&](Sound sound) { return Sound_to_Spectrogram(sound, windowLength, maximumFrequency, timeStep, frequencyStep, windowShape, 8.0, 8.0); });
+	    },
+	    "sounds"_a, "window_length"_a = 0.005, "maximum_frequency"_a = 5000.0, "time_step"_a = 0.002, "frequency_step"_a = 20.0, "window_shape"_a = kSound_to_Spectrogram_windowShape::GAUSSIAN, "n_threads"_a = std::nullopt);
+
+	def("to_mfcc",
+	    [](const SoundReferences &sounds, Positive<long> numberOfCoefficients, Positive<double> windowLength, Positive<double> timeStep, Positive<double> firstFilterFrequency, Positive<double> distanceBetweenFilters, std::optional<Positive<double>> maximumFrequency, std::optional<Positive<int>> nThreads) {
+		    return analyseAll(sounds, nThreads, [&](Sound sound) { return Sound_to_MFCC(sound, numberOfCoefficients, windowLength, timeStep, firstFilterFrequency, maximumFrequency ? static_cast<double>(*maximumFrequency) : 0.0, distanceBetweenFilters); });
+	    },
+	    "sounds"_a, "number_of_coefficients"_a = 12, "window_length"_a = 0.015, "time_step"_a = 0.005, "firstFilterFrequency"_a = 100.0, "distance_between_filters"_a = 100.0, "maximum_frequency"_a = std::nullopt, "n_threads"_a = std::nullopt);
+
+	def("to_harmonicity_cc",
+	    [](const SoundReferences &sounds, Positive<double> timeStep, Positive<double> minimumPitch, double silenceThreshold, Positive<double> periodsPerWindow, std::optional<Positive<int>> nThreads) {
+		    return analyseAll(sounds, nThreads, [&](Sound sound) { return Sound_to_Harmonicity_cc(sound, timeStep, minimumPitch, silenceThreshold, periodsPerWindow); });
+	    },
+	    "sounds"_a, "time_step"_a = 0.01, "minimum_pitch"_a = 75.0, "silence_threshold"_a = 0.1, "periods_per_window"_a = 1.0, "n_threads"_a = std::nullopt);
+
+	def("to_harmonicity_ac",
+	    [](const SoundReferences &sounds, Positive<double> timeStep, Positive<double> minimumPitch, double silenceThreshold, Positive<double> periodsPerWindow, std::optional<Positive<int>> nThreads) {
+		    return analyseAll(sounds, nThreads, [&](Sound sound) { return Sound_to_Harmonicity_ac(sound, timeStep, minimumPitch, silenceThreshold, periodsPerWindow); });
+	    },
+	    "sounds"_a, "time_step"_a = 0.01, "minimum_pitch"_a = 75.0, "silence_threshold"_a = 0.1, "periods_per_window"_a = 1.0, "n_threads"_a = std::nullopt);
+}
+
+} // namespace parselmouth
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2026  Yannick Jadoul
+ *
+ * This file is part of Parselmouth.
+ *
+ * Parselmouth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Parselmouth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Parselmouth.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#pragma once
+#ifndef INC_PARSELMOUTH_BATCH_DOCSTRINGS_H
+#define INC_PARSELMOUTH_BATCH_DOCSTRINGS_H
+
+namespace parselmouth {
+
+auto constexpr BATCH_MODULE_DOCSTRING =
+R"(Submodule with functions to analyse many sounds at once.
+
+The functions in this module take a list of `parselmouth.Sound` objects and
+run the same analysis as the corresponding `parselmouth.Sound` method on
+each of them. Rather than looping in Python, the analyses are scheduled as
+one job per sound on a persistent pool of native worker threads, and the
+results are returned as a list, in the same order as the input sounds.
+
+The GIL is released while the analyses run. The optional ``n_threads``
+argument limits the number of threads used; by default, all threads of the
+pool are used.
+)";
+
+} // namespace parselmouth
+
+#endif // INC_PARSELMOUTH_BATCH_DOCSTRINGS_H
@@ -32,6 +32,7 @@
 #include <pybind11/stl.h>
 
 #include <cassert>
+#include <map>
 
 namespace py = pybind11;
 using namespace py::literals;
@@ -103,7 +104,8 @@ py::object autoSTRVECToArray(autoSTRVEC &&vector) {
 
 class PraatEnvironment {
 public:
-	PraatEnvironment() : m_objects(theCurrentPraatObjects), m_interpreter(Interpreter_create()), m_lastId(0) {
+	// A CompiledScript passes its own interpreter, which keeps the script's compiled lines between runs
+	explicit PraatEnvironment(Interpreter interpreter = nullptr) : m_objects(theCurrentPraatObjects), m_ownedInterpreter(interpreter ? autoInterpreter() : Interpreter_create()), m_interpreter(interpreter ? interpreter : m_ownedInterpreter.get()), m_lastId(0) {
 		assert(m_objects->n == 0);
 		m_objects->uniqueId = 0;
 	}
@@ -119,10 +121,10 @@ public:
 	}
 
 	auto interpreter() const {
-		return m_interpreter.get();
+		return m_interpreter;
 	}
 
-	void addObjects(const std::vector<std::reference_wrapper<structData>> &objects, bool select) {
+	void addObjects(const std::vector<std::reference_wrapper<structData>> &objects, bool select, bool updateActions = true) {
 		// Add references to the passed objects to the Praat object list
 		for (auto &data : objects) {
 			praat_newReference(&data.get()); // Since we're registering this is just a reference, running a command like "Remove" should normally be OK; through hack/workaround: a PraatObject now contains a boolean 'owned' to know if the data should be deleted
@@ -133,7 +135,9 @@ public:
 		}
 		// praat_updateSelection will change which objects are selected, and we don't want that
 		m_objects->totalBeingCreated = 0;
-		praat_show();
+		// Updating which actions are executable for the selection is only needed to look up a command by its title
+		if (updateActions)
+			praat_show();
 		m_lastId = m_objects->uniqueId;
 	}
 
@@ -203,7 +207,8 @@ private:
 	// Let's not trust the combination of Praat and static initialization order to safely have a static autoInterpreter member
 
 	PraatObjects m_objects;
-	autoInterpreter m_interpreter;
+	autoInterpreter m_ownedInterpreter;
+	Interpreter m_interpreter;
 
 	std::vector<py::object> m_keepAliveObjects;
 
@@ -318,31 +323,69 @@ py::object PraatEnvironment::fromPraatResult(const std::u32string &callbackName,
 }
 
 
-auto callPraatCommand(const std::vector<std::reference_wrapper<structData>> &objects, const std::u32string &command, py::args args, py::kwargs kwargs) {
+// The commands resolved by a PreparedCommand, by completed title and classes of the selected objects
+// These are only valid as long as Praat's actions and menu commands have not been added, removed, sorted, hidden, or shown since
+struct ResolvedPraatCommands {
+	std::map<std::pair<std::u32string, std::vector<ClassInfo>>, Praat_Command> commands;
+	integer actionsGeneration = -1;
+	integer menuCommandsGeneration = -1;
+
+	bool isValid() const { return actionsGeneration == praat_getActionsGeneration() && menuCommandsGeneration == praat_getMenuCommandsGeneration(); }
+
+	void validate() {
+		if (!isValid()) {
+			commands.clear();
+			actionsGeneration = praat_getActionsGeneration();
+			menuCommandsGeneration = praat_getMenuCommandsGeneration();
+		}
+	}
+};
+
+auto callPraatCommand(const std::vector<std::reference_wrapper<structData>> &objects, const std::u32string &command, py::args args, py::kwargs kwargs, ResolvedPraatCommands *resolvedCommands = nullptr) {
 	auto extraObjects = extractKwarg<std::vector<std::reference_wrapper<structData>>, py::list>(kwargs, "extra_objects", {}, "List[parselmouth.Data]");
 	auto returnString = extractKwarg<bool, py::bool_>(kwargs, "return_string", false, "bool");
 	checkUnkownKwargs(kwargs);
 
-	PraatEnvironment environment;
-	environment.addObjects(objects, true);
-	environment.addObjects(extraObjects, false);
-	auto praatArgs = environment.toPraatArgs(args);
-
 	// If there are arguments, let's help the user and append "..." to the command, if not yet there
 	auto completedCommand = command;
 	if (args.size() > 0 && !endsWith(command, U"..."))
 		completedCommand += U"...";
 
+	// A prepared command skips looking up the command, if it was already found for the same classes of selected objects
+	std::pair<std::u32string, std::vector<ClassInfo>> signature;
+	Praat_Command resolvedCommand = nullptr;
+	if (resolvedCommands) {
+		resolvedCommands->validate();  // Forget all resolved commands if any Praat_Command could have been removed
+		signature.first = completedCommand;
+		for (auto &data : objects)
+			signature.second.push_back(data.get().classInfo);
+		if (auto found = resolvedCommands->commands.find(signature); found != resolvedCommands->commands.end())
+			resolvedCommand = found->second;
+	}
+
+	PraatEnvironment environment;
+	environment.addObjects(objects, true, !resolvedCommand);
+	environment.addObjects(extraObjects, false, !resolvedCommand);
+	auto praatArgs = environment.toPraatArgs(args);
+
 	// Prepare to intercept the output of the command
 	MelderInfoInterceptor interceptor;
 
 	// Actually find the command and execute it
 	// We need to pass a non-nullptr Interpreter to praat_doAction and praat_doMenuCommand if we want 'theInterpreterNumvec' and 'theInterpreterNummat' to be used
-	Praat_Command executedCommand = praat_doAction(completedCommand.c_str(), static_cast<int>(praatArgs.size() - 1), praatArgs.data(), environment.interpreter());
-	if (!executedCommand)
-		executedCommand = praat_doMenuCommand(completedCommand.c_str(), static_cast<int>(praatArgs.size() - 1), praatArgs.data(), environment.interpreter());
-	if (!executedCommand)
-		Melder_throw(U"Command \"", command.c_str(), U"\" not available for given objects.");
+	Praat_Command executedCommand = resolvedCommand;
+	if (executedCommand) {
+		executedCommand->callback(nullptr, static_cast<integer>(praatArgs.size() - 1), praatArgs.data(), nullptr, environment.interpreter(), completedCommand.c_str(), false, nullptr, nullptr);
+	}
+	else {
+		executedCommand = praat_doAction(completedCommand.c_str(), static_cast<int>(praatArgs.size() - 1), praatArgs.data(), environment.interpreter());
+		if (!executedCommand)
+			executedCommand = praat_doMenuCommand(completedCommand.c_str(), static_cast<int>(praatArgs.size() - 1), praatArgs.data(), environment.interpreter());
+		if (!executedCommand)
+			Melder_throw(U"Command \"", command.c_str(), U"\" not available for given objects.");
+		if (resolvedCommands && resolvedCommands->isValid())  // Unless the command itself changed Praat's actions or menu commands
+			resolvedCommands->commands.emplace(std::move(signature), executedCommand);
+	}
 
 	// Based on the prefix of the command's callback, convert the result to a Python object
 	assert(executedCommand);
@@ -352,13 +395,14 @@ auto callPraatCommand(const std::vector<std::reference_wrapper<structData>> &obj
 		return environment.fromPraatResult(executedCommand->nameOfCallback, interceptor.get());
 }
 
-auto runPraatScript(const std::vector<std::reference_wrapper<structData>> &objects, char32 *script, py::args args, py::kwargs kwargs) {
+// If compiledInterpreter is passed, the script has been compiled into it before (see CompiledScript), and script is not used
+auto runPraatScript(const std::vector<std::reference_wrapper<structData>> &objects, char32 *script, py::args args, py::kwargs kwargs, Interpreter compiledInterpreter = nullptr) {
 	auto extraObjects = extractKwarg<std::vector<std::reference_wrapper<structData>>, py::list>(kwargs, "extra_objects", {}, "List[parselmouth.Data]");
 	auto captureOutput = extractKwarg<bool, py::bool_>(kwargs, "capture_output", false, "bool");
 	auto returnVariables = extractKwarg<bool, py::bool_>(kwargs, "return_variables", false, "bool");
 	checkUnkownKwargs(kwargs);
 
-	PraatEnvironment environment;
+	PraatEnvironment environment(compiledInterpreter);
 	environment.addObjects(objects, true);
 	environment.addObjects(extraObjects, false);
 	auto praatArgs = environment.toPraatArgs(args);
@@ -369,9 +413,13 @@ auto runPraatScript(const std::vector<std::reference_wrapper<structData>> &objec
 		interceptor.emplace();
 
 	try {
-		Interpreter_readParameters(environment.interpreter(), script);
+		if (!compiledInterpreter)
+			Interpreter_readParameters(environment.interpreter(), script);
 		Interpreter_getArgumentsFromArgs(environment.interpreter(), static_cast<int>(praatArgs.size() - 1), praatArgs.data());
-		Interpreter_run(environment.interpreter(), script, false);  // TODO: Is reuseVariables useful for us?
+		if (compiledInterpreter)
+			Interpreter_runCompiled(environment.interpreter(), false);  // The variables of the previous run are cleared
+		else
+			Interpreter_run(environment.interpreter(), script, false);  // TODO: Is reuseVariables useful for us?
 	}
 	catch (MelderError) {
 		Melder_throw(U"Script not completed.");
@@ -433,11 +481,96 @@ auto castPraatCommand(const structPraat_Command &command) {
 
 using CastedPraatCommand = decltype(castPraatCommand(std::declval<structPraat_Command &>()));
 
+class CompiledScript {
+public:
+	explicit CompiledScript(const std::u32string &script) : m_script(Melder_dup(script.c_str())), m_interpreter(Interpreter_create()) {
+		Melder_includeIncludeFiles(&m_script);
+
+		// Read the form, split the lines, and find the labels once; the compiled lines point into m_lines, which is split in place
+		m_lines = Melder_dup(m_script.get());
+		Interpreter_readParameters(m_interpreter.get(), m_lines.get());
+		Interpreter_compile(m_interpreter.get(), m_lines.get());
+		Interpreter_checkCompiledBlocks(m_interpreter.get());
+	}
+
+	std::u32string script() const { return m_script.get(); }
+
+	py::object run(const std::vector<std::reference_wrapper<structData>> &objects, py::args args, py::kwargs kwargs) {
+		if (m_interpreter->running)
+			Melder_throw(U"This compiled script is already running.");
+		return runPraatScript(objects, nullptr, std::move(args), std::move(kwargs), m_interpreter.get());
+	}
+
+private:
+	autostring32 m_script;
+	autostring32 m_lines;
+	autoInterpreter m_interpreter;
+};
+
+class PreparedCommand {
+public:
+	explicit PreparedCommand(std::u32string command) : m_command(std::move(command)) {}
+
+	const std::u32string &command() const { return m_command; }
+
+	py::object call(const std::vector<std::reference_wrapper<structData>> &objects, py::args args, py::kwargs kwargs) { return callPraatCommand(objects, m_command, std::move(args), std::move(kwargs), &m_resolvedCommands); }
+
+private:
+	std::u32string m_command;
+	ResolvedPraatCommands m_resolvedCommands;
+};
+
 } // namespace
 
+CLASS_BINDING(PreparedCommand, PreparedCommand)
+BINDING_CONSTRUCTOR(PreparedCommand, "PreparedCommand", PRAAT_PREPARED_COMMAND_DOCSTRING)
+BINDING_INIT(PreparedCommand) {
+	def(py::init<std::u32string>(),
+	    "command"_a);
+
+	def_property_readonly("command", &PreparedCommand::command);
+
+	def("__call__",
+	    [](PreparedCommand &self, structData &data, py::args args, py::kwargs kwargs) { return self.call({ std::ref(data) }, args, kwargs); },
+	    "object"_a);
+
+	def("__call__",
+	    [](PreparedCommand &self, const std::vector<std::reference_wrapper<structData>> &objects, py::args args, py::kwargs kwargs) { return self.call(objects, args, kwargs); },
+	    "objects"_a);
+
+	def("__call__",
+	    [](PreparedCommand &self, py::args args, py::kwargs kwargs) { return self.call({}, args, kwargs); });
+
+	def("__repr__",
+	    [](const PreparedCommand &self) { return "PreparedCommand(" + py::cast<std::string>(py::repr(py::cast(self.command()))) + ")"; });
+}
+
+CLASS_BINDING(CompiledScript, CompiledScript)
+BINDING_CONSTRUCTOR(CompiledScript, "CompiledScript", PRAAT_COMPILED_SCRIPT_DOCSTRING)
+BINDING_INIT(CompiledScript) {
+	def(py::init<std::u32string>(),
+	    "script"_a);
+
+	def_property_readonly("script", &CompiledScript::script);
+
+	def("__call__",
+	    [](CompiledScript &self, structData &data, py::args args, py::kwargs kwargs) { return self.run({ std::ref(data) }, args, kwargs); },
+	    "object"_a);
+
+	def("__call__",
+	    [](CompiledScript &self, const std::vector<std::reference_wrapper<structData>> &objects, py::args args, py::kwargs kwargs) { return self.run(objects, args, kwargs); },
+	    "objects"_a);
+
+	def("__call__",
+	    [](CompiledScript &self, py::args args, py::kwargs kwargs) { return self.run({}, args, kwargs); });
+}
+
 class PraatModule;
 
 PRAAT_MODULE_BINDING(praat, PraatModule, PRAAT_MODULE_DOCSTRING) {
+	NESTED_BINDINGS(PreparedCommand,
+	                CompiledScript)
+
 	def("call",
 	    [](const std::u32string &command, py::args args, py::kwargs kwargs) { return callPraatCommand({}, command, args, kwargs); },
 	    "command"_a);
@@ -447,10 +580,15 @@ PRAAT_MODULE_BINDING(praat, PraatModule, PRAAT_MODULE_DOCSTRING) {
 	    "object"_a, "command"_a);
 
 	def("call",
-	    &callPraatCommand,
+	    [](const std::vector<std::reference_wrapper<structData>> &objects, const std::u32string &command, py::args args, py::kwargs kwargs) { return callPraatCommand(objects, command, args, kwargs); },
 	    "objects"_a, "command"_a,
 	    PRAAT_CALL_DOCSTRING);
 
+	def("prepare",
+	    [](const std::u32string &command) { return PreparedCommand(command); },
+	    "command"_a,
+	    PRAAT_PREPARE_DOCSTRING);
+
 	def("run",
 	    [](const std::u32string &script, py::args args, py::kwargs kwargs) { return runPraatScriptFromText({}, script, args, kwargs); },
 	    "script"_a);
@@ -478,6 +616,11 @@ PRAAT_MODULE_BINDING(praat, PraatModule, PRAAT_MODULE_DOCSTRING) {
 	    PRAAT_RUN_FILE_DOCSTRING);
 
 
+	def("compile_script",
+	    [](const std::u32string &script) { return CompiledScript(script); },
+	    "script"_a,
+	    PRAAT_COMPILE_SCRIPT_DOCSTRING);
+
 	def("_get_actions",
 	    []() {
 		    std::vector<CastedPraatCommand> actions;
@@ -123,6 +123,41 @@ parselmouth.praat.run, parselmouth.praat.run_file
 :praat:`Scripting`
 )";
 
+auto constexpr PRAAT_PREPARE_DOCSTRING =
+R"(Prepare a Praat command to be called repeatedly.
+
+The returned `PreparedCommand` can be called like `call`, but without
+passing the command again. The first time the command is called for a
+certain combination of classes of selected objects, the Praat command is
+looked up as in `call`. Subsequent calls with objects of the same classes
+skip this look-up and directly execute the found command, which speeds up
+calling cheap commands (e.g., queries) many times in a loop.
+
+Parameters
+----------
+command : str
+    The Praat action to call; see `call`.
+
+Returns
+-------
+parselmouth.praat.PreparedCommand
+    The prepared command, which can be called with the same arguments as
+    `call`, leaving out ``command``.
+
+See Also
+--------
+parselmouth.praat.call
+)";
+
+auto constexpr PRAAT_PREPARED_COMMAND_DOCSTRING =
+R"(A Praat command, prepared by `parselmouth.praat.prepare` to be called
+repeatedly.
+
+Calling a `PreparedCommand` with zero, one, or multiple objects and the
+command's arguments is equivalent to passing the same objects, command,
+and arguments to `parselmouth.praat.call`.
+)";
+
 auto constexpr PRAAT_RUN_DOCSTRING =
 R"(Run a Praat script.
 
@@ -257,6 +292,49 @@ parselmouth.praat.run, parselmouth.praat.call
 :praat:`Scripting`
 )";
 
+auto constexpr PRAAT_COMPILE_SCRIPT_DOCSTRING =
+R"(Prepare a Praat script to be run repeatedly.
+
+The 'include' statements of the script are resolved, its form is read,
+its text is split into lines, and its labels are found once, when the
+script is compiled. Blocks that are not closed (e.g., an 'if' without
+'endif', or a 'for' without 'endfor') are reported at this point, rather
+than when a run reaches them. This check is stricter than `run`: it also
+rejects unclosed blocks in lines that are never run (e.g., lines skipped
+by a 'goto'), which `run` accepts. The returned `CompiledScript` can then
+be called like `run`, but without passing the script again, and with
+different objects and arguments on every call; only the script's
+variables and arguments are reset between calls.
+
+Note that the formulas on the script's lines are still evaluated when they
+are run, since Praat resolves variable and object names in formulas while
+the script is running.
+
+Parameters
+----------
+script : str
+    The content of a Praat script to be compiled; see `run`.
+
+Returns
+-------
+parselmouth.praat.CompiledScript
+    The compiled script, which can be called with the same arguments as
+    `run`, leaving out ``script``.
+
+See Also
+--------
+parselmouth.praat.run
+)";
+
+auto constexpr PRAAT_COMPILED_SCRIPT_DOCSTRING =
+R"(A Praat script, compiled by `parselmouth.praat.compile_script` to be run
+repeatedly.
+
+Calling a `CompiledScript` with zero, one, or multiple objects and the
+script's arguments is equivalent to passing the same objects, script, and
+arguments to `parselmouth.praat.run`.
+)";
+
 } // namespace parselmouth
 
 #endif // INC_PARSELMOUTH_PRAAT_DOCSTRINGS_H
@@ -50,4 +50,12 @@ def resources(request):
 	return Resources(request.fspath.dirname)
 
 
+@pytest.fixture(params=[1, 3])
+def num_threads(request):
+	# A number of threads for the test to pass to parselmouth.set_num_threads; the default is restored afterwards
+	yield request.param
+	import parselmouth
+	parselmouth.set_num_threads(None)
+
+
 from resource_fixtures import *
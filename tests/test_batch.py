@@ -0,0 +1,75 @@
+# Copyright (C) 2026  Yannick Jadoul
+#
+# This file is part of Parselmouth.
+#
+# Parselmouth is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# Parselmouth is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with Parselmouth.  If not, see <http://www.gnu.org/licenses/>
+
+import pytest
+
+import parselmouth
+import numpy as np
+
+
+@pytest.fixture
+def sounds(sound):
+	return [sound.extract_part(from_time=t, to_time=t + 0.5) for t in np.arange(0, 2.5, 0.25)]
+
+
+@pytest.mark.parametrize("analysis", ["to_pitch", "to_intensity", "to_formant_burg", "to_spectrogram", "to_mfcc", "to_harmonicity_cc", "to_harmonicity_ac"])
+@pytest.mark.parametrize("n_threads", [None, 1, 3])
+def test_batch_matches_sound_method(sounds, analysis, n_threads):
+	results = getattr(parselmouth.batch, analysis)(sounds, n_threads=n_threads)
+	assert len(results) == len(sounds)
+	for sound, result in zip(sounds, results):
+		expected = getattr(sound, analysis)()
+		assert type(result) == type(expected)
+		assert result.xmin == expected.xmin and result.xmax == expected.xmax and result.nx == expected.nx
+		if isinstance(result, parselmouth.Pitch):
+			assert np.array_equal(result.selected_array['frequency'], expected.selected_array['frequency'])
+		elif isinstance(result, parselmouth.Formant):
+			assert np.array_equal([result.get_value_at_time(1, t) for t in expected.ts()], [expected.get_value_at_time(1, t) for t in expected.ts()], equal_nan=True)
+		elif isinstance(result, parselmouth.MFCC):
+			assert np.array_equal(result.to_array(), expected.to_array())
+		else:
+			assert np.array_equal(result.values, expected.values)
+
+
+def test_batch_errors(sounds):
+	with pytest.raises(parselmouth.PraatError):
+		parselmouth.batch.to_pitch(sounds, pitch_floor=1.0)
+	assert parselmouth.batch.to_pitch([]) == []
+
+
+def test_num_threads(sounds):
+	default_num_threads = parselmouth.get_num_threads()
+	assert default_num_threads >= 1
+	try:
+		expected = [pitch.selected_array['frequency'] for pitch in parselmouth.batch.to_pitch(sounds)]
+		for n_threads in [1, 2, 7]:
+			parselmouth.set_num_threads(n_threads)
+			assert parselmouth.get_num_threads() == n_threads
+			pitches = parselmouth.batch.to_pitch(sounds)
+			assert all(np.array_equal(pitch.selected_array['frequency'], e) for pitch, e in zip(pitches, expected))
+		with pytest.raises(ValueError, match="The number of threads should be positive"):
+			parselmouth.set_num_threads(0)
+	finally:
+		parselmouth.set_num_threads(None)
+	assert parselmouth.get_num_threads() == default_num_threads
+
+
+def test_batch_keywords(sounds):
+	# The batch functions take the same keyword arguments as the Sound methods they wrap
+	kwargs = dict(number_of_coefficients=10, window_length=0.02, time_step=0.01, firstFilterFrequency=150.0, distance_between_filters=120.0, maximum_frequency=4000.0)
+	for sound, result in zip(sounds, parselmouth.batch.to_mfcc(sounds, **kwargs)):
+		assert np.array_equal(result.to_array(), sound.to_mfcc(**kwargs).to_array())
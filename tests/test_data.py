@@ -19,6 +19,9 @@ import pytest
 
 import parselmouth
 
+import numpy as np
+import pickle
+
 
 def test_read():
 	assert parselmouth.Data.read == parselmouth.read
@@ -29,4 +32,48 @@ def test_read_nonexistent():
 		parselmouth.read("nonexistent.wav")
 
 
+@pytest.mark.parametrize('protocol', range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_pickle(thing, text_grid, protocol):
+	for data in [thing, text_grid]:
+		unpickled = pickle.loads(pickle.dumps(data, protocol))
+		assert type(unpickled) is type(data)
+		assert unpickled == data and unpickled is not data
+
+
+def test_pickle_out_of_band(sound):
+	if pickle.HIGHEST_PROTOCOL < 5:
+		pytest.skip("Pickle protocol 5 not available")
+	buffers = []
+	pickled = pickle.dumps(sound, 5, buffer_callback=buffers.append)
+	assert len(buffers) == 1 and len(pickled) < 1000
+	assert np.shares_memory(np.asarray(buffers[0].raw()), sound.values)
+	assert pickle.loads(pickled, buffers=buffers) == sound
+	assert pickle.loads(pickled, buffers=[bytes(buffers[0].raw())]) == sound
+
+	pitch = sound.to_pitch()
+	buffers = []
+	pickled = pickle.dumps(pitch, 5, buffer_callback=buffers.append)
+	assert len(buffers) == 1
+	assert pickle.loads(pickled, buffers=buffers) == pitch
+
+
+def test_pickle_matrix_classes(sound):
+	# Only the classes that store nothing more than their matrix are pickled as their values; other subclasses of Matrix in Praat's binary format
+	for data in [sound, sound.to_spectrogram(), sound.to_intensity(), sound.to_harmonicity()]:
+		assert len(data.__reduce_ex__(2)[1]) == 3
+		assert pickle.loads(pickle.dumps(data)) == data
+	power_cepstrogram = parselmouth.praat.call(sound, "To PowerCepstrogram", 60.0, 0.002, 5000.0, 50.0)
+	assert len(power_cepstrogram.__reduce_ex__(2)[1]) == 2
+	assert pickle.loads(pickle.dumps(power_cepstrogram)) == power_cepstrogram
+
+
+def test_pickle_errors(sound):
+	pitch_state = sound.to_pitch().__reduce_ex__(2)[1]
+	with pytest.raises(TypeError, match="cannot unpickle a Pitch object as a Sound object"):
+		parselmouth.Sound._unpickle(*pitch_state)
+	class_name, header, values = sound.__reduce_ex__(2)[1]
+	with pytest.raises(parselmouth.PraatError, match="Cannot unpickle a Sound( [0-9]+)? of 1 by [0-9]+ values from [0-9]+ bytes"):
+		parselmouth.Sound._unpickle(class_name, header, values[:, :-1])
+
+
 # TODO Other encodings
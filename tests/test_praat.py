@@ -23,6 +23,8 @@ import itertools
 import numpy as np
 import os
 import re
+import subprocess
+import sys
 import textwrap
 
 
@@ -82,6 +84,62 @@ def test_call_parameters(sound):
 		parselmouth.praat.call("Create Table with column names", "test", 10, 42)
 
 
+def test_prepare(sound):
+	get_time = parselmouth.praat.prepare("Get time from sample number")
+	assert get_time.command == "Get time from sample number"
+	assert repr(get_time) == "PreparedCommand('Get time from sample number')"
+	for i in [1, 10, 100]:
+		assert get_time(sound, i) == parselmouth.praat.call(sound, "Get time from sample number", i)
+
+	point_process = parselmouth.praat.call(sound, "To PointProcess (periodic, cc)", 75, 600)
+	get_jitter = parselmouth.praat.prepare("Get jitter (local)")
+	for _ in range(2):
+		assert get_jitter(point_process, 0, 0, 0.0001, 0.02, 1.3) == parselmouth.praat.call(point_process, "Get jitter (local)", 0, 0, 0.0001, 0.02, 1.3)
+	with pytest.raises(parselmouth.PraatError, match=r"Command \"Get jitter \(local\)\" not available for given objects"):
+		get_jitter(sound, 0, 0, 0.0001, 0.02, 1.3)
+	get_shimmer = parselmouth.praat.prepare("Get shimmer (local)...")
+	for _ in range(2):
+		assert get_shimmer([sound, point_process], 0, 0, 0.0001, 0.02, 1.3, 1.6) == parselmouth.praat.call([sound, point_process], "Get shimmer (local)", 0, 0, 0.0001, 0.02, 1.3, 1.6)
+
+	create_sound = parselmouth.praat.prepare("Create Sound from formula")
+	for name in ["a", "b"]:
+		assert create_sound(name, 1, 0, 1, 44100, "1/2").name == name
+
+
+def test_prepare_after_replaced_action(tmp_path):
+	# Adding a script action with the same title and classes frees the original action, which a prepared command may have resolved before.
+	# This runs in a separate process, because the original action cannot be restored afterwards.
+	script_file = tmp_path / "replacement.praat"
+	script_file.write_text("writeInfo: \"replaced\"\n")
+	code = textwrap.dedent(f"""
+		import parselmouth
+		point_process = parselmouth.praat.call("Create empty PointProcess", "empty", 0, 1)
+		get_number_of_points = parselmouth.praat.prepare("Get number of points")
+		assert get_number_of_points(point_process) == 0
+		parselmouth.praat.run('Add action command: "PointProcess", 1, "", 0, "", 0, "Get number of points", "", 0, "{script_file}"')
+		try:
+			get_number_of_points(point_process)
+		except parselmouth.PraatError as e:
+			assert "From a script you cannot directly call a menu command that calls another script." in str(e), str(e)
+		else:
+			assert False, "The replaced action was called"
+	""")
+	subprocess.run([sys.executable, "-c", code], check=True)
+
+
+def test_prepare_after_hidden_action():
+	# Hiding or showing an action makes a prepared command resolve it again, which still finds the hidden action from a script
+	point_process = parselmouth.praat.call("Create empty PointProcess", "empty", 0, 1)
+	get_number_of_points = parselmouth.praat.prepare("Get number of points")
+	assert get_number_of_points(point_process) == 0
+	try:
+		parselmouth.praat.run('Hide action command: "PointProcess", "", "", "Get number of points"')
+		assert get_number_of_points(point_process) == 0
+	finally:
+		parselmouth.praat.run('Show action command: "PointProcess", "", "", "Get number of points"')
+	assert get_number_of_points(point_process) == 0
+
+
 def test_call_return_many(sound):
 	stereo_sound = sound.convert_to_stereo()
 	channels = parselmouth.praat.call(stereo_sound, "Extract all channels")
@@ -238,6 +296,123 @@ def test_run_with_return_variables():
 	assert set(variables.keys()) == {'a', 'b$', 'c#', 'd##'} | praat_builtin_variables
 
 
+@pytest.mark.parametrize('shape', [(3, 4, 5), (200, 300, 600), (97, 513, 257)])
+def test_matrix_multiplication(shape):
+	n_rows, n_inner, n_columns = shape
+	script = textwrap.dedent(f"""\
+	x## = randomGauss## ({n_rows}, {n_inner}, 0, 1)
+	y## = randomGauss## ({n_inner}, {n_columns}, 0, 1)
+	xt## = transpose## (x##)
+	yt## = transpose## (y##)
+	xy## = mul## (x##, y##)
+	xy_fast## = mul_fast## (x##, y##)
+	xy_tn## = mul_tn## (xt##, y##)
+	xy_nt## = mul_nt## (x##, yt##)
+	xy_tt## = mul_tt## (xt##, yt##)
+	""")
+	_, variables = parselmouth.praat.run(script, return_variables=True)
+	expected = variables['x##'] @ variables['y##']
+	for name in ['xy##', 'xy_fast##', 'xy_tn##', 'xy_nt##', 'xy_tt##']:
+		assert variables[name].shape == (n_rows, n_columns)
+		assert np.allclose(variables[name], expected, rtol=1e-12, atol=1e-12)
+
+
+@pytest.mark.parametrize('shape', [(30, 5), (300, 80)])
+def test_sums_of_squares_and_cross_products(shape):
+	# The SSCP of a table is X'.X of its centred columns, through mtm_MAT_out for small and the packed multiplication for larger tables
+	values = np.random.default_rng(3).standard_normal(shape)
+	matrix = parselmouth.praat.call("Create simple Matrix from values", "values", values)
+	table = parselmouth.praat.call(matrix, "To TableOfReal")
+	sscp = parselmouth.praat.call(table, "To SSCP", 0, 0, 0, 0)
+	result = parselmouth.praat.call(sscp, "To Matrix").values
+	centred = values - values.mean(axis=0)
+	assert result.shape == (shape[1], shape[1])
+	assert np.allclose(result, centred.T @ centred, rtol=1e-12, atol=1e-10)
+	assert np.array_equal(result, result.T)
+
+
+def test_unmix(sound):
+	# Unmixing multiplies the pseudo-inverse of the mixing matrix with all samples, through the packed multiplication
+	stereo_sound = parselmouth.Sound(np.vstack([sound.values[0], sound.values[0][::-1]]), sampling_frequency=sound.sampling_frequency)
+	mixing_matrix = parselmouth.praat.call("Create simple MixingMatrix", "mm", 2, 2, "1.0 0.5 0.25 1.0")
+	unmixed = parselmouth.praat.call([stereo_sound, mixing_matrix], "Unmix")
+	mixing = np.array([[1.0, 0.5], [0.25, 1.0]])
+	assert np.allclose(unmixed.values, np.linalg.pinv(mixing) @ stereo_sound.values, rtol=1e-10, atol=1e-12)
+
+
+def dtw_path_analyses(slope, band):
+	return [
+		(lambda s: s.to_mfcc(), (1.0, 0.0, 0.0, 0.0, 0.056, False, False, slope), (1.0, 0.0, 0.0, 0.0, 0.056, band, slope)),
+		(lambda s: s.to_mfcc(), (1.0, 0.5, 1.0, 0.5, 0.056, False, False, slope), (1.0, 0.5, 1.0, 0.5, 0.056, band, slope)),
+		(lambda s: s.to_spectrogram(), (False, False, slope), (band, slope)),
+		(lambda s: s.to_pitch(), (24.0, 10.0, False, False, slope), (24.0, 10.0, band, slope)),
+	]
+
+
+def assert_same_dtw_path(duration_tier, dtw, test, prototype):
+	# The y time at the x time of every other point (the ends of the path's segments) is the start plus the area under the relative durations;
+	# at the ends of the domain, "Get y time from x time" returns the x time itself
+	n_points = int(parselmouth.praat.call(duration_tier, "Get number of points"))
+	for index in range(3, n_points - 1, 2):
+		t = parselmouth.praat.call(duration_tier, "Get time from index", index)
+		y_time = prototype.xmin + parselmouth.praat.call(duration_tier, "Get target duration", test.xmin, t)
+		assert y_time == pytest.approx(parselmouth.praat.call(dtw, "Get y time from x time", t), rel=1e-12, abs=1e-12)
+	assert parselmouth.praat.call(duration_tier, "Get target duration", test.xmin, test.xmax) == pytest.approx(prototype.xmax - prototype.xmin, rel=1e-12)
+
+
+@pytest.mark.parametrize('band', [0.0, 0.05])
+@pytest.mark.parametrize('slope', ["no restriction", "1/3 < slope < 3", "1/2 < slope < 2", "2/3 < slope < 3/2"])
+def test_dtw_path_in_band(sound, band, slope):
+	prototype = sound.extract_part(0.2, 1.4)
+	test = sound.extract_part(0.3, 1.6)
+	for analyse, dtw_arguments, band_arguments in dtw_path_analyses(slope, band):
+		objects = [analyse(prototype), analyse(test)]
+		dtw = parselmouth.praat.call(objects, "To DTW", *dtw_arguments)
+		parselmouth.praat.call(dtw, "Find path (band & slope)", band, slope)
+		path = parselmouth.praat.call(objects, "To DurationTier (DTW path in band)", *band_arguments)
+		assert isinstance(path, parselmouth.Data) and path.class_name == "DurationTier"
+		assert_same_dtw_path(path, dtw, test, prototype)
+
+
+def test_dtw_path_in_full_band(sound):
+	# A band wider than both objects leaves every cell reachable, as does the absence of a band (0) in the full DTW
+	prototype = sound.extract_part(0.2, 1.4)
+	test = sound.extract_part(0.3, 1.6)
+	for analyse, dtw_arguments, band_arguments in dtw_path_analyses("no restriction", 2.0):
+		objects = [analyse(prototype), analyse(test)]
+		dtw = parselmouth.praat.call(objects, "To DTW", *dtw_arguments)
+		parselmouth.praat.call(dtw, "Find path (band & slope)", 0.0, "no restriction")
+		path = parselmouth.praat.call(objects, "To DurationTier (DTW path in band)", *band_arguments)
+		assert_same_dtw_path(path, dtw, test, prototype)
+
+
+def test_to_cochleagram(sound, num_threads):
+	def cochleagram(forward_masking_time):
+		return parselmouth.praat.call(parselmouth.praat.call(sound, "To Cochleagram", 0.01, 0.1, 0.03, forward_masking_time), "To Matrix")
+
+	# Without forward masking, every frame is the Excitation of the Hann-windowed frame's Spectrum
+	unmasked = cochleagram(0.0)
+	assert unmasked.values.shape[0] == 256
+	half_window = int(np.floor(0.03 / sound.dx)) // 2 - 1
+	window = 0.5 - 0.5 * np.cos(2 * np.pi * np.arange(1, 2 * half_window + 1) / (2 * half_window + 1))
+	for i in [0, unmasked.n_columns // 2, unmasked.n_columns - 1]:
+		start = int(np.floor((unmasked.xs()[i] - sound.x1) / sound.dx + 1)) + 1 - half_window
+		frame = parselmouth.Sound(sound.values[0, start - 1:start - 1 + len(window)] * window, sampling_frequency=sound.sampling_frequency)
+		excitation = parselmouth.praat.call(frame.to_spectrum(fast=True), "To Excitation", 0.1)
+		assert np.allclose(unmasked.values[:, i], parselmouth.praat.call(excitation, "To Matrix").values[0], rtol=1e-12, atol=0)
+
+	# Forward masking adds the exponentially decaying previous frames
+	masked = cochleagram(0.03)
+	damping = np.exp(-0.01 / 0.03)
+	expected = unmasked.values.copy()
+	for i in range(1, expected.shape[1]):
+		expected[:, i] += damping * expected[:, i - 1]
+	assert np.allclose(masked.values, (1 - damping) * expected, rtol=1e-12, atol=0)
+
+	parselmouth.set_num_threads(num_threads)
+	assert np.array_equal(cochleagram(0.03).values, masked.values)
+
+
 def test_run_with_capture_output_and_return_variables():
 	script = textwrap.dedent("""\
 	a = 42
@@ -252,6 +427,65 @@ def test_run_with_capture_output_and_return_variables():
 	assert 'a' in variables and 'b$' in variables
 
 
+def test_compile_script(sound):
+	script = textwrap.dedent("""\
+	form Test
+		positive minPitch 100.0
+		real timeStep 0.0
+	endform
+
+	To Intensity: minPitch, timeStep, "yes"
+	result = Get mean: 0, 0, "energy"
+	""")
+
+	compiled = parselmouth.praat.compile_script(script)
+	assert compiled.script == script
+	for min_pitch, time_step in [(75, 0.0), (100, 0.01), (200, 0.05)]:
+		objects, variables = compiled(sound, min_pitch, time_step, return_variables=True)
+		assert objects[0] == parselmouth.praat.call(sound, "To Intensity", min_pitch, time_step, "yes")
+		assert variables['result'] == parselmouth.praat.run(sound, script, min_pitch, time_step, return_variables=True)[1]['result']
+
+	with pytest.raises(parselmouth.PraatError, match="Found 0 arguments but expected more."):
+		compiled(sound)
+
+	assert parselmouth.praat.compile_script("writeInfo: 42")(capture_output=True) == ([], "42")
+
+
+def test_compile_script_syntax_errors():
+	# The script is split into lines and checked once, so an unclosed block deep in the body is reported before anything is run
+	body = "\n".join(f"a{i} = {i}" for i in range(100))
+	script = f"writeInfo: \"not run\"\n{body}\nif a99 > 0\n\tb = 1\nendfor\n"
+	with pytest.raises(parselmouth.PraatError, match="Unmatched 'endfor' in script line 104"):
+		parselmouth.praat.compile_script(script)
+	with pytest.raises(parselmouth.PraatError, match="matching 'endif' not found\\) in script line 102"):
+		parselmouth.praat.compile_script(f"{body}\nlabel skip\nif 1\n\tb = 1\n")
+	with pytest.raises(parselmouth.PraatError, match="Duplicate label"):
+		parselmouth.praat.compile_script("label a\nlabel a\n")
+
+	# Unlike run, compile_script also rejects an unclosed block in lines that are never run
+	unreachable = "goto done\nfor i to 3\nlabel done\nwriteInfo: \"done\"\n"
+	assert parselmouth.praat.run(unreachable, capture_output=True) == ([], "done")
+	with pytest.raises(parselmouth.PraatError, match="matching 'endfor' not found\\) in script line 2"):
+		parselmouth.praat.compile_script(unreachable)
+
+	# Labels and loops are resolved once and work on every run, with the variables reset in between
+	compiled = parselmouth.praat.compile_script(textwrap.dedent("""\
+	form Test
+		integer n 3
+	endform
+	assert variableExists ("total") = 0
+	total = 0
+	for i to n
+		total += i
+	endfor
+	goto done
+	total = -1
+	label done
+	"""))
+	for n in [3, 10, 1]:
+		assert compiled(n, return_variables=True)[1]['total'] == n * (n + 1) // 2
+
+
 def test_run_file_relative_paths(sound_path, script_path):
 	assert os.getcwd() != os.path.abspath(os.path.dirname(script_path))
 	rel_sound_path = os.path.relpath(sound_path, os.path.dirname(script_path))
@@ -17,6 +17,9 @@
 
 import pytest
 
+import parselmouth
+
+import math
 import numpy as np
 
 
@@ -29,3 +32,83 @@ def test_xs(sampled):
 
 def test_len(sampled):
 	assert len(sampled) == sampled.nx
+
+
+def test_vectorized_time_queries(sound, pitch, intensity):
+	times = np.linspace(sound.xmin - 0.1, sound.xmax + 0.1, 500)
+	formant = sound.to_formant_burg()
+	harmonicity = sound.to_harmonicity()
+
+	def assert_same(vectorized, scalars):
+		assert vectorized.shape == times.shape
+		np.testing.assert_array_equal(vectorized, np.array(scalars))
+
+	assert_same(pitch.get_value_at_time(times), [pitch.get_value_at_time(t) for t in times])
+	assert_same(pitch.get_value_at_time(times, "MEL", "NEAREST"), [pitch.get_value_at_time(t, "MEL", "NEAREST") for t in times])
+	assert_same(intensity.get_value(times), [intensity.get_value(t) for t in times])
+	assert_same(harmonicity.get_value(times, "LINEAR"), [harmonicity.get_value(t, "LINEAR") for t in times])
+	assert_same(formant.get_value_at_time(2, times), [formant.get_value_at_time(2, t) for t in times])
+	assert_same(formant.get_bandwidth_at_time(1, times), [formant.get_bandwidth_at_time(1, t) for t in times])
+
+	formant_numbers = np.arange(1, 6)[:, np.newaxis]
+	values = formant.get_value_at_time(formant_numbers, times)
+	assert values.shape == (5, len(times))
+	for i in range(5):
+		assert_same(values[i], [formant.get_value_at_time(i + 1, t) for t in times])
+
+	assert isinstance(pitch.get_value_at_time(list(times[:3])), np.ndarray)
+	with pytest.raises(ValueError):
+		formant.get_value_at_time([0, 1], times[:2])
+	with pytest.raises(ValueError):
+		formant.get_bandwidth_at_time(0, times[0])
+
+
+def _reference_path_finder(pitch, silence_threshold, voicing_threshold, octave_cost, octave_jump_cost, voiced_unvoiced_cost, ceiling, pull_formants):
+	# A line-by-line transcription of the Viterbi search of Praat's original Pitch_pathFinder, returning the selected frequencies
+	log2 = lambda x: math.log(x) * 1.4426950408889634
+	ceiling2 = 2 * ceiling if pull_formants else ceiling
+	octave_jump_cost *= 0.01 / pitch.dx
+	voiced_unvoiced_cost *= 0.01 / pitch.dx
+	frames = [[(c.frequency, c.strength) for c in frame.candidates] for frame in pitch]
+	voiceless = [[not (0 < f < ceiling2) for f, _ in candidates] for candidates in frames]
+
+	delta = []
+	for frame, candidates, unvoiced in zip(pitch, frames, voiceless):
+		unvoiced_strength = 0.0 if silence_threshold <= 0 else 2.0 - frame.intensity / (silence_threshold / (1.0 + voicing_threshold))
+		unvoiced_strength = voicing_threshold + max(0.0, unvoiced_strength)
+		delta.append([unvoiced_strength if v else s - octave_cost * log2(ceiling / f) for (f, s), v in zip(candidates, unvoiced)])
+
+	psi = [[0] * len(frames[0])]
+	for i in range(1, len(frames)):
+		psi.append([])
+		for j2, (f2, _) in enumerate(frames[i]):
+			maximum, place = -1e30, 0
+			for j1, (f1, _) in enumerate(frames[i - 1]):
+				if voiceless[i][j2]:
+					transition_cost = 0.0 if voiceless[i - 1][j1] else voiced_unvoiced_cost
+				else:
+					transition_cost = voiced_unvoiced_cost if voiceless[i - 1][j1] else octave_jump_cost * abs(log2(f1 / f2))
+				value = delta[i - 1][j1] - transition_cost + delta[i][j2]
+				if value > maximum:
+					maximum, place = value, j1
+			delta[i][j2] = maximum
+			psi[i].append(place)
+
+	place = max(range(len(delta[-1])), key=lambda j: (delta[-1][j], -j))
+	selected = [0.0] * len(frames)
+	for i in reversed(range(len(frames))):
+		selected[i] = frames[i][place][0]
+		if ceiling < selected[i] < ceiling2 and any(f == 0.0 for f, _ in frames[i]):
+			selected[i] = 0.0
+		place = psi[i][place]
+	return np.array(selected)
+
+
+@pytest.mark.parametrize("kwargs", [{}, {'octave_jump_cost': 0.0, 'voicing_threshold': 0.3}, {'silence_threshold': 0.0, 'ceiling': 300.0, 'pull_formants': True}])
+def test_pitch_path_finder(sound, kwargs):
+	pitch = sound.to_pitch_ac(very_accurate=True, max_number_of_candidates=15)
+	arguments = dict(silence_threshold=0.03, voicing_threshold=0.45, octave_cost=0.01, octave_jump_cost=0.35, voiced_unvoiced_cost=0.14, ceiling=600.0, pull_formants=False)
+	arguments.update(kwargs)
+	expected = _reference_path_finder(pitch, **arguments)
+	pitch.path_finder(**arguments)
+	assert np.array_equal(pitch.selected_array['frequency'], expected)
@@ -18,6 +18,8 @@
 import pytest
 
 import parselmouth
+
+import io
 import numpy as np
 
 
@@ -62,3 +64,444 @@ def test_from_scalar(sampling_frequency):
 
 	with pytest.raises(ValueError, match="Cannot create Sound from a single 0-dimensional number"):
 		parselmouth.Sound(3.14159, sampling_frequency=sampling_frequency)
+
+
+def test_concurrent_analyses(sound):
+	from concurrent.futures import ThreadPoolExecutor
+
+	expected_pitch = sound.to_pitch().selected_array['frequency']
+	expected_intensity = sound.to_intensity().values
+	with ThreadPoolExecutor(max_workers=4) as executor:
+		pitches = list(executor.map(lambda _: sound.to_pitch().selected_array['frequency'], range(8)))
+		intensities = list(executor.map(lambda _: sound.to_intensity().values, range(8)))
+	assert all(np.array_equal(pitch, expected_pitch, equal_nan=True) for pitch in pitches)
+	assert all(np.array_equal(intensity, expected_intensity) for intensity in intensities)
+
+
+def test_concurrent_errors(sound):
+	from concurrent.futures import ThreadPoolExecutor
+
+	def faulty_analysis(_):
+		with pytest.raises(parselmouth.PraatError, match=r"^Your maximum number of candidates should be greater than 1\.$"):
+			sound.to_pitch_ac(max_number_of_candidates=1)
+
+	with ThreadPoolExecutor(max_workers=4) as executor:
+		list(executor.map(faulty_analysis, range(8)))
+
+
+def test_fft_table_cache():
+	from concurrent.futures import ThreadPoolExecutor
+
+	# Mixed-radix sizes whose tables do not all fit in the per-thread cache, and one size too large to be cached at all
+	sizes = [1000, 4096, 4410, 30000, 44100, 65536, 100000, 300000]
+	rng = np.random.default_rng(42)
+	sounds = [parselmouth.Sound(rng.standard_normal(n), sampling_frequency=n) for n in sizes]
+
+	def spectra(order):
+		return {i: sounds[i].to_spectrum(fast=False).values for i in order}
+
+	expected = spectra(range(len(sizes)))
+	for i, sound in enumerate(sounds):
+		reference = np.fft.rfft(sound.values[0]) / sound.sampling_frequency
+		assert np.allclose(expected[i][0] + 1j * expected[i][1], reference, rtol=0, atol=1e-12 * np.abs(reference).max())
+
+	orders = [list(range(len(sizes))), list(reversed(range(len(sizes)))), [0, 7, 1, 6, 2, 5, 3, 4] * 2]
+	assert all(np.array_equal(spectrum, expected[i]) for order in orders for i, spectrum in spectra(order).items())
+	with ThreadPoolExecutor(max_workers=4) as executor:
+		results = list(executor.map(spectra, orders * 4))
+	assert all(np.array_equal(spectrum, expected[i]) for result in results for i, spectrum in result.items())
+
+
+@pytest.mark.parametrize('n', [53, 7919, 16 * 809, 30011])
+def test_fft_large_prime_factor(n):
+	# Sizes with a large prime factor are transformed with Bluestein's algorithm, which is as accurate as a power-of-two FFT
+	rng = np.random.default_rng(n)
+	sound = parselmouth.Sound(rng.standard_normal(n), sampling_frequency=n)
+	spectrum = sound.to_spectrum(fast=False)
+	reference = np.fft.rfft(sound.values[0]) / sound.sampling_frequency
+	assert np.allclose(spectrum.values[0] + 1j * spectrum.values[1], reference, rtol=0, atol=1e-14 * np.abs(reference).max())
+	assert np.allclose(spectrum.to_sound().values, sound.values, rtol=0, atol=1e-13)
+
+
+@pytest.mark.parametrize('sampling_frequency', [8000, 44100])
+def test_to_pitch_cc_pure_tone(sampling_frequency):
+	t = np.arange(int(0.5 * sampling_frequency)) / sampling_frequency
+	sound = parselmouth.Sound(np.vstack([np.sin(2 * np.pi * 200 * t), 0.5 * np.sin(2 * np.pi * 200 * t)]), sampling_frequency)
+	for very_accurate in [False, True]:
+		pitch = sound.to_pitch_cc(very_accurate=very_accurate)
+		frequencies = pitch.selected_array['frequency']
+		strengths = pitch.selected_array['strength']
+		assert np.allclose(frequencies, 200, atol=0.1)
+		assert np.all(strengths > 0.99)
+
+
+@pytest.mark.parametrize('pitch_floor', [120, 140, 150, 160])
+def test_to_pitch_cc_direct_and_fft(sound, pitch_floor):
+	# At 8 kHz, the windows of 64 and 54 samples (120 and 140 Hz) are just above the crossover to the FFT cross-correlation,
+	# and those of 50 and 48 samples just below it; debug option 58 forces the direct one
+	sound = sound.resample(8000)
+	for very_accurate in [False, True]:
+		pitch = sound.to_pitch_cc(pitch_floor=pitch_floor, very_accurate=very_accurate)
+		parselmouth.praat.call("Debug", False, 58)
+		try:
+			expected = sound.to_pitch_cc(pitch_floor=pitch_floor, very_accurate=very_accurate)
+		finally:
+			parselmouth.praat.call("Debug", False, 0)
+		candidates, expected_candidates = pitch.to_array(), expected.to_array()
+		assert candidates.shape == expected_candidates.shape
+		assert np.allclose(candidates['strength'], expected_candidates['strength'], rtol=0, atol=1e-13, equal_nan=True)
+		# The interpolated frequency of a flat correlation peak is sensitive to rounding in the correlation
+		assert np.allclose(candidates['frequency'], expected_candidates['frequency'], rtol=1e-5, atol=0, equal_nan=True)
+
+
+@pytest.mark.parametrize('new_frequency', [16000, 22050, 12345.6, 88200])
+def test_resample_polyphase(new_frequency):
+	sampling_frequency = 44100
+	t = (np.arange(sampling_frequency) + 0.5) / sampling_frequency
+	sound = parselmouth.Sound(np.sin(2 * np.pi * 1000 * t), sampling_frequency)
+	resampled = sound.resample(new_frequency, method=parselmouth.Sound.ResampleMethod.POLYPHASE)
+	assert resampled.sampling_frequency == pytest.approx(new_frequency)
+	assert resampled.n_samples == sound.resample(new_frequency).n_samples
+	assert resampled.xs() == pytest.approx(sound.resample(new_frequency).xs())
+	inner = slice(1000, -1000)
+	assert np.allclose(resampled.values[0][inner], np.sin(2 * np.pi * 1000 * resampled.xs()[inner]), atol=1e-3)
+	assert np.all(resampled.values == sound.resample(new_frequency, method="POLYPHASE").values)
+
+
+def test_from_buffer_zero_copy():
+	values = np.random.normal(size=(2, 1000))
+	sound = parselmouth.Sound.from_buffer(values, 16000, copy=False)
+	assert sound.n_channels == 2 and sound.n_samples == 1000
+	assert sound.sampling_frequency == 16000
+	assert np.shares_memory(sound.values, values)
+	sound.scale_peak(0.5)
+	assert np.max(np.abs(values)) == pytest.approx(0.5)
+	values[0, 0] = 0.25
+	assert sound.values[0, 0] == 0.25
+	del values
+	assert np.all(np.isfinite(sound.values))
+	copy = parselmouth.Sound(sound)
+	assert not np.shares_memory(copy.values, sound.values)
+	assert copy.values[0, 0] == 0.25
+
+	with pytest.raises(ValueError, match="C-contiguous"):
+		parselmouth.Sound.from_buffer(np.zeros((2, 1000))[:, ::2], copy=False)
+	with pytest.raises(ValueError, match="C-contiguous"):
+		parselmouth.Sound.from_buffer(np.zeros(1000, dtype=np.float32), copy=False)
+	read_only = np.zeros(1000)
+	read_only.flags.writeable = False
+	with pytest.raises(ValueError, match="read-only"):
+		parselmouth.Sound.from_buffer(read_only, copy=False)
+
+
+def test_from_buffer_conversions():
+	values = np.random.normal(size=(2, 1000))
+	assert np.all(parselmouth.Sound.from_buffer(values).values == values)
+	assert np.all(parselmouth.Sound.from_buffer(values.astype(np.float32)).values == values.astype(np.float32))
+	assert np.all(parselmouth.Sound.from_buffer(values[:, ::2].astype(np.float32)).values == values[:, ::2].astype(np.float32))
+	pcm = np.array([-32768, -16384, 0, 16384, 32767], dtype=np.int16)
+	assert np.all(parselmouth.Sound.from_buffer(pcm).values == pcm / 32768)
+	assert np.all(parselmouth.Sound.from_buffer(pcm.astype(np.int32) << 16).values == pcm / 32768)
+	assert np.all(parselmouth.Sound.from_buffer(memoryview(pcm)).values == pcm / 32768)
+	with pytest.raises(TypeError, match="supported types"):
+		parselmouth.Sound.from_buffer(np.zeros(10, dtype=np.uint8))
+
+
+@pytest.mark.parametrize('file_format', ["WAV", "WAV_24", "AIFF", "FLAC", "NIST"])
+def test_from_bytes(sound, tmp_path, file_format):
+	path = str(tmp_path / "sound")
+	sound.save(path, file_format)
+	from_file = parselmouth.Sound(path)
+	with open(path, 'rb') as f:
+		data = f.read()
+	for from_memory in [parselmouth.Sound.from_bytes(data), parselmouth.Sound.from_bytes(bytearray(data)), parselmouth.Sound.from_bytes(memoryview(data))]:
+		assert from_memory.sampling_frequency == from_file.sampling_frequency
+		assert np.all(from_memory.values == from_file.values)
+	with open(path, 'rb') as f:
+		assert np.all(parselmouth.Sound.from_file_object(f).values == from_file.values)
+	assert np.all(parselmouth.Sound.from_file_object(io.BytesIO(data)).values == from_file.values)
+
+
+def test_from_bytes_errors():
+	with pytest.raises(parselmouth.PraatError, match="empty"):
+		parselmouth.Sound.from_bytes(b"")
+	with pytest.raises(parselmouth.PraatError, match="Not an audio file"):
+		parselmouth.Sound.from_bytes(b"This is not an audio file, but some text.")
+
+
+@pytest.mark.parametrize('file_format', ["WAV", "WAV_24", "FLAC"])
+def test_long_sound(sound, tmp_path, file_format):
+	path = str(tmp_path / "sound")
+	sound.save(path, file_format)
+	from_file = parselmouth.Sound(path)
+	long_sound = parselmouth.LongSound(path)
+	assert long_sound.n_channels == from_file.n_channels
+	assert long_sound.n_samples == from_file.n_samples
+	assert long_sound.sampling_frequency == from_file.sampling_frequency
+	assert long_sound.xmin == from_file.xmin and long_sound.xmax == from_file.xmax
+	assert np.all(long_sound.extract_part().values == from_file.values)
+	for from_time, to_time in [(0.1, 0.2), (0.5, 1.5), (1.0, long_sound.xmax + 1)]:
+		part = long_sound.extract_part(from_time, to_time, preserve_times=True)
+		expected = from_file.extract_part(from_time, min(to_time, from_file.xmax), preserve_times=True)
+		assert part.xs() == pytest.approx(expected.xs())
+		assert np.all(part.values == expected.values)
+	assert long_sound.extract_part(0.5, 1.5).xmin == 0
+
+
+
+def test_long_sound_flac_buffer(tmp_path):
+	sampling_frequency = 8000
+	rng = np.random.default_rng(42)
+	sound = parselmouth.Sound(rng.uniform(-0.5, 0.5, (2, 25 * sampling_frequency)), sampling_frequency=sampling_frequency)
+	path = str(tmp_path / "sound.flac")
+	sound.save(path, "FLAC")
+	from_file = parselmouth.Sound(path)
+
+	# With a buffer of 10 seconds, saving the whole LongSound reads the file in three parts, the way LongSound's buffer is filled
+	parselmouth.praat.call("LongSound settings", 10)
+	try:
+		long_sound = parselmouth.LongSound(path)
+	finally:
+		parselmouth.praat.call("LongSound settings", 600)
+	part_path = str(tmp_path / "part.wav")
+	parselmouth.praat.call(long_sound, "Save part as audio file", part_path, "WAV", 0, long_sound.xmax)
+	assert np.array_equal(parselmouth.Sound(part_path).values, from_file.values)
+
+	for from_time, to_time in [(0, 0.001), (10.2, 10.8), (12.3456, long_sound.xmax)]:
+		part = long_sound.extract_part(from_time, to_time, preserve_times=True)
+		assert np.array_equal(part.values, from_file.extract_part(from_time, to_time, preserve_times=True).values)
+
+
+@pytest.mark.parametrize('file_format', ["WAV", "FLAC"])
+def test_long_sound_analyses(sound, tmp_path, file_format):
+	path = str(tmp_path / "sound")
+	sound.save(path, file_format)
+	from_file = parselmouth.Sound(path)
+	long_sound = parselmouth.LongSound(path)
+
+	for block_duration in [0.3, 60.0]:
+		for analysis in ["to_pitch_ac", "to_pitch_cc"]:
+			pitch = getattr(long_sound, analysis)(block_duration=block_duration)
+			expected = getattr(from_file, analysis)()
+			assert pitch.xs() == pytest.approx(expected.xs())
+			assert np.array_equal(pitch.selected_array['frequency'], expected.selected_array['frequency'])
+		intensity = long_sound.to_intensity(block_duration=block_duration)
+		assert np.array_equal(intensity.values, from_file.to_intensity().values)
+		spectrogram = long_sound.to_spectrogram(block_duration=block_duration)
+		assert np.array_equal(spectrogram.values, from_file.to_spectrogram().values)
+		mfcc = long_sound.to_mfcc(block_duration=block_duration)
+		assert np.array_equal(mfcc.to_array(), from_file.to_mfcc().to_array())
+
+		# At half the sampling frequency nothing is resampled; otherwise each block is resampled on its own, and most formants stay within 0.1 percent
+		for maximum_formant in [5500.0, sound.sampling_frequency / 2]:
+			formant = long_sound.to_formant_burg(maximum_formant=maximum_formant, block_duration=block_duration)
+			expected = from_file.to_formant_burg(maximum_formant=maximum_formant)
+			times = expected.ts()
+			assert formant.nx == expected.nx
+			for formant_number in [1, 2, 3]:
+				for getter in ["get_value_at_time", "get_bandwidth_at_time"]:
+					values = getattr(formant, getter)(formant_number, times)
+					expected_values = getattr(expected, getter)(formant_number, times)
+					if maximum_formant == sound.sampling_frequency / 2:
+						assert np.array_equal(values, expected_values, equal_nan=True)
+					else:
+						assert np.array_equal(np.isnan(values), np.isnan(expected_values))
+						defined = ~np.isnan(values)
+						assert np.mean(np.isclose(values[defined], expected_values[defined], rtol=1e-3, atol=0)) > 0.9
+
+
+@pytest.mark.parametrize('n_channels', [3, 70])
+def test_long_sound_pitch_channels(tmp_path, n_channels):
+	# The means and extrema of all channels are computed in a single pass over the file, also beyond 64 channels
+	rng = np.random.default_rng(n_channels)
+	t = np.arange(4000) / 8000
+	values = 0.3 * np.sin(2 * np.pi * rng.uniform(100, 300, (n_channels, 1)) * t) + 0.01 * rng.standard_normal((n_channels, t.size)) + rng.uniform(-0.1, 0.1, (n_channels, 1))
+	path = str(tmp_path / "channels.wav")
+	parselmouth.Sound(values, sampling_frequency=8000).save(path, "WAV")
+	from_file = parselmouth.Sound(path)
+	long_sound = parselmouth.LongSound(path)
+	for block_duration in [0.05, 60.0]:
+		pitch = long_sound.to_pitch_ac(block_duration=block_duration)
+		expected = from_file.to_pitch_ac()
+		assert np.array_equal(pitch.selected_array['frequency'], expected.selected_array['frequency'])
+		assert np.array_equal(pitch.selected_array['strength'], expected.selected_array['strength'])
+
+
+def test_to_formant_robust(sound):
+	# The defaults are those of Praat's "To Formant (robust)..."
+	expected = parselmouth.praat.call(sound, "To Formant (robust)", 0.0, 5.0, 5500.0, 0.025, 50.0, 1.5, 5, 0.000001)
+	times = expected.ts()
+	for formant in [sound.to_formant_robust(), sound.to_formant_robust(number_of_std_dev=1.5, maximum_number_of_iterations=5, tolerance=1e-6, margin=50.0)]:
+		assert formant.nx == expected.nx
+		for formant_number in [1, 2, 3]:
+			assert np.array_equal(formant.get_value_at_time(formant_number, times), expected.get_value_at_time(formant_number, times), equal_nan=True)
+	assert not np.array_equal(sound.to_formant_robust(number_of_std_dev=0.5, maximum_number_of_iterations=1).get_value_at_time(1, times), expected.get_value_at_time(1, times), equal_nan=True)
+
+
+@pytest.mark.parametrize('analysis', ["to_formant_burg", "to_formant_robust"])
+def test_formant_n_threads(sound, analysis):
+	expected = getattr(sound, analysis)(n_threads=1)
+	times = expected.ts()
+	for n_threads in [None, 2, 5]:
+		formant = getattr(sound, analysis)(n_threads=n_threads)
+		assert formant.nx == expected.nx
+		for formant_number in [1, 2, 3]:
+			assert np.array_equal(formant.get_value_at_time(formant_number, times), expected.get_value_at_time(formant_number, times), equal_nan=True)
+			assert np.array_equal(formant.get_bandwidth_at_time(formant_number, times), expected.get_bandwidth_at_time(formant_number, times), equal_nan=True)
+
+
+@pytest.mark.parametrize('method', ["autocorrelation", "covariance", "burg", "marple"])
+def test_to_lpc(sound, method):
+	lpc = getattr(sound, "to_lpc_" + method)(prediction_order=10)
+	assert isinstance(lpc, parselmouth.LPC)
+	assert lpc.max_n_coefficients == 10
+	assert lpc.sampling_period == sound.dx
+	assert np.array_equal(getattr(sound, "to_lpc_" + method)(prediction_order=10, n_threads=1).to_array(), lpc.to_array())
+	assert lpc.to_array().shape == (10, lpc.nx)
+	assert lpc.get_gains().shape == (lpc.nx,)
+
+	frame = lpc[lpc.nx // 2]
+	assert len(frame) == frame.a.shape[0]
+	assert np.array_equal(frame.a, lpc.to_array()[:len(frame), lpc.nx // 2])
+	frame.a[0] = 42
+	assert lpc.get_frame(lpc.nx // 2 + 1)[0] == 42
+
+	assert isinstance(lpc.to_formant(), parselmouth.Formant)
+
+
+def test_pitch_tracker(sound):
+	sound = sound.extract_channel(1)
+	peak = np.max(np.abs(sound.values))
+
+	def track(sound, chunk_size, lookahead, peak):
+		tracker = parselmouth.PitchTracker(sound.sampling_frequency, lookahead=lookahead, peak=peak)
+		pitches = [tracker.process(sound.values[:, i:i + chunk_size]) for i in range(0, sound.n_samples, chunk_size)]
+		pitches.append(tracker.flush())
+		pitches = [pitch for pitch in pitches if pitch is not None]
+		return np.concatenate([pitch.xs() for pitch in pitches]), np.concatenate([pitch.selected_array['frequency'] for pitch in pitches])
+
+	times, frequencies = track(sound, sound.n_samples, 0.1, peak)
+	assert np.allclose(np.diff(times), 0.01)
+	for chunk_size in [1, 441, 10000]:
+		chunked_times, chunked_frequencies = track(sound, chunk_size, 0.1, peak)
+		assert np.allclose(chunked_times, times)
+		assert np.array_equal(chunked_frequencies, frequencies)
+
+	# A part of one window plus a whole number of time steps has the same frames as the tracker, which starts half a window into the stream
+	n_frames = 70
+	part = parselmouth.Sound(sound.values[:, 20000:20000 + round(0.04 * sound.sampling_frequency) + (n_frames - 1) * round(0.01 * sound.sampling_frequency)], sound.sampling_frequency)
+	part_peak = np.max(np.abs(part.values))
+	expected = part.to_pitch_ac()
+	assert expected.nx == n_frames
+
+	# With a lookahead covering the whole sound, the path is the same as the one of the whole Pitch
+	part_times, part_frequencies = track(part, part.n_samples, part.duration, part_peak)
+	assert np.allclose(part_times, expected.xs())
+	assert np.array_equal(part_frequencies, expected.selected_array['frequency'])
+
+	# Without lookahead, every frame gets the candidate at the end of the best path through the frames up to and including it
+	ceiling, time_step_correction = 600.0, 0.01 / expected.dx
+	previous, online_frequencies = None, []
+	for frame in expected:
+		frame_frequencies = np.array([candidate.frequency for candidate in frame.candidates])
+		strengths = np.array([candidate.strength for candidate in frame.candidates])
+		voiced = (frame_frequencies > 0) & (frame_frequencies < ceiling)
+		voiced_frequencies = np.where(voiced, frame_frequencies, 1.0)
+		unvoiced_strength = 0.45 + max(0.0, 2.0 - frame.intensity / (0.03 / (1.0 + 0.45)))
+		delta = np.where(voiced, strengths - 0.01 * np.log2(ceiling / voiced_frequencies), unvoiced_strength)
+		if previous is not None:
+			previous_voiced, previous_frequencies, previous_delta = previous
+			transition_costs = np.where(voiced[None, :] != previous_voiced[:, None], 0.14 * time_step_correction,
+			                            np.where(voiced[None, :], 0.35 * time_step_correction * np.abs(np.log2(previous_frequencies[:, None] / voiced_frequencies[None, :])), 0.0))
+			delta += np.max(previous_delta[:, None] - transition_costs, axis=0)
+		previous = voiced, voiced_frequencies, delta
+		online_frequencies.append(frame_frequencies[np.argmax(delta)] if voiced[np.argmax(delta)] else 0.0)
+	part_times, part_frequencies = track(part, 441, 0.0, part_peak)
+	assert np.allclose(part_times, expected.xs())
+	assert np.array_equal(part_frequencies, online_frequencies)
+
+
+def test_to_harmonicity_gne(sound, num_threads):
+	gne = sound.to_harmonicity_gne()
+	n_bands = len(np.arange(500.0, 4500.0 + 1e-9, 80.0))
+	assert gne.values.shape == (n_bands, n_bands)
+	rows, cols = np.indices(gne.values.shape)
+	# Only the correlations between bands that are far enough apart are kept
+	far = (rows - cols >= 7)
+	assert np.all(gne.values[~far] == 0)
+	assert np.all((gne.values[far] > 0) & (gne.values[far] <= 1 + 1e-12))
+	# Reference values computed with Praat's original, sequential Sound_to_Harmonicity_GNE
+	assert gne.values[9, 2] == pytest.approx(0.8248139753456326, rel=1e-12)
+	assert gne.values[10, 0] == pytest.approx(0.7856611476165657, rel=1e-12)
+	assert gne.values[30, 5] == pytest.approx(0.8007434280174677, rel=1e-12)
+	assert gne.values[50, 0] == pytest.approx(0.6213943353934805, rel=1e-12)
+	other_bands = sound.to_harmonicity_gne(300, 3000, 500, 120)
+	assert other_bands.values.shape == (23, 23)
+	assert other_bands.values[9, 5] == pytest.approx(0.8422814178854127, rel=1e-12)
+	assert other_bands.values[22, 0] == pytest.approx(0.7690265265263118, rel=1e-12)
+	parselmouth.set_num_threads(num_threads)
+	assert np.array_equal(sound.to_harmonicity_gne().values, gne.values)
+
+
+@pytest.mark.parametrize('n_samples, n_kernel', [(200000, 1000), (1000, 200000), (3000, 200)])
+@pytest.mark.parametrize('signal_outside_time_domain', ["ZERO", "SIMILAR"])
+def test_convolve_cross_correlate(n_samples, n_kernel, signal_outside_time_domain, num_threads):
+	# Long signals with short kernels are filtered in blocks, by overlap-save; the result should be the same
+	rng = np.random.default_rng(42)
+	sound = parselmouth.Sound(rng.standard_normal(n_samples), 16000)
+	kernel = parselmouth.Sound(rng.standard_normal(n_kernel), 16000)
+	expected_convolution = np.convolve(sound.values[0], kernel.values[0])
+	expected_correlation = np.correlate(kernel.values[0], sound.values[0], 'full')
+	if signal_outside_time_domain == "SIMILAR":
+		edge = min(n_samples, n_kernel)
+		factors = np.ones(n_samples + n_kernel - 1)
+		factors[:edge - 1] = edge / np.arange(1, edge)
+		factors[:-edge:-1] = edge / np.arange(1, edge)
+		expected_convolution *= factors
+		expected_correlation *= factors
+	parselmouth.set_num_threads(num_threads)
+	convolution = sound.convolve(kernel, "SUM", signal_outside_time_domain)
+	assert convolution.n_samples == n_samples + n_kernel - 1
+	assert convolution.xmin == sound.xmin + kernel.xmin and convolution.x1 == sound.x1 + kernel.x1
+	assert np.allclose(convolution.values[0], expected_convolution, rtol=0, atol=1e-12 * np.abs(expected_convolution).max())
+	correlation = sound.cross_correlate(kernel, "SUM", signal_outside_time_domain)
+	assert correlation.n_samples == n_samples + n_kernel - 1
+	assert correlation.xmin == kernel.xmin - sound.xmax
+	assert np.allclose(correlation.values[0], expected_correlation, rtol=0, atol=1e-12 * np.abs(expected_correlation).max())
+	integral = sound.cross_correlate(kernel, "INTEGRAL", signal_outside_time_domain)
+	assert np.allclose(integral.values[0], correlation.values[0] * sound.dx, rtol=1e-12, atol=0)
+
+
+@pytest.mark.parametrize('arguments', [(12, 0.015, 0.005, 100.0, 100.0, None), (20, 0.025, 0.01, 50.0, 80.0, 4000.0)])
+def test_to_mfcc(sound, arguments, num_threads):
+	# The MFCC are computed in the same pass as the mel filter bank, without storing the MelSpectrogram in between
+	n_coefficients, window_length, time_step, first_filter_frequency, distance_between_filters, maximum_frequency = arguments
+	mfcc = sound.to_mfcc(*arguments)
+	mel_spectrogram = parselmouth.praat.call(sound, "To MelSpectrogram", window_length, time_step, first_filter_frequency, distance_between_filters, maximum_frequency or 0.0)
+	expected = parselmouth.praat.call(mel_spectrogram, "To MFCC", n_coefficients)
+	assert mfcc.n_frames == expected.n_frames and mfcc.x1 == expected.x1
+	assert np.array_equal(mfcc.to_array(), expected.to_array())
+	parselmouth.set_num_threads(num_threads)
+	assert np.array_equal(sound.to_mfcc(*arguments).to_array(), mfcc.to_array())
+
+
+@pytest.mark.parametrize('subtract_mean', [True, False])
+def test_to_intensity(subtract_mean, num_threads):
+	# The frames are analysed in parallel; the energy of all channels is added, with the window sums truncated at the edges
+	rng = np.random.default_rng(7)
+	sound = parselmouth.Sound(rng.standard_normal((2, 24000)) * 0.1 + 0.01, 16000)
+	intensity = sound.to_intensity(100.0, 0.00413, subtract_mean)
+	half_window_samples = int(np.floor(0.5 * 6.4 / 100.0 / sound.dx))
+	x = np.arange(-half_window_samples, half_window_samples + 1) * sound.dx / (0.5 * 6.4 / 100.0)
+	window = np.i0((2 * np.pi ** 2 + 0.5) * np.sqrt(np.clip(1 - x ** 2, 0, None)))
+	for iframe, time in enumerate(intensity.xs()):
+		centre = int(np.floor((time - sound.x1) / sound.dx + 0.5))
+		left, right = max(centre - half_window_samples, 0), min(centre + half_window_samples, sound.n_samples - 1)
+		amplitudes = sound.values[:, left:right + 1]
+		if subtract_mean:
+			amplitudes = amplitudes - amplitudes.mean(axis=1, keepdims=True)
+		weights = window[left - centre + half_window_samples:right - centre + half_window_samples + 1]
+		expected = np.sum(amplitudes ** 2 * weights) / (2 * np.sum(weights))
+		assert intensity.values[0, iframe] == pytest.approx(10 * np.log10(expected / 4e-10), abs=1e-6)  # NUMbessel_i0_f approximates I0
+	parselmouth.set_num_threads(num_threads)
+	assert np.array_equal(sound.to_intensity(100.0, 0.00413, subtract_mean).values, intensity.values)